@@ -0,0 +1,1178 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+//Internal
+#include "Global.h"
+#include "Model_AudioFile.h"
+#include "Thread_FileAnalyzer.h"
+#include "Thread_FileAnalyzer_Probe.h"
+#include "Filter_Resample.h"
+#include "Tool_WaveProperties.h"
+#include "Tool_WaveSlicer.h"
+#include "Tool_Abstract.h"
+#include "Tool_ProgressMatcher.h"
+#include "Model_Progress.h"
+#include "Model_FileList.h"
+#include "Thread_RAMObserver.h"
+#include "Model_CueSheet.h"
+#include "ToolCache.h"
+#include "LockedFile.h"
+#include "FileHash.h"
+
+//MUtils
+#include <MUtils/Global.h>
+
+//Qt
+#include <QObject>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QProcess>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QVector>
+#include <QRegExp>
+#include <QUuid>
+#include <QTextStream>
+#include <QTextCodec>
+#include <qmath.h>
+
+//CRT
+#include <algorithm>
+#include <stdexcept>
+
+//Windows includes
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include <WinIoCtl.h>
+
+//Benchmark function
+typedef bool (*benchmark_func_t)(void);
+
+//Benchmark table entry
+typedef struct
+{
+	const char *const name;
+	const benchmark_func_t func;
+}
+benchmark_t;
+
+//Number of copies per file type in the probe corpus
+static const int PROBE_COPIES = 64;
+
+//Spawn scheduler configuration, number of threads and number of processes per thread
+static const quint32 SPAWN_RATE    = 32U;
+static const quint32 SPAWN_BURST   = 8U;
+static const int     SPAWN_THREADS = 8;
+static const int     SPAWN_COUNT   = 32;
+
+//Number of output lines per tool in the progress matcher benchmark
+static const int MATCHER_LINES = 100000;
+
+//Duration of the sparse Wave file, 16-Bit stereo at 44.1 KHz, i.e. slightly above 4 GB
+static const quint32 LARGE_SECONDS = 24400U;
+
+//Number of jobs in the progress model benchmark and time budget for inserting and for updating them (in msec)
+static const int    PROGRESS_JOBS   = 100000;
+static const qint64 PROGRESS_BUDGET = 2000;
+
+//List sizes in the file removal benchmark
+static const int REMOVE_SIZES[] = { 1000, 10000, 100000, 0 };
+
+//Number of files in the memory usage benchmark
+static const int MEMORY_FILES = 100000;
+
+//Approximate sizes of the Cue Sheets in the parser benchmark, all of them below the 10 MB limit of the parser
+static const int CUESHEET_SIZES[] = { 65536, 1048576, 8388608, 0 };
+
+///////////////////////////////////////////////////////////////////////////////
+// Helper functions
+///////////////////////////////////////////////////////////////////////////////
+
+static QString createTempFolder(void)
+{
+	const QString folderPath = QString("%1/benchmark_%2").arg(MUtils::temp_folder(), MUtils::next_rand_str());
+	return QDir().mkpath(folderPath) ? folderPath : QString();
+}
+
+static void removeTempFolder(const QString &folderPath)
+{
+	if(!folderPath.isEmpty())
+	{
+		const QDir folder(folderPath);
+		foreach(const QString &fileName, folder.entryList(QDir::Files | QDir::Hidden | QDir::System))
+		{
+			MUtils::remove_file(folder.absoluteFilePath(fileName));
+		}
+		QDir().rmdir(folderPath);
+	}
+}
+
+static double filesPerSecond(const int count, const qint64 nsecs)
+{
+	return (nsecs > 0) ? (double(count) * 1000000000.0 / double(nsecs)) : 0.0;
+}
+
+/*
+ * Prints the p50/p95/p99 percentiles of the given samples (in microseconds) as milliseconds
+ */
+static void printPercentiles(const char *const label, QVector<qint64> samples)
+{
+	if(samples.isEmpty())
+	{
+		qDebug("%s: no samples", label);
+		return;
+	}
+
+	std::sort(samples.begin(), samples.end());
+	const int last = samples.count() - 1;
+	qDebug("%s: p50 = %.2f ms, p95 = %.2f ms, p99 = %.2f ms, max = %.2f ms (%d samples)", label,
+		double(samples[(last * 50) / 100]) / 1000.0, double(samples[(last * 95) / 100]) / 1000.0, double(samples[(last * 99) / 100]) / 1000.0, double(samples[last]) / 1000.0, samples.count());
+}
+
+static bool writeWaveFile(const QString &filePath, const quint32 sampleRate, const quint16 channels, const quint32 frames)
+{
+	QFile file(filePath);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		qWarning("Failed to create file: %s", MUTILS_UTF8(filePath));
+		return false;
+	}
+
+	const quint32 dataSize = frames * channels * 2U;
+
+	QDataStream stream(&file);
+	stream.setByteOrder(QDataStream::LittleEndian);
+
+	stream.writeRawData("RIFF", 4); stream << quint32(36U + dataSize);
+	stream.writeRawData("WAVE", 4);
+	stream.writeRawData("fmt ", 4); stream << quint32(16U);
+	stream << quint16(1U) << channels << sampleRate << quint32(sampleRate * channels * 2U) << quint16(channels * 2U) << quint16(16U);
+	stream.writeRawData("data", 4); stream << dataSize;
+
+	for(quint32 i = 0; i < frames; i++)
+	{
+		const qint16 sample = qint16(qSin(double(i) * 2.0 * M_PI * 440.0 / double(sampleRate)) * 8192.0);
+		for(quint16 c = 0; c < channels; c++)
+		{
+			stream << sample;
+		}
+	}
+
+	file.close();
+	return (stream.status() == QDataStream::Ok);
+}
+
+/*
+ * Creates a sparse RIFF/WAVE file filled with silence, sizes above 4 GB are written with an overflowed header
+ */
+static bool writeSparseWaveFile(const QString &filePath, const quint32 sampleRate, const quint16 channels, const quint64 frames)
+{
+	const HANDLE hFile = CreateFileW(MUTILS_WCHR(QDir::toNativeSeparators(filePath)), GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(hFile == INVALID_HANDLE_VALUE)
+	{
+		qWarning("Failed to create file: %s", MUTILS_UTF8(filePath));
+		return false;
+	}
+
+	const quint64 dataSize = frames * channels * 2U;
+	QByteArray header;
+	QDataStream stream(&header, QIODevice::WriteOnly);
+	stream.setByteOrder(QDataStream::LittleEndian);
+
+	stream.writeRawData("RIFF", 4); stream << quint32(36U + dataSize);
+	stream.writeRawData("WAVE", 4);
+	stream.writeRawData("fmt ", 4); stream << quint32(16U);
+	stream << quint16(1U) << channels << sampleRate << quint32(sampleRate * channels * 2U) << quint16(channels * 2U) << quint16(16U);
+	stream.writeRawData("data", 4); stream << quint32(dataSize);
+
+	DWORD bytesReturned = 0, bytesWritten = 0;
+	LARGE_INTEGER fileSize;
+	fileSize.QuadPart = static_cast<LONGLONG>(header.size() + dataSize);
+
+	bool success = DeviceIoControl(hFile, FSCTL_SET_SPARSE, NULL, 0, NULL, 0, &bytesReturned, NULL);
+	success = success && WriteFile(hFile, header.constData(), static_cast<DWORD>(header.size()), &bytesWritten, NULL) && (bytesWritten == static_cast<DWORD>(header.size()));
+	success = success && SetFilePointerEx(hFile, fileSize, NULL, FILE_BEGIN) && SetEndOfFile(hFile);
+
+	CloseHandle(hFile);
+	if(!success)
+	{
+		qWarning("Failed to create sparse file: %s", MUTILS_UTF8(filePath));
+	}
+	return success;
+}
+
+static bool runTool(const QString &toolName, const QStringList &args)
+{
+	const QString toolPath = lamexp_tools_lookup(toolName);
+	if(toolPath.isEmpty())
+	{
+		qWarning("Tool \"%s\" is not available!", MUTILS_UTF8(toolName));
+		return false;
+	}
+
+	QProcess process;
+	process.setProcessChannelMode(QProcess::MergedChannels);
+	process.start(toolPath, args);
+
+	if(!(process.waitForStarted() && process.waitForFinished(-1)))
+	{
+		qWarning("Tool \"%s\" could not be executed!", MUTILS_UTF8(toolName));
+		return false;
+	}
+
+	if((process.exitStatus() != QProcess::NormalExit) || (process.exitCode() != EXIT_SUCCESS))
+	{
+		qWarning("Tool \"%s\" has failed with exit code %d!", MUTILS_UTF8(toolName), process.exitCode());
+		return false;
+	}
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Header Probe
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Analyzes a corpus of Wave, FLAC, MPEG Audio and Ogg Vorbis files, once via
+ * the header probe alone and then via the FileAnalyzer with and without the
+ * header probe enabled (i.e. falling back to MediaInfo for all files).
+ */
+static bool benchmark_probe(void)
+{
+	static const char *const SUFFIX[] = { "wav", "flac", "mp3", "ogg", NULL };
+
+	const QString folderPath = createTempFolder();
+	if(folderPath.isEmpty())
+	{
+		qWarning("Failed to create the temporary folder!");
+		return false;
+	}
+
+	const QString sourcePath = QString("%1/source.%2").arg(folderPath);
+	const QString sourceWave = QDir::toNativeSeparators(sourcePath.arg(SUFFIX[0]));
+
+	//Generate the source files
+	bool okay = writeWaveFile(sourcePath.arg(SUFFIX[0]), 44100U, 2U, 441000U);
+	okay = okay && runTool("flac.exe",    QStringList() << "--silent" << "-5" << "-f" << "-o" << QDir::toNativeSeparators(sourcePath.arg(SUFFIX[1])) << sourceWave);
+	okay = okay && runTool("lame.exe",    QStringList() << "--quiet" << "-V" << "2" << sourceWave << QDir::toNativeSeparators(sourcePath.arg(SUFFIX[2])));
+	okay = okay && runTool("oggenc2.exe", QStringList() << "--quiet" << "-q" << "5" << "-o" << QDir::toNativeSeparators(sourcePath.arg(SUFFIX[3])) << sourceWave);
+
+	//Create the corpus
+	QStringList corpus;
+	for(size_t k = 0; okay && SUFFIX[k]; k++)
+	{
+		for(int i = 0; i < PROBE_COPIES; i++)
+		{
+			const QString copyPath = QString("%1/file_%2.%3").arg(folderPath, QString::number(i), QString::fromLatin1(SUFFIX[k]));
+			if(!QFile::copy(sourcePath.arg(SUFFIX[k]), copyPath))
+			{
+				qWarning("Failed to create file: %s", MUTILS_UTF8(copyPath));
+				okay = false;
+				break;
+			}
+			corpus << copyPath;
+		}
+	}
+
+	if(okay)
+	{
+		qDebug("Corpus: %d files (Wave, FLAC, MPEG Audio, Ogg Vorbis)", corpus.count());
+		QElapsedTimer timer;
+
+		//Header probe only
+		int probed = 0;
+		timer.start();
+		foreach(const QString &filePath, corpus)
+		{
+			AudioFileModel audioFile(filePath);
+			if(HeaderProbe::probe(filePath, audioFile))
+			{
+				probed++;
+			}
+		}
+		const qint64 probeTime = timer.nsecsElapsed();
+		qDebug("Header probe         : %4d of %4d files, %10.1f files/sec", probed, corpus.count(), filesPerSecond(corpus.count(), probeTime));
+		if(probed != corpus.count())
+		{
+			qWarning("The header probe has rejected %d files!", corpus.count() - probed);
+			okay = false;
+		}
+
+		//Complete analysis, with and without the header probe
+		qint64 analyzerTime[2] = { 0, 0 };
+		for(int pass = 0; pass < 2; pass++)
+		{
+			const bool useProbe = (pass == 0);
+			FileAnalyzer analyzer(corpus, false, useProbe);
+			timer.start();
+			analyzer.start();
+			analyzer.wait();
+			analyzerTime[pass] = timer.nsecsElapsed();
+			qDebug("Analyzer (%s) : %4u of %4d files, %10.1f files/sec", useProbe ? "probe    " : "MediaInfo", analyzer.filesAccepted(), corpus.count(), filesPerSecond(corpus.count(), analyzerTime[pass]));
+			if((!analyzer.getSuccess()) || (analyzer.filesAccepted() != static_cast<unsigned int>(corpus.count())))
+			{
+				qWarning("The analyzer has rejected %d files!", corpus.count() - static_cast<int>(analyzer.filesAccepted()));
+				okay = false;
+			}
+		}
+
+		if(analyzerTime[0] > 0)
+		{
+			qDebug("Speed-up of the header probe: %.2fx", double(analyzerTime[1]) / double(analyzerTime[0]));
+		}
+	}
+
+	removeTempFolder(folderPath);
+	return okay;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Progress Matcher
+///////////////////////////////////////////////////////////////////////////////
+
+//Typical tool output, the previous regular expression and the matcher that replaced it
+typedef struct
+{
+	const char *const name;
+	const char *const format; /*takes the progress as integer*/
+	const char *const regExp;
+	const char *const prefix;
+	const char *const suffix;
+}
+matcher_case_t;
+
+static const matcher_case_t g_matcherCases[] =
+{
+	{ "LAME",   "  10336/41343   (%2d%%)|    0:07/    0:28|    0:07/    0:28|   145.25x|    0:21 \r", "\\(.*(\\d+)%\\)\\|",       "(",   ")|"        },
+	{ "FLAC",   "track01.wav: %d%% complete, ratio=0.574\r",                                         "\\b(\\d+)% complete",          "",    " complete" },
+	{ "SoX",    "In:%d.00%% 00:00:07.12 [00:00:21.36] Out:314k  [ -====|====- ] Hd:0.8 Clip:0 \r",   "In:(\\d+)(\\.\\d+)*%",          "In:", ""          },
+	{ "FAAD",   "[%d%%] decoding track01.m4a.\r",                                                     "\\[(\\d+)%\\]\\s*decoding", "[",   "] decoding"},
+	{ NULL, NULL, NULL, NULL, NULL }
+};
+
+/*
+ * Compares the ProgressMatcher on the raw output with the previous per-line path, which converted every line
+ * to a simplified QString and applied a regular expression. The matcher must find every progress value.
+ */
+static bool benchmark_matcher(void)
+{
+	bool okay = true;
+
+	for(size_t k = 0; g_matcherCases[k].name; k++)
+	{
+		const matcher_case_t &current = g_matcherCases[k];
+
+		//Generate the tool output
+		QList<QByteArray> lines;
+		qint64 expected = 0;
+		for(int i = 0; i < MATCHER_LINES; i++)
+		{
+			const int progress = (i * 100) / MATCHER_LINES;
+			lines << QString().sprintf(current.format, progress).toLatin1();
+			expected += progress;
+		}
+
+		QElapsedTimer timer;
+		qint64 sum[2] = { 0, 0 }, elapsed[2] = { 0, 0 };
+
+		//Previous path
+		QRegExp regExp(QString::fromLatin1(current.regExp), Qt::CaseInsensitive);
+		timer.start();
+		for(QList<QByteArray>::ConstIterator iter = lines.constBegin(); iter != lines.constEnd(); iter++)
+		{
+			QByteArray line(*iter);
+			line.replace('\r', char(0x20)).replace('\b', char(0x20)).replace('\t', char(0x20));
+			const QString text = QString::fromUtf8(line.constData()).simplified();
+			qint32 progress;
+			if((regExp.lastIndexIn(text) >= 0) && MUtils::regexp_parse_int32(regExp, progress))
+			{
+				sum[0] += progress;
+			}
+		}
+		elapsed[0] = timer.nsecsElapsed();
+
+		//Progress matcher
+		const ProgressMatcher matcher(current.prefix, current.suffix);
+		timer.start();
+		for(QList<QByteArray>::ConstIterator iter = lines.constBegin(); iter != lines.constEnd(); iter++)
+		{
+			qint32 progress;
+			if(matcher.match(iter->constData(), static_cast<size_t>(iter->size()), progress))
+			{
+				sum[1] += progress;
+			}
+		}
+		elapsed[1] = timer.nsecsElapsed();
+
+		qDebug("%-5s: QRegExp %7.1f ns/line, matcher %7.1f ns/line, speed-up %.1fx", current.name,
+			double(elapsed[0]) / double(MATCHER_LINES), double(elapsed[1]) / double(MATCHER_LINES), (elapsed[1] > 0) ? (double(elapsed[0]) / double(elapsed[1])) : 0.0);
+
+		if(sum[1] != expected)
+		{
+			qWarning("The matcher missed progress values in the %s output!", current.name);
+			okay = false;
+		}
+		if(sum[0] != expected)
+		{
+			qDebug("%-5s: The previous regular expression did not find the exact progress values.", current.name);
+		}
+	}
+
+	return okay;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Spawn Scheduler
+///////////////////////////////////////////////////////////////////////////////
+
+class SpawnTool : public AbstractTool
+{
+public:
+	bool spawn(const QString &program, qint64 &latency)
+	{
+		QProcess process;
+		QElapsedTimer timer;
+		timer.start();
+		const bool started = startProcess(process, program, QStringList() << "--version");
+		latency = timer.nsecsElapsed() / 1000i64;
+
+		QAtomicInt abortFlag;
+		return started && (awaitProcess(process, abortFlag) == RESULT_SUCCESS);
+	}
+};
+
+class SpawnTask : public QRunnable
+{
+public:
+	SpawnTask(const QString &program, QVector<qint64> &latencies, QMutex &mutex, QAtomicInt &failures)
+	:
+		m_program(program), m_latencies(latencies), m_mutex(mutex), m_failures(failures)
+	{
+	}
+
+	void run(void)
+	{
+		SpawnTool tool;
+		for(int i = 0; i < SPAWN_COUNT; i++)
+		{
+			qint64 latency = 0;
+			if(!tool.spawn(m_program, latency))
+			{
+				m_failures.ref();
+			}
+			QMutexLocker lock(&m_mutex);
+			m_latencies.append(latency);
+		}
+	}
+
+private:
+	const QString m_program;
+	QVector<qint64> &m_latencies;
+	QMutex &m_mutex;
+	QAtomicInt &m_failures;
+};
+
+/*
+ * Starts processes from several threads through the spawn scheduler and reports the distribution of the
+ * start latency as well as the effective spawn rate, which must not fall below the configured rate.
+ */
+static bool benchmark_spawn(void)
+{
+	const QString program = lamexp_tools_lookup("sox.exe");
+	if(program.isEmpty())
+	{
+		qWarning("Tool \"sox.exe\" is not available!");
+		return false;
+	}
+
+	AbstractTool::setSpawnRate(SPAWN_RATE, SPAWN_BURST);
+	AbstractTool::resetSpawnStatistics();
+
+	QVector<qint64> latencies;
+	QMutex mutex;
+	QAtomicInt failures;
+
+	QThreadPool pool;
+	pool.setMaxThreadCount(SPAWN_THREADS);
+
+	QElapsedTimer timer;
+	timer.start();
+	for(int i = 0; i < SPAWN_THREADS; i++)
+	{
+		pool.start(new SpawnTask(program, latencies, mutex, failures));
+	}
+	pool.waitForDone();
+	const qint64 elapsed = timer.nsecsElapsed();
+
+	//The first processes are started immediately (burst), all others are limited by the rate
+	const int total = SPAWN_THREADS * SPAWN_COUNT;
+	const double effectiveRate = filesPerSecond(total - static_cast<int>(SPAWN_BURST), elapsed);
+	qDebug("Processes      : %d, %d failed", total, static_cast<int>(failures));
+	qDebug("Spawn rate     : %.2f/sec effective, %u/sec configured", effectiveRate, SPAWN_RATE);
+	printPercentiles("Start latency  ", latencies);
+
+	double p50, p95, p99;
+	AbstractTool::spawnPercentiles(p50, p95, p99);
+	qDebug("Token wait     : p50 = %.2f ms, p95 = %.2f ms, p99 = %.2f ms", p50, p95, p99);
+
+	if(effectiveRate < (0.95 * double(SPAWN_RATE)))
+	{
+		qWarning("The effective spawn rate is below the configured rate!");
+	}
+
+	return (static_cast<int>(failures) == 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Large Files
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Round trip of a sparse RIFF file above 4 GB (with overflowed header) through the header parser,
+ * a SoX filter that writes Wave64, the header parser again and the WaveSlicer, which writes RIFF.
+ */
+static bool benchmark_wave64(void)
+{
+	const QString folderPath = createTempFolder();
+	if(folderPath.isEmpty())
+	{
+		qWarning("Failed to create the temporary folder!");
+		return false;
+	}
+
+	const quint64 frames = static_cast<quint64>(LARGE_SECONDS) * 44100U;
+	const QString sourceFile = QString("%1/large.wav").arg(folderPath), filterFile = QString("%1/large.w64").arg(folderPath), sliceFile = QString("%1/slice.wav").arg(folderPath);
+
+	QElapsedTimer timer;
+	QAtomicInt abortFlag;
+	WaveProperties::layout_t layout;
+
+	//Sparse RIFF file
+	bool okay = writeSparseWaveFile(sourceFile, 44100U, 2U, frames);
+	AudioFileModel_TechInfo sourceInfo;
+	if(okay && WaveProperties::parseHeader(sourceFile, &sourceInfo, NULL, &layout))
+	{
+		qDebug("RIFF header  : %s frames, exceeds RIFF limit: %s", MUTILS_UTF8(QString::number(layout.dataSize / layout.blockAlign)), MUTILS_BOOL2STR(WaveProperties::exceedsRiffLimit(layout.dataSize)));
+		okay = ((layout.dataSize / layout.blockAlign) == frames);
+	}
+	else
+	{
+		okay = false;
+	}
+
+	//SoX filter, writing Wave64
+	if(okay)
+	{
+		ResampleFilter filter(0, 16);
+		filter.setIgnoreInputLength(true);
+		timer.start();
+		okay = (filter.apply(sourceFile, filterFile, &sourceInfo, abortFlag) == AbstractFilter::FILTER_SUCCESS);
+		qDebug("SoX filter   : %s, %.1f sec", okay ? "OK" : "failed", double(timer.elapsed()) / 1000.0);
+	}
+
+	//Wave64 header
+	if(okay)
+	{
+		okay = WaveProperties::parseHeader(filterFile, NULL, NULL, &layout) && ((layout.dataSize / layout.blockAlign) == frames);
+		qDebug("W64 header   : %s frames", MUTILS_UTF8(QString::number(layout.dataSize / layout.blockAlign)));
+	}
+
+	//Slice the last second as RIFF
+	if(okay)
+	{
+		WaveSlicer slicer(filterFile);
+		timer.start();
+		okay = slicer.setRange(static_cast<qint64>(LARGE_SECONDS - 1U) * WaveSlicer::FRAMES_PER_SECOND, WaveSlicer::FRAMES_PER_SECOND) && slicer.extract(sliceFile, abortFlag, [](const int) {});
+		okay = okay && WaveProperties::parseHeader(sliceFile, NULL, NULL, &layout) && ((layout.dataSize / layout.blockAlign) == 44100U);
+		qDebug("Wave slicer  : %s, %.1f sec", okay ? "OK" : "failed", double(timer.elapsed()) / 1000.0);
+	}
+
+	removeTempFolder(folderPath);
+	return okay;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Progress Model
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Inserts and then completes 100k jobs. The model only shows the newest jobs, so the visible rows must be the
+ * last ones that were inserted, and the per-state counts must match the visible rows after every update. Both
+ * passes must finish within the time budget, which a linear lookup per job would exceed by far.
+ */
+static bool benchmark_progress(void)
+{
+	const QString tempFolder = createTempFolder();
+	if(tempFolder.isEmpty())
+	{
+		qWarning("Failed to create temporary folder!");
+		return false;
+	}
+
+	bool okay = true;
+	QVector<QUuid> jobIds(PROGRESS_JOBS);
+	for(int i = 0; i < PROGRESS_JOBS; i++)
+	{
+		jobIds[i] = QUuid::createUuid();
+	}
+
+	{
+		ProgressModel model(tempFolder);
+		QElapsedTimer timer;
+		qint64 elapsed[2] = { 0, 0 };
+
+		//Insert the jobs
+		timer.start();
+		for(int i = 0; i < PROGRESS_JOBS; i++)
+		{
+			model.addJob(jobIds[i], QString("Job #%1").arg(i), QString("Running"), ProgressModel::JobRunning);
+		}
+		elapsed[0] = timer.nsecsElapsed();
+
+		const int rows = model.rowCount();
+		if((rows < 1) || (rows > PROGRESS_JOBS) || (model.getJobCount(ProgressModel::JobRunning) != rows))
+		{
+			qWarning("Inserted %d jobs, but the model has %d rows with %d running jobs!", PROGRESS_JOBS, rows, model.getJobCount(ProgressModel::JobRunning));
+			okay = false;
+		}
+		for(int row = 0; okay && (row < rows); row++)
+		{
+			if(model.data(model.index(row, 0)).toString() != QString("Job #%1").arg(PROGRESS_JOBS - rows + row))
+			{
+				qWarning("Row %d does not show the expected job!", row);
+				okay = false;
+			}
+		}
+
+		//Update the jobs, starting with the oldest one
+		timer.start();
+		for(int i = 0; i < PROGRESS_JOBS; i++)
+		{
+			model.updateJob(jobIds[i], QString("Done #%1").arg(i), ProgressModel::JobComplete);
+		}
+		elapsed[1] = timer.nsecsElapsed();
+
+		int updated = 0;
+		for(int row = 0; row < rows; row++)
+		{
+			if(model.data(model.index(row, 1)).toString() == QString("Done #%1").arg(PROGRESS_JOBS - rows + row))
+			{
+				updated++;
+			}
+		}
+		if((model.rowCount() != rows) || (updated != rows) || (model.getJobCount(ProgressModel::JobComplete) != rows) || (model.getJobCount(ProgressModel::JobRunning) != 0))
+		{
+			qWarning("Updated %d jobs, but %d of %d rows show the update, with %d completed and %d running jobs!", PROGRESS_JOBS, updated, model.rowCount(),
+				model.getJobCount(ProgressModel::JobComplete), model.getJobCount(ProgressModel::JobRunning));
+			okay = false;
+		}
+
+		qDebug("Jobs: %d, visible rows: %d, updated rows: %d", PROGRESS_JOBS, rows, updated);
+		qDebug("Insert: %7.1f ns/job (%lld ms)", double(elapsed[0]) / double(PROGRESS_JOBS), elapsed[0] / 1000000);
+		qDebug("Update: %7.1f ns/job (%lld ms)", double(elapsed[1]) / double(PROGRESS_JOBS), elapsed[1] / 1000000);
+
+		for(int i = 0; i < 2; i++)
+		{
+			if(elapsed[i] > (PROGRESS_BUDGET * 1000000))
+			{
+				qWarning("%s %d jobs took %lld ms, the budget is %lld ms!", (i > 0) ? "Updating" : "Inserting", PROGRESS_JOBS, elapsed[i] / 1000000, PROGRESS_BUDGET);
+				okay = false;
+			}
+		}
+	}
+
+	removeTempFolder(tempFolder);
+	return okay;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// File List
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Fills a file list with the given number of files and removes either every other row (the worst case, one
+ * range per row) or the upper half of the list (a single range). Returns the elapsed time, or -1 on error.
+ */
+static qint64 removeFilesTimed(const int count, const bool interleaved, const bool blockUpdates)
+{
+	FileListModel model;
+	QList<AudioFileModel> files;
+	for(int i = 0; i < count; i++)
+	{
+		files << AudioFileModel(QString("C:/Benchmark/%1.wav").arg(i, 6, 10, QChar('0')));
+	}
+	model.addFiles(files);
+
+	QModelIndexList selection;
+	for(int row = interleaved ? 0 : (count / 2); row < count; row += (interleaved ? 2 : 1))
+	{
+		selection << model.index(row, 0);
+	}
+
+	QElapsedTimer timer;
+	model.setBlockUpdates(blockUpdates);
+	timer.start();
+	const int removed = model.removeFiles(selection);
+	const qint64 elapsed = timer.nsecsElapsed();
+	model.setBlockUpdates(false);
+
+	if((removed != selection.count()) || (model.rowCount() != count - selection.count()))
+	{
+		qWarning("Removed %d of %d rows, %d rows are left!", removed, selection.count(), model.rowCount());
+		return -1;
+	}
+
+	return elapsed;
+}
+
+/*
+ * Removes large selections from file lists of increasing size. The time per removed row should stay about the
+ * same as the list grows, i.e. the removal must not scale with "selected rows x list size".
+ */
+static bool benchmark_remove(void)
+{
+	for(size_t i = 0; REMOVE_SIZES[i] > 0; i++)
+	{
+		const int count = REMOVE_SIZES[i];
+		const qint64 elapsed[3] =
+		{
+			removeFilesTimed(count, true,  false),
+			removeFilesTimed(count, true,  true ),
+			removeFilesTimed(count, false, false)
+		};
+		if((elapsed[0] < 0) || (elapsed[1] < 0) || (elapsed[2] < 0))
+		{
+			return false;
+		}
+		qDebug("%6d files: every other row %7.1f ns/row (%7.1f ns/row with blocked updates), upper half %7.1f ns/row", count,
+			double(elapsed[0]) / double(count / 2), double(elapsed[1]) / double(count / 2), double(elapsed[2]) / double(count - (count / 2)));
+	}
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Memory Usage
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Layout of the previous QObject based model (before it became an implicitly shared value type), including the
+ * private heap mutex of each ArtworkModel. It is only used to measure the "before" memory usage side by side.
+ */
+class LegacyMetaInfo : public QObject
+{
+public:
+	LegacyMetaInfo(void) : m_coverMutex(new QMutex()), m_coverData(NULL), m_year(0), m_position(0) {}
+	LegacyMetaInfo(const LegacyMetaInfo &other) : QObject(), m_titel(other.m_titel), m_artist(other.m_artist), m_album(other.m_album), m_genre(other.m_genre), m_comment(other.m_comment), m_coverMutex(new QMutex()), m_coverData(NULL), m_year(other.m_year), m_position(other.m_position) {}
+	~LegacyMetaInfo(void) { delete m_coverMutex; }
+	QString m_titel, m_artist, m_album, m_genre, m_comment, m_coverNullString;
+	QMutex *m_coverMutex;
+	void *m_coverData;
+	unsigned int m_year, m_position;
+};
+
+class LegacyTechInfo : public QObject
+{
+public:
+	LegacyTechInfo(void) : m_audioSamplerate(0), m_audioChannels(0), m_audioBitdepth(0), m_audioBitrate(0), m_audioBitrateMode(0), m_duration(0) {}
+	LegacyTechInfo(const LegacyTechInfo &other) : QObject(), m_containerType(other.m_containerType), m_containerProfile(other.m_containerProfile), m_audioType(other.m_audioType), m_audioProfile(other.m_audioProfile), m_audioVersion(other.m_audioVersion), m_audioEncodeLib(other.m_audioEncodeLib),
+		m_audioSamplerate(other.m_audioSamplerate), m_audioChannels(other.m_audioChannels), m_audioBitdepth(other.m_audioBitdepth), m_audioBitrate(other.m_audioBitrate), m_audioBitrateMode(other.m_audioBitrateMode), m_duration(other.m_duration) {}
+	QString m_containerType, m_containerProfile, m_audioType, m_audioProfile, m_audioVersion, m_audioEncodeLib;
+	unsigned int m_audioSamplerate, m_audioChannels, m_audioBitdepth, m_audioBitrate, m_audioBitrateMode, m_duration;
+};
+
+class LegacyAudioFile : public QObject
+{
+public:
+	LegacyAudioFile(const QString &filePath) : m_filePath(filePath) {}
+	LegacyAudioFile(const LegacyAudioFile &other) : QObject(), m_filePath(other.m_filePath), m_metaInfo(other.m_metaInfo), m_techInfo(other.m_techInfo) {}
+	QString m_filePath;
+	LegacyMetaInfo m_metaInfo;
+	LegacyTechInfo m_techInfo;
+};
+
+/*
+ * Creates the file with the given index, the strings are created for each file, just like the analyzer does
+ */
+static AudioFileModel makeMemoryFile(const int i)
+{
+	AudioFileModel file(QString("C:/Music/Artist %1/Album %2/%3 - Track %4.flac").arg(QString::number(i / 1000), QString::number(i / 10), QString::number(i % 10), QString::number(i)));
+	file.metaInfo().setTitle(QString("Track %1").arg(i));
+	file.metaInfo().setArtist(QString("Artist %1").arg(i / 1000));
+	file.metaInfo().setAlbum(QString("Album %1").arg(i / 10));
+	file.metaInfo().setGenre(QString("Rock"));
+	file.metaInfo().setYear(2000 + (i % 20));
+	file.metaInfo().setPosition(i % 10);
+	file.techInfo().setContainerType(QString("FLAC"));
+	file.techInfo().setAudioType(QString("FLAC"));
+	file.techInfo().setAudioEncodeLib(QString("reference libFLAC 1.3.2"));
+	file.techInfo().setAudioSamplerate(44100);
+	file.techInfo().setAudioChannels(2);
+	file.techInfo().setAudioBitdepth(16);
+	file.techInfo().setDuration(180 + (i % 120));
+	return file;
+}
+
+static LegacyAudioFile *makeLegacyMemoryFile(const int i)
+{
+	LegacyAudioFile *const file = new LegacyAudioFile(QString("C:/Music/Artist %1/Album %2/%3 - Track %4.flac").arg(QString::number(i / 1000), QString::number(i / 10), QString::number(i % 10), QString::number(i)));
+	file->m_metaInfo.m_titel = QString("Track %1").arg(i);
+	file->m_metaInfo.m_artist = QString("Artist %1").arg(i / 1000);
+	file->m_metaInfo.m_album = QString("Album %1").arg(i / 10);
+	file->m_metaInfo.m_genre = QString("Rock");
+	file->m_metaInfo.m_year = 2000 + (i % 20);
+	file->m_metaInfo.m_position = i % 10;
+	file->m_techInfo.m_containerType = QString("FLAC");
+	file->m_techInfo.m_audioType = QString("FLAC");
+	file->m_techInfo.m_audioEncodeLib = QString("reference libFLAC 1.3.2");
+	file->m_techInfo.m_audioSamplerate = 44100;
+	file->m_techInfo.m_audioChannels = 2;
+	file->m_techInfo.m_audioBitdepth = 16;
+	file->m_techInfo.m_duration = 180 + (i % 120);
+	return file;
+}
+
+static double bytesPerFile(const quint64 &before, const quint64 &after)
+{
+	return (after > before) ? (double(after - before) / double(MEMORY_FILES)) : 0.0;
+}
+
+/*
+ * Measures the growth of the working set for 100k files with typical meta and technical info, before (previous
+ * QObject layout) and after (implicitly shared value type), each for the files and for a second list of copies.
+ * All lists stay alive until the end, so that freed memory can not be re-used by the next measurement.
+ */
+static bool benchmark_memory(void)
+{
+	quint64 workingSet[5] = { 0, 0, 0, 0, 0 }, peakWorkingSet = 0;
+	QList<AudioFileModel> files, copies;
+	QList<LegacyAudioFile*> legacyFiles, legacyCopies;
+	files.reserve(MEMORY_FILES);
+	copies.reserve(MEMORY_FILES);
+	legacyFiles.reserve(MEMORY_FILES);
+	legacyCopies.reserve(MEMORY_FILES);
+
+	if(!RAMObserverThread::processMemory(workingSet[0], peakWorkingSet))
+	{
+		qWarning("Failed to query the process memory!");
+		return false;
+	}
+
+	for(int i = 0; i < MEMORY_FILES; i++)
+	{
+		legacyFiles << makeLegacyMemoryFile(i);
+	}
+	RAMObserverThread::processMemory(workingSet[1], peakWorkingSet);
+
+	for(QList<LegacyAudioFile*>::ConstIterator iter = legacyFiles.constBegin(); iter != legacyFiles.constEnd(); iter++)
+	{
+		legacyCopies << new LegacyAudioFile(**iter);
+	}
+	RAMObserverThread::processMemory(workingSet[2], peakWorkingSet);
+
+	for(int i = 0; i < MEMORY_FILES; i++)
+	{
+		files << makeMemoryFile(i);
+	}
+	RAMObserverThread::processMemory(workingSet[3], peakWorkingSet);
+
+	for(QList<AudioFileModel>::ConstIterator iter = files.constBegin(); iter != files.constEnd(); iter++)
+	{
+		copies << (*iter);
+	}
+	RAMObserverThread::processMemory(workingSet[4], peakWorkingSet);
+
+	const bool okay = (files.count() == MEMORY_FILES) && (copies.count() == MEMORY_FILES) && (legacyFiles.count() == MEMORY_FILES) && (legacyCopies.count() == MEMORY_FILES);
+	if(okay)
+	{
+		const double perFile[4] = { bytesPerFile(workingSet[0], workingSet[1]), bytesPerFile(workingSet[1], workingSet[2]), bytesPerFile(workingSet[2], workingSet[3]), bytesPerFile(workingSet[3], workingSet[4]) };
+		qDebug("Before, files : %6.1f MB per %d files (%4.0f bytes per file)", perFile[0] * double(MEMORY_FILES) / 1048576.0, MEMORY_FILES, perFile[0]);
+		qDebug("Before, copies: %6.1f MB per %d files (%4.0f bytes per file)", perFile[1] * double(MEMORY_FILES) / 1048576.0, MEMORY_FILES, perFile[1]);
+		qDebug("After,  files : %6.1f MB per %d files (%4.0f bytes per file)", perFile[2] * double(MEMORY_FILES) / 1048576.0, MEMORY_FILES, perFile[2]);
+		qDebug("After,  copies: %6.1f MB per %d files (%4.0f bytes per file)", perFile[3] * double(MEMORY_FILES) / 1048576.0, MEMORY_FILES, perFile[3]);
+		qDebug("Peak working set: %.1f MB", double(peakWorkingSet) / 1048576.0);
+	}
+	else
+	{
+		qWarning("Expected %d files, but got %d/%d files and %d/%d copies!", MEMORY_FILES, legacyFiles.count(), files.count(), legacyCopies.count(), copies.count());
+	}
+
+	qDeleteAll(legacyCopies);
+	qDeleteAll(legacyFiles);
+	return okay;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Cue Sheet Parser
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Writes a Cue Sheet with 99 tracks, the tracks are padded with comments until the file reaches the given size
+ */
+static bool writeCueSheet(const QString &filePath, const int size)
+{
+	QFile file(filePath);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		qWarning("Failed to create file: %s", MUTILS_UTF8(filePath));
+		return false;
+	}
+
+	QTextStream stream(&file);
+	stream.setCodec("UTF-8");
+	stream << "REM GENRE \"Rock\"\r\nREM DATE 2004\r\nPERFORMER \"Benchmark\"\r\nTITLE \"Benchmark\"\r\nFILE \"Benchmark.flac\" WAVE\r\n";
+
+	const int paddingPerTrack = qMax(0, size / 99);
+	for(int track = 1; track <= 99; track++)
+	{
+		stream << QString().sprintf("  TRACK %02d AUDIO\r\n    TITLE \"Track %02d\"\r\n    PERFORMER \"Benchmark\"\r\n", track, track);
+		for(int padding = 0; padding < paddingPerTrack; padding += 64)
+		{
+			stream << "    REM COMMENT \"Lorem ipsum dolor sit amet, consectetur elit\"\r\n";
+		}
+		stream << QString().sprintf("    INDEX 01 %02d:%02d:%02d\r\n", (track * 3) / 60, (track * 3) % 60, track % 75);
+	}
+
+	stream.flush();
+	file.close();
+	return (stream.status() == QTextStream::Ok);
+}
+
+/*
+ * Parses Cue Sheets of increasing size and reports the throughput, all 99 tracks must be found
+ */
+static bool benchmark_cuesheet(void)
+{
+	const QString tempFolder = createTempFolder();
+	if(tempFolder.isEmpty())
+	{
+		qWarning("Failed to create temporary folder!");
+		return false;
+	}
+
+	bool okay = true;
+	QTextCodec *const codec = QTextCodec::codecForName("UTF-8");
+
+	for(size_t i = 0; okay && (CUESHEET_SIZES[i] > 0); i++)
+	{
+		const QString filePath = QString("%1/%2.cue").arg(tempFolder, QString::number(CUESHEET_SIZES[i]));
+		if(!writeCueSheet(filePath, CUESHEET_SIZES[i]))
+		{
+			okay = false;
+			break;
+		}
+
+		CueSheetModel model;
+		QElapsedTimer timer;
+		timer.start();
+		const int result = model.loadCueSheet(filePath, NULL, codec);
+		const qint64 elapsed = timer.nsecsElapsed();
+
+		const int tracks = (model.getFileCount() > 0) ? model.getTrackCount(0) : 0;
+		if((result != CueSheetModel::ErrorSuccess) || (tracks != 99))
+		{
+			qWarning("Failed to parse the Cue Sheet (result %d, %d tracks)!", result, tracks);
+			okay = false;
+			break;
+		}
+
+		const qint64 fileSize = QFileInfo(filePath).size();
+		qDebug("%8.1f KB: %8.2f ms, %7.1f MB/s", double(fileSize) / 1024.0, double(elapsed) / 1000000.0, (elapsed > 0) ? ((double(fileSize) * 1000000000.0) / (double(elapsed) * 1048576.0)) : 0.0);
+	}
+
+	removeTempFolder(tempFolder);
+	return okay;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Tool Cache
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Hashes each binary of the folder completely, then locks it once to warm the manifest and times a second lock. The
+ * second lock must be trusted from the manifest in a trusted folder, but must be verified by hash anywhere else.
+ */
+static bool benchmarkToolsFolder(ToolCache *const toolCache, const QString &folderPath, const bool trusted)
+{
+	const QDir toolsFolder(folderPath);
+	const QStringList toolFiles = toolsFolder.entryList(QDir::Files, QDir::Name);
+
+	QElapsedTimer timer;
+	qint64 elapsed[2] = { 0, 0 }, totalSize = 0;
+	int count = 0;
+
+	for(QStringList::ConstIterator iter = toolFiles.constBegin(); iter != toolFiles.constEnd(); iter++)
+	{
+		const QString filePath = toolsFolder.absoluteFilePath(*iter);
+
+		//Full hash, as it is required on the first start
+		QFile file(filePath);
+		if(!file.open(QIODevice::ReadOnly))
+		{
+			qWarning("Failed to open file: %s", MUTILS_UTF8(filePath));
+			return false;
+		}
+		timer.start();
+		const QByteArray hash = FileHash::computeHash(file);
+		elapsed[0] += timer.nsecsElapsed();
+		totalSize += file.size();
+		file.close();
+
+		try
+		{
+			//Warm-up, makes sure the manifest entry exists
+			{
+				QScopedPointer<LockedFile> warmUp(new LockedFile(filePath, hash));
+			}
+
+			//Following starts
+			const quint32 trustedCount = toolCache->trustedCount();
+			timer.start();
+			QScopedPointer<LockedFile> lockedFile(new LockedFile(filePath, hash));
+			elapsed[1] += timer.nsecsElapsed();
+			if((toolCache->trustedCount() > trustedCount) != trusted)
+			{
+				qWarning("File was %s from the manifest unexpectedly: %s", trusted ? "not trusted" : "trusted", MUTILS_UTF8(filePath));
+				return false;
+			}
+		}
+		catch(std::runtime_error&)
+		{
+			qWarning("Failed to lock file: %s", MUTILS_UTF8(filePath));
+			return false;
+		}
+		count++;
+	}
+
+	qDebug("%s: %d files, %.1f MB", MUTILS_UTF8(folderPath), count, double(totalSize) / 1048576.0);
+	qDebug("Full hash: %8.2f ms", double(elapsed[0]) / 1000000.0);
+	qDebug("%s: %8.2f ms", trusted ? "Manifest " : "Lock     ", double(elapsed[1]) / 1000000.0);
+	return true;
+}
+
+/*
+ * Compares hashing each tool binary completely to locking it on the following starts, for the trusted "cache" folder
+ * (where the manifest is used) and for the persistent tools folder (where it must not be used)
+ */
+static bool benchmark_startup(void)
+{
+	ToolCache *const toolCache = ToolCache::instance();
+	if(!toolCache)
+	{
+		qWarning("Failed to create the tool cache!");
+		return false;
+	}
+
+	bool okay = true;
+
+	if(!toolCache->trustedFolder().isEmpty())
+	{
+		okay = benchmarkToolsFolder(toolCache, toolCache->trustedFolder(), true) && okay;
+	}
+	else
+	{
+		qDebug("No trusted cache folder (missing or writable), manifest is not used.");
+	}
+
+	if(!toolCache->toolsFolder().isEmpty())
+	{
+		okay = benchmarkToolsFolder(toolCache, toolCache->toolsFolder(), false) && okay;
+	}
+	else
+	{
+		qDebug("No persistent tools folder (portable mode?), nothing to measure.");
+	}
+
+	toolCache->flush();
+	return okay;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Benchmark table
+///////////////////////////////////////////////////////////////////////////////
+
+static const benchmark_t g_benchmarks[] =
+{
+	{ "cuesheet", benchmark_cuesheet },
+	{ "matcher",  benchmark_matcher  },
+	{ "memory",   benchmark_memory   },
+	{ "probe",    benchmark_probe    },
+	{ "progress", benchmark_progress },
+	{ "remove",   benchmark_remove   },
+	{ "spawn",    benchmark_spawn    },
+	{ "startup",  benchmark_startup  },
+	{ "wave64",   benchmark_wave64   },
+	{ NULL,       NULL               }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Public functions
+///////////////////////////////////////////////////////////////////////////////
+
+bool Benchmark::run(const QStringList &names)
+{
+	QStringList selected(names);
+	selected.removeAll(QString());
+
+	bool success = true;
+	int count = 0;
+
+	for(size_t i = 0; g_benchmarks[i].name; i++)
+	{
+		if(!(selected.isEmpty() || selected.contains(QString::fromLatin1(g_benchmarks[i].name), Qt::CaseInsensitive)))
+		{
+			continue;
+		}
+
+		qDebug("[BENCHMARK]");
+		qDebug("Running benchmark: %s", g_benchmarks[i].name);
+
+		if(g_benchmarks[i].func())
+		{
+			qDebug("Done.\n");
+		}
+		else
+		{
+			qWarning("Benchmark \"%s\" has failed!\n", g_benchmarks[i].name);
+			success = false;
+		}
+
+		count++;
+	}
+
+	if(count < 1)
+	{
+		qWarning("No matching benchmark found!");
+		return false;
+	}
+
+	return success;
+}
@@ -24,6 +24,7 @@
 
 //Internal
 #include "Global.h"
+#include "Tool_ProgressMatcher.h"
 
 //MUtils
 #include <MUtils/Exception.h>
@@ -68,26 +69,7 @@ bool AACDecoder::decode(const QString &sourceFile, const QString &outputFile, QA
 		return false;
 	}
 
-	int prevProgress = -1;
-	QRegExp regExp("\\[(\\d+)%\\]\\s*decoding", Qt::CaseInsensitive); //regExp("\\b(\\d+)%\\s+decoding", Qt::CaseInsensitive);
-
-	const result_t result = awaitProcess(process, abortFlag, [this, &prevProgress, &regExp](const QString &text)
-	{
-		if (regExp.lastIndexIn(text) >= 0)
-		{
-			qint32 newProgress;
-			if (MUtils::regexp_parse_int32(regExp, newProgress))
-			{
-				if (newProgress > prevProgress)
-				{
-					emit statusUpdated(newProgress);
-					prevProgress = NEXT_PROGRESS(newProgress);
-				}
-			}
-			return true;
-		}
-		return false;
-	});
+	const result_t result = awaitProcess(process, abortFlag, ProgressMatcher("[", "] decoding"));
 	
 	return (result == RESULT_SUCCESS);
 }
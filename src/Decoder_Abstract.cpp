@@ -41,6 +41,11 @@ bool AbstractDecoder::isFormatSupported(const QString& /*containerType*/, const
 	return false;
 }
 
+bool AbstractDecoder::pipeCommand(const QString& /*sourceFile*/, QString& /*program*/, QStringList& /*args*/)
+{
+	return false; /*decoder can not write to stdout*/
+}
+
 bool AbstractDecoder::isDecoderAvailable(void)
 {
 	return true;
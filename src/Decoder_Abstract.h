@@ -37,6 +37,7 @@ public:
 
 	//Internal decoder API
 	virtual bool decode(const QString &sourceFile, const QString &outputFile, QAtomicInt &abortFlag) = 0;
+	virtual bool pipeCommand(const QString &sourceFile, QString &program, QStringList &args);
 	static bool isFormatSupported(const QString &containerType, const QString &containerProfile, const QString &formatType, const QString &formatProfile, const QString &formatVersion);
 	static bool isDecoderAvailable(void);
 	static const supportedType_t *supportedTypes(void);
@@ -24,6 +24,7 @@
 
 //Internal
 #include "Global.h"
+#include "Tool_ProgressMatcher.h"
 
 //MUtils
 #include <MUtils/Exception.h>
@@ -31,7 +32,6 @@
 //Qt
 #include <QDir>
 #include <QProcess>
-#include <QRegExp>
 
 FLACDecoder::FLACDecoder(void)
 :
@@ -61,30 +61,20 @@ bool FLACDecoder::decode(const QString &sourceFile, const QString &outputFile, Q
 		return false;
 	}
 
-	int prevProgress = -1;
-	QRegExp regExp("\\b(\\d+)% complete");
-
-	const result_t result = awaitProcess(process, abortFlag, [this, &prevProgress, &regExp](const QString &text)
-	{
-		if (regExp.lastIndexIn(text) >= 0)
-		{
-			qint32 newProgress;
-			if (MUtils::regexp_parse_int32(regExp, newProgress))
-			{
-				if (newProgress > prevProgress)
-				{
-					emit statusUpdated(newProgress);
-					prevProgress = NEXT_PROGRESS(newProgress);
-				}
-			}
-			return true;
-		}
-		return false;
-	});
+	const result_t result = awaitProcess(process, abortFlag, ProgressMatcher("", " complete"));
 	
 	return (result == RESULT_SUCCESS);
 }
 
+bool FLACDecoder::pipeCommand(const QString &sourceFile, QString &program, QStringList &args)
+{
+	args << "-d" << "-F" << "-s" << "-c";
+	args << QDir::toNativeSeparators(sourceFile);
+
+	program = m_binary;
+	return true;
+}
+
 bool FLACDecoder::isFormatSupported(const QString &containerType, const QString& /*containerProfile*/, const QString &formatType, const QString& /*formatProfile*/, const QString& /*formatVersion*/)
 {
 	static const QLatin1String flac("FLAC");
@@ -102,6 +102,15 @@ bool MP3Decoder::decode(const QString &sourceFile, const QString &outputFile, QA
 	return (result == RESULT_SUCCESS);
 }
 
+bool MP3Decoder::pipeCommand(const QString &sourceFile, QString &program, QStringList &args)
+{
+	args << "-q" << "--utf8" << "-w" << "-";
+	args << QDir::toNativeSeparators(sourceFile);
+
+	program = m_binary;
+	return true;
+}
+
 bool MP3Decoder::isFormatSupported(const QString &containerType, const QString& /*containerProfile*/, const QString &formatType, const QString &formatProfile, const QString &formatVersion)
 {
 	static const QLatin1String mpegAudio("MPEG Audio"), waveAudio("Wave");
@@ -32,6 +32,7 @@ public:
 	~MP3Decoder(void);
 
 	virtual bool decode(const QString &sourceFile, const QString &outputFile, QAtomicInt &abortFlag);
+	virtual bool pipeCommand(const QString &sourceFile, QString &program, QStringList &args);
 	static bool isFormatSupported(const QString &containerType, const QString &containerProfile, const QString &formatType, const QString &formatProfile, const QString &formatVersion);
 	static const supportedType_t *supportedTypes(void);
 
@@ -24,6 +24,7 @@
 
 //Internal
 #include "Global.h"
+#include "Tool_ProgressMatcher.h"
 
 //MUtils
 #include <MUtils/Exception.h>
@@ -31,7 +32,6 @@
 //Qt
 #include <QDir>
 #include <QProcess>
-#include <QRegExp>
 #include <QUuid>
 
 MusepackDecoder::MusepackDecoder(void)
@@ -62,26 +62,7 @@ bool MusepackDecoder::decode(const QString &sourceFile, const QString &outputFil
 		return false;
 	}
 
-	int prevProgress = -1;
-	QRegExp regExp("Decoding progress: (\\d+)\\.(\\d+)%");
-
-	const result_t result = awaitProcess(process, abortFlag, [this, &prevProgress, &regExp](const QString &text)
-	{
-		if (regExp.lastIndexIn(text) >= 0)
-		{
-			qint32 newProgress;
-			if (MUtils::regexp_parse_int32(regExp, newProgress))
-			{
-				if (newProgress > prevProgress)
-				{
-					emit statusUpdated(newProgress);
-					prevProgress = NEXT_PROGRESS(newProgress);
-				}
-			}
-			return true;
-		}
-		return false;
-	});
+	const result_t result = awaitProcess(process, abortFlag, ProgressMatcher("Decoding progress:"));
 	
 	return (result == RESULT_SUCCESS);
 }
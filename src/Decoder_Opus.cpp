@@ -24,6 +24,7 @@
 
 //Internal
 #include "Global.h"
+#include "Tool_ProgressMatcher.h"
 
 //MUtils
 #include <MUtils/Exception.h>
@@ -31,7 +32,6 @@
 //Qt
 #include <QDir>
 #include <QProcess>
-#include <QRegExp>
 #include <QUuid>
 
 static const quint32 OPUS_DEFAULT_SAMPLING_RATE = 48000;
@@ -70,26 +70,7 @@ bool OpusDecoder::decode(const QString &sourceFile, const QString &outputFile, Q
 		return false;
 	}
 
-	int prevProgress = -1;
-	QRegExp regExp("\\((\\d+)\\.(\\d+)%\\)");
-
-	const result_t result = awaitProcess(process, abortFlag, [this, &prevProgress, &regExp](const QString &text)
-	{
-		if (regExp.lastIndexIn(text) >= 0)
-		{
-			qint32 newProgress;
-			if (MUtils::regexp_parse_int32(regExp, newProgress))
-			{
-				if (newProgress > prevProgress)
-				{
-					emit statusUpdated(newProgress);
-					prevProgress = NEXT_PROGRESS(newProgress);
-				}
-			}
-			return true;
-		}
-		return false;
-	});
+	const result_t result = awaitProcess(process, abortFlag, ProgressMatcher("(", ")"));
 
 	return (result == RESULT_SUCCESS);
 }
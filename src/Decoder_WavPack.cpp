@@ -24,6 +24,7 @@
 
 //Internal
 #include "Global.h"
+#include "Tool_ProgressMatcher.h"
 
 //MUtils
 #include <MUtils/Exception.h>
@@ -31,7 +32,6 @@
 //Qt
 #include <QDir>
 #include <QProcess>
-#include <QRegExp>
 
 WavPackDecoder::WavPackDecoder(void)
 :
@@ -61,30 +61,21 @@ bool WavPackDecoder::decode(const QString &sourceFile, const QString &outputFile
 		return false;
 	}
 
-	int prevProgress = -1;
-	QRegExp regExp("\\b(\\d+)%\\s+done");
-
-	const result_t result = awaitProcess(process, abortFlag, [this, &prevProgress, &regExp](const QString &text)
-	{
-		if (regExp.lastIndexIn(text) >= 0)
-		{
-			qint32 newProgress;
-			if (MUtils::regexp_parse_int32(regExp, newProgress))
-			{
-				if (newProgress > prevProgress)
-				{
-					emit statusUpdated(newProgress);
-					prevProgress = NEXT_PROGRESS(newProgress);
-				}
-			}
-			return true;
-		}
-		return false;
-	});
+	const result_t result = awaitProcess(process, abortFlag, ProgressMatcher("", " done"));
 	
 	return (result == RESULT_SUCCESS);
 }
 
+bool WavPackDecoder::pipeCommand(const QString &sourceFile, QString &program, QStringList &args)
+{
+	args << "-y" << "-q";
+	args << QDir::toNativeSeparators(sourceFile);
+	args << "-";
+
+	program = m_binary;
+	return true;
+}
+
 bool WavPackDecoder::isFormatSupported(const QString &containerType, const QString& /*containerProfile*/, const QString &formatType, const QString& /*formatProfile*/, const QString& /*formatVersion*/)
 {
 	static const QLatin1String wavPack("WavPack");
@@ -202,6 +202,8 @@ int CueImportDialog::exec(void)
 
 	setWindowTitle(QString("%1: %2").arg(windowTitle().split(":", QString::SkipEmptyParts).first().trimmed(), cueFileInfo.fileName()));
 
+	connect(m_model, SIGNAL(progressValChanged(unsigned int)), progress, SLOT(setProgressVal(unsigned int)));
+	connect(m_model, SIGNAL(progressMaxChanged(unsigned int)), progress, SLOT(setProgressMax(unsigned int)));
 	int iResult = m_model->loadCueSheet(m_cueFileName, QApplication::instance(), codec);
 	if(iResult != CueSheetModel::ErrorSuccess)
 	{
@@ -288,6 +290,14 @@ void CueImportDialog::importButtonClicked(void)
 	static const unsigned __int64 oneGigabyte = 1073741824ui64; 
 	static const unsigned __int64 minimumFreeDiskspaceMultiplier = 2ui64;
 	static const char *writeTestBuffer = "LAMEXP_WRITE_TEST";
+
+	//Tracks are imported as ranges of the source file(s), unless they are to be written to the output directory
+	if(!ui->groupBoxArtwork->isChecked())
+	{
+		importCueSheet();
+		accept();
+		return;
+	}
 	
 	QDir outputDir(m_outputDir);
 	outputDir.mkpath(".");
@@ -328,10 +338,13 @@ void CueImportDialog::loadOtherButtonClicked(void)
 	done(-1);
 }
 
-void CueImportDialog::analyzedFile(const AudioFileModel &file)
+void CueImportDialog::analyzedFiles(const QList<AudioFileModel> &files)
 {
-	qDebug("Received result: <%s> <%s/%s>", file.filePath().toLatin1().constData(), file.techInfo().containerType().toLatin1().constData(), file.techInfo().audioType().toLatin1().constData());
-	m_fileInfo << file;
+	for(QList<AudioFileModel>::ConstIterator iter = files.constBegin(); iter != files.constEnd(); iter++)
+	{
+		qDebug("Received result: <%s> <%s/%s>", iter->filePath().toLatin1().constData(), iter->techInfo().containerType().toLatin1().constData(), iter->techInfo().audioType().toLatin1().constData());
+	}
+	m_fileInfo << files;
 }
 
 ////////////////////////////////////////////////////////////
@@ -399,7 +412,7 @@ bool CueImportDialog::analyzeFiles(QStringList &files)
 	FileAnalyzer *analyzer = new FileAnalyzer(files);
 	
 	connect(analyzer, SIGNAL(fileSelected(QString)), progress, SLOT(setText(QString)), Qt::QueuedConnection);
-	connect(analyzer, SIGNAL(fileAnalyzed(AudioFileModel)), this, SLOT(analyzedFile(AudioFileModel)), Qt::QueuedConnection);
+	connect(analyzer, SIGNAL(filesAnalyzed(QList<AudioFileModel>)), this, SLOT(analyzedFiles(QList<AudioFileModel>)), Qt::QueuedConnection);
 	connect(progress, SIGNAL(userAbort()), analyzer, SLOT(abortProcess()), Qt::DirectConnection);
 
 	progress->show(tr("Analyzing file(s), please wait..."), analyzer);
@@ -423,8 +436,11 @@ void CueImportDialog::splitFiles(void)
 {
 	QString baseName = QFileInfo(m_cueFileName).completeBaseName().replace(".", " ").simplified();
 
+	//Virtual tracks refer to a range of the source file, they are sliced (or decoded) by the encoding job
+	const bool virtualTracks = !ui->groupBoxArtwork->isChecked();
+
 	QScopedPointer<WorkingBanner> progress(new WorkingBanner(this));
-	QScopedPointer<CueSplitter> splitter(new CueSplitter(m_outputDir, baseName, m_model, m_fileInfo));
+	QScopedPointer<CueSplitter> splitter(new CueSplitter(m_outputDir, baseName, m_model, m_fileInfo, virtualTracks));
 
 	connect(splitter.data(), SIGNAL(fileSelected(QString)), progress.data(), SLOT(setText(QString)), Qt::QueuedConnection);
 	connect(splitter.data(), SIGNAL(fileSplit(AudioFileModel)), m_fileList, SLOT(addFile(AudioFileModel)), Qt::QueuedConnection);
@@ -434,7 +450,7 @@ void CueImportDialog::splitFiles(void)
 
 	DecoderRegistry::configureDecoders(m_settings);
 
-	progress->show(tr("Splitting file(s), please wait..."), splitter.data());
+	progress->show(virtualTracks ? tr("Importing track(s), please wait...") : tr("Splitting file(s), please wait..."), splitter.data());
 	progress->close();
 
 	if(splitter->getAborted())
@@ -54,7 +54,7 @@ private slots:
 	void importButtonClicked(void);
 	void loadOtherButtonClicked(void);
 	void modelChanged(void);
-	void analyzedFile(const AudioFileModel &file);
+	void analyzedFiles(const QList<AudioFileModel> &files);
 
 private:
 	Ui::CueSheetImport *ui; //for Qt UIC
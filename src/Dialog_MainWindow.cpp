@@ -306,6 +306,7 @@ MainWindow::MainWindow(MUtils::IPCChannel *const ipcChannel, FileListModel *cons
 
 	//Register meta types
 	qRegisterMetaType<AudioFileModel>("AudioFileModel");
+	qRegisterMetaType<QList<AudioFileModel>>("QList<AudioFileModel>");
 
 	//Enabled main buttons
 	connect(ui->buttonAbout, SIGNAL(clicked()), this, SLOT(aboutButtonClicked()));
@@ -834,12 +835,12 @@ void MainWindow::addFiles(const QStringList &files)
 	}
 
 	INIT_BANNER();
-	QScopedPointer<FileAnalyzer> analyzer(new FileAnalyzer(files));
+	QScopedPointer<FileAnalyzer> analyzer(new FileAnalyzer(files, m_settings->analysisCacheEnabled()));
 
 	connect(analyzer.data(), SIGNAL(fileSelected(QString)),            m_banner.data(), SLOT(setText(QString)),             Qt::QueuedConnection);
 	connect(analyzer.data(), SIGNAL(progressValChanged(unsigned int)), m_banner.data(), SLOT(setProgressVal(unsigned int)), Qt::QueuedConnection);
 	connect(analyzer.data(), SIGNAL(progressMaxChanged(unsigned int)), m_banner.data(), SLOT(setProgressMax(unsigned int)), Qt::QueuedConnection);
-	connect(analyzer.data(), SIGNAL(fileAnalyzed(AudioFileModel)),     m_fileListModel, SLOT(addFile(AudioFileModel)),      Qt::QueuedConnection);
+	connect(analyzer.data(), SIGNAL(filesAnalyzed(QList<AudioFileModel>)), m_fileListModel, SLOT(addFiles(QList<AudioFileModel>)), Qt::QueuedConnection);
 	connect(m_banner.data(), SIGNAL(userAbort()),                      analyzer.data(), SLOT(abortProcess()),               Qt::DirectConnection);
 
 	if(!analyzer.isNull())
@@ -871,6 +872,11 @@ void MainWindow::addFiles(const QStringList &files)
 		QMessageBox::warning(this, tr("Files Rejected"), NOBREAK(QString("%1<br>%2").arg(tr("%n file(s) have been rejected, because the file format could not be recognized!", "", analyzer->filesRejected()), tr("This usually means the file is damaged or the file format is not supported."))));
 	}
 
+	if(const unsigned int lookups = analyzer->cacheHits() + analyzer->cacheMisses())
+	{
+		qDebug("Analysis cache: %u of %u file(s) taken from the cache, %u file(s) analyzed (hit rate: %.1f%%)\n", analyzer->cacheHits(), lookups, analyzer->cacheMisses(), (100.0 * double(analyzer->cacheHits())) / double(lookups));
+	}
+
 	m_banner->close();
 }
 
@@ -1099,14 +1105,7 @@ void MainWindow::moveSelectedFiles(const bool &up)
 			const int selectionCount = selectedRows.count();
 			if(abs(delta) > 0)
 			{
-				FileListBlockHelper fileListBlocker(m_fileListModel);
-				for(QModelIndexList::ConstIterator iter = selectedRows.constBegin(); iter != selectedRows.constEnd(); iter++)
-				{
-					if(!m_fileListModel->moveFile((*iter), delta))
-					{
-						break;
-					}
-				}
+				m_fileListModel->moveFiles(selectedRows, delta);
 			}
 			selection->clearSelection();
 			for(int i = 0; i < selectionCount; i++)
@@ -2500,15 +2499,8 @@ void MainWindow::removeFileButtonClicked(void)
 		const QModelIndexList selectedRows = INVERT_LIST(selection->selectedRows());
 		if(!selectedRows.isEmpty())
 		{
-			FileListBlockHelper fileListBlocker(m_fileListModel);
 			firstRow = selectedRows.last().row();
-			for(QModelIndexList::ConstIterator iter = selectedRows.constBegin(); iter != selectedRows.constEnd(); iter++)
-			{
-				if(!m_fileListModel->removeFile(*iter))
-				{
-					break;
-				}
-			}
+			m_fileListModel->removeFiles(selectedRows);
 		}
 		if(m_fileListModel->rowCount() > 0)
 		{
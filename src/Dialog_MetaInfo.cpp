@@ -25,6 +25,7 @@
 //Internal
 #include "Global.h"
 #include "Model_MetaInfo.h"
+#include "Thread_FileAnalyzer_Task.h"
 
 //MUtils
 #include <MUtils/Global.h>
@@ -35,16 +36,29 @@
 #include <QTimer>
 #include <QFileDialog>
 #include <QMenu>
+#include <QApplication>
+#include <QtConcurrentRun>
 
 #define SET_FONT_BOLD(WIDGET,BOLD) { QFont _font = WIDGET->font(); _font.setBold(BOLD); WIDGET->setFont(_font); }
 
+//Extract the embedded cover art (runs in a worker thread)
+static AudioFileModel_MetaInfo retrieveCover(const QString &filePath)
+{
+	AudioFileModel_MetaInfo coverInfo;
+	coverInfo.setCoverEmbedded(true);
+	AnalyzeTask::retrieveEmbeddedCover(filePath, coverInfo);
+	return coverInfo;
+}
+
 ////////////////////////////////////////////////////////////
 // Constructor & Destructor
 ////////////////////////////////////////////////////////////
 
 MetaInfoDialog::MetaInfoDialog(QWidget *parent)
 :
-	QDialog(parent)
+	QDialog(parent),
+	m_audioFile(NULL),
+	m_coverPending(false)
 {
 	//Init the dialog, from the .ui file
 	setupUi(this);
@@ -85,6 +99,7 @@ MetaInfoDialog::MetaInfoDialog(QWidget *parent)
 	connect(clearMetaInfoAction, SIGNAL(triggered(bool)), this, SLOT(clearMetaInfoActionTriggered()));
 	connect(loadArtworkAction, SIGNAL(triggered(bool)), this, SLOT(editButtonClicked()));
 	connect(clearArtworkAction, SIGNAL(triggered(bool)), this, SLOT(clearArtworkActionTriggered()));
+	connect(&m_coverWatcher, SIGNAL(finished()), this, SLOT(coverRetrieved()));
 
 	//Install event filter
 	labelArtwork->installEventFilter(this);
@@ -115,30 +130,22 @@ int MetaInfoDialog::exec(AudioFileModel &audioFile, bool allowUp, bool allowDown
 	downButton->setEnabled(allowDown);
 	buttonArtwork->setChecked(false);
 
-	if(!audioFile.metaInfo().cover().isEmpty())
-	{
-		QImage artwork;
-		if(artwork.load(audioFile.metaInfo().cover()))
-		{
-			if((artwork.width() > 256) || (artwork.height() > 256))
-			{
-				artwork = artwork.scaled(256, 256, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-			}
-			labelArtwork->setPixmap(QPixmap::fromImage(artwork));
-		}
-		else
-		{
-			qWarning("Error: Failed to load cover art!");
-			labelArtwork->setPixmap(QPixmap::fromImage(QImage(":/images/CD.png")));
-		}
-	}
-	else
+	//Extract embedded cover art in the background, if it has not been extracted yet
+	m_audioFile = &audioFile;
+	m_coverPending = audioFile.metaInfo().coverEmbedded();
+	if(m_coverPending)
 	{
-		labelArtwork->setPixmap(QPixmap::fromImage(QImage(":/images/CD.png")));
+		m_coverWatcher.setFuture(QtConcurrent::run(retrieveCover, audioFile.filePath()));
 	}
 
+	showArtwork(audioFile.metaInfo().cover());
+
 	int iResult = QDialog::exec();
 	
+	//A cover that is still being extracted will be extracted again next time
+	m_coverPending = false;
+	m_audioFile = NULL;
+
 	tableView->setModel(NULL);
 	MUTILS_DELETE(model);
 
@@ -231,6 +238,25 @@ void MetaInfoDialog::clearArtworkActionTriggered(void)
 	dynamic_cast<MetaInfoModel*>(tableView->model())->editArtwork(QString());
 }
 
+void MetaInfoDialog::coverRetrieved(void)
+{
+	if((!m_audioFile) || (!m_coverPending) || (!m_coverWatcher.isFinished()))
+	{
+		return;
+	}
+
+	m_coverPending = false;
+
+	//Do not replace artwork that has been assigned or cleared in the meantime
+	AudioFileModel_MetaInfo &metaInfo = m_audioFile->metaInfo();
+	if(metaInfo.coverEmbedded())
+	{
+		metaInfo.update(m_coverWatcher.result(), false);
+		metaInfo.setCoverEmbedded(false); /*try only once*/
+		showArtwork(metaInfo.cover());
+	}
+}
+
 bool MetaInfoDialog::eventFilter(QObject *obj, QEvent *event)
 {
 	if((obj == labelArtwork) && (event->type() == QEvent::MouseButtonDblClick))
@@ -241,3 +267,27 @@ bool MetaInfoDialog::eventFilter(QObject *obj, QEvent *event)
 
 	return QDialog::eventFilter(obj, event);
 }
+
+////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////
+
+void MetaInfoDialog::showArtwork(const QString &filePath)
+{
+	if(!filePath.isEmpty())
+	{
+		QImage artwork;
+		if(artwork.load(filePath))
+		{
+			if((artwork.width() > 256) || (artwork.height() > 256))
+			{
+				artwork = artwork.scaled(256, 256, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+			}
+			labelArtwork->setPixmap(QPixmap::fromImage(artwork));
+			return;
+		}
+		qWarning("Error: Failed to load cover art!");
+	}
+
+	labelArtwork->setPixmap(QPixmap::fromImage(QImage(":/images/CD.png")));
+}
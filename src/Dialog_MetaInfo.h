@@ -23,6 +23,7 @@
 #pragma once
 
 #include <QDialog>
+#include <QFutureWatcher>
 #include "UIC_MetaInfo.h"
 
 #include "Model_AudioFile.h"
@@ -46,11 +47,18 @@ private slots:
 	void copyMetaInfoActionTriggered(void);
 	void clearMetaInfoActionTriggered(void);
 	void clearArtworkActionTriggered(void);
+	void coverRetrieved(void);
 
 protected:
 	bool eventFilter(QObject *obj, QEvent *event);
 
 private:
+	void showArtwork(const QString &filePath);
+
 	QMenu *m_contextMenuInfo;
 	QMenu *m_contextMenuArtwork;
+
+	AudioFileModel *m_audioFile;
+	QFutureWatcher<AudioFileModel_MetaInfo> m_coverWatcher;
+	bool m_coverPending;
 };
@@ -31,7 +31,12 @@
 #include "Model_Progress.h"
 #include "Model_Settings.h"
 #include "Model_FileExts.h"
+#include "Model_JobCost.h"
+#include "Model_Concurrency.h"
+#include "Model_JobStatistics.h"
 #include "Thread_Process.h"
+#include "Thread_Process_Stages.h"
+#include "Thread_Process_Mailbox.h"
 #include "Thread_CPUObserver.h"
 #include "Thread_RAMObserver.h"
 #include "Thread_DiskObserver.h"
@@ -42,6 +47,7 @@
 #include "Filter_Normalize.h"
 #include "Filter_Resample.h"
 #include "Filter_ToneAdjust.h"
+#include "Tool_Abstract.h"
 
 //MUtils
 #include <MUtils/Global.h>
@@ -70,8 +76,11 @@
 #include <QProgressDialog>
 #include <QResizeEvent>
 #include <QTime>
+#include <QDateTime>
 #include <QElapsedTimer>
 #include <QThreadPool>
+#include <QVector>
+#include <QSet>
 
 #include <math.h>
 #include <float.h>
@@ -80,6 +89,9 @@
 //Maximum number of parallel instances
 #define MAX_INSTANCES 64U
 
+//Interval for delivering job status and log updates to the GUI (in milliseconds)
+#define MAILBOX_INTERVAL 100
+
 ////////////////////////////////////////////////////////////
 
 #define CHANGE_BACKGROUND_COLOR(WIDGET, COLOR) do \
@@ -180,6 +192,7 @@ ProcessingDialog::ProcessingDialog(FileListModel *const fileListModel, const Aud
 
 	//Register meta type
 	qRegisterMetaType<QUuid>("QUuid");
+	qRegisterMetaType<JobStatistics>("JobStatistics");
 
 	//Adjust size to DPI settings and re-center
 	MUtils::GUI::scale_widget(this);
@@ -200,17 +213,21 @@ ProcessingDialog::ProcessingDialog(FileListModel *const fileListModel, const Aud
 	m_iconSuccess.reset(new QIcon(":/icons/accept.png"));
 
 	//Init progress model
-	m_progressModel.reset(new ProgressModel());
+	m_progressModel.reset(new ProgressModel(m_tempFolder));
 	ui->view_log->setModel(m_progressModel.data());
+	m_mailbox.reset(new ProcessMailbox());
+	m_mailboxTimer.reset(new QTimer());
+	connect(m_mailboxTimer.data(), SIGNAL(timeout()), this, SLOT(drainMailbox()));
 	ui->view_log->verticalHeader()->setResizeMode(QHeaderView::ResizeToContents);
 	ui->view_log->verticalHeader()->hide();
 	ui->view_log->horizontalHeader()->setResizeMode(QHeaderView::ResizeToContents);
 	ui->view_log->horizontalHeader()->setResizeMode(0, QHeaderView::Stretch);
 	ui->view_log->viewport()->installEventFilter(this);
-	connect(m_progressModel.data(), SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(progressModelChanged()));
+	connect(m_progressModel.data(), SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(progressModelRowsInserted(QModelIndex,int,int)));
+	connect(m_progressModel.data(), SIGNAL(dataChanged(QModelIndex,QModelIndex)), this, SLOT(progressModelDataChanged(QModelIndex,QModelIndex)));
 	connect(m_progressModel.data(), SIGNAL(rowsMoved(QModelIndex,int,int,QModelIndex,int)), this, SLOT(progressModelChanged()));
 	connect(m_progressModel.data(), SIGNAL(rowsRemoved(QModelIndex,int,int)), this, SLOT(progressModelChanged()));
-	connect(m_progressModel.data(), SIGNAL(modelReset()), this, SLOT(progressModelChanged()));
+	connect(m_progressModel.data(), SIGNAL(modelReset()), this, SLOT(progressModelReset()));
 	connect(ui->view_log, SIGNAL(activated(QModelIndex)), this, SLOT(logViewDoubleClicked(QModelIndex)));
 	connect(ui->view_log->horizontalHeader(), SIGNAL(sectionResized(int,int,int)), this, SLOT(logViewSectionSizeChanged(int,int,int)));
 
@@ -280,7 +297,7 @@ ProcessingDialog::ProcessingDialog(FileListModel *const fileListModel, const Aud
 	{
 		for(int i = 0; i < fileListModel->rowCount(); i++)
 		{
-			m_pendingJobs.append(fileListModel->getFile(fileListModel->index(i,0)));
+			m_pendingJobs.append(qMakePair(static_cast<unsigned int>(i), fileListModel->getFile(fileListModel->index(i,0))));
 		}
 	}
 
@@ -488,8 +505,14 @@ void ProcessingDialog::initEncoding(void)
 	m_skippedJobs.clear();
 	m_userAborted = m_forcedAbort = false;
 	m_playList.clear();
+	m_jobStatistics.clear();
+	m_mailbox->clear();
+	m_mailboxTimer->start(MAILBOX_INTERVAL);
 	m_progressIndicator->start();
 
+	AbstractTool::setSpawnRate(qMax(0, m_settings->spawnRate()), qMax(1, m_settings->spawnBurst()));
+	AbstractTool::resetSpawnStatistics();
+
 	MUtils::OS::change_process_priority(1);
 	DecoderRegistry::configureDecoders(m_settings);
 
@@ -510,6 +533,7 @@ void ProcessingDialog::initEncoding(void)
 		m_diskObserver.reset(new DiskObserverThread(m_tempFolder));
 		connect(m_diskObserver.data(), SIGNAL(messageLogged(QString,int)), m_progressModel.data(), SLOT(addSystemMessage(QString,int)), Qt::QueuedConnection);
 		connect(m_diskObserver.data(), SIGNAL(freeSpaceChanged(quint64)), this, SLOT(diskUsageHasChanged(quint64)), Qt::QueuedConnection);
+		connect(m_diskObserver.data(), SIGNAL(throughputChanged(double)), this, SLOT(diskThroughputHasChanged(double)), Qt::QueuedConnection);
 		m_diskObserver->start();
 	}
 	if(!m_cpuObserver)
@@ -534,6 +558,22 @@ void ProcessingDialog::initEncoding(void)
 		}
 	}
 
+	if(m_jobCost.isNull())
+	{
+		m_jobCost.reset(new JobCostModel(m_settings->compressionEncoder()));
+	}
+	if(m_settings->jobOrderingEnabled())
+	{
+		sortPendingJobs();
+	}
+
+	if(m_stages.isNull() && m_settings->pipelinedStagesEnabled() && (m_pendingJobs.count() > m_threadPool->maxThreadCount()))
+	{
+		m_stages.reset(new ProcessStages(m_threadPool->maxThreadCount()));
+		m_threadPool->setMaxThreadCount(qMin(m_pendingJobs.count(), static_cast<int>(m_stages->instances() + m_stages->lookAhead())));
+		m_progressModel->addSystemMessage(tr("Pipelined processing enabled: Up to %1 files in progress (%2 decoding, %3 filtering, %4 encoding).").arg(QString::number(m_threadPool->maxThreadCount()), QString::number(m_stages->limit(ProcessStages::Stage_Decode)), QString::number(m_stages->limit(ProcessStages::Stage_Filter)), QString::number(m_stages->limit(ProcessStages::Stage_Encode))), ProgressModel::SysMsg_Performance);
+	}
+
 	m_initThreads = m_threadPool->maxThreadCount();
 	QTimer::singleShot(100, this, SLOT(initNextJob()));
 
@@ -565,7 +605,8 @@ void ProcessingDialog::startNextJob(void)
 	m_runningThreads++;
 
 	//Fetch next file
-	AudioFileModel currentFile = m_pendingJobs.takeFirst();
+	const unsigned int currentIndex = m_pendingJobs.first().first;
+	AudioFileModel currentFile = m_pendingJobs.takeFirst().second;
 	updateMetaInfo(currentFile);
 
 	//Create encoder instance
@@ -629,16 +670,22 @@ void ProcessingDialog::startNextJob(void)
 	{
 		thread->setKeepDateTime(m_settings->keepOriginalDataTime());
 	}
+	thread->setStreamingMode(m_settings->streamingModeEnabled());
+	if (!m_stages.isNull())
+	{
+		thread->setStages(m_stages.data());
+	}
 
-	//Save job UUID
-	m_allJobs.append(thread->getId());
+	//Save job UUID, in the original order of the file list
+	m_allJobs.insert(currentIndex, thread->getId());
+
+	//Status, progress and log are delivered via the mailbox
+	thread->setMailbox(m_mailbox->attach(thread->getId()));
 	
 	//Connect thread signals
 	connect(thread.data(), SIGNAL(processFinished()), this, SLOT(doneEncoding()), Qt::QueuedConnection);
-	connect(thread.data(), SIGNAL(processStateInitialized(QUuid,QString,QString,int)), m_progressModel.data(), SLOT(addJob(QUuid,QString,QString,int)), Qt::QueuedConnection);
-	connect(thread.data(), SIGNAL(processStateChanged(QUuid,QString,int)), m_progressModel.data(), SLOT(updateJob(QUuid,QString,int)), Qt::QueuedConnection);
 	connect(thread.data(), SIGNAL(processStateFinished(QUuid,QString,int)), this, SLOT(processFinished(QUuid,QString,int)), Qt::QueuedConnection);
-	connect(thread.data(), SIGNAL(processMessageLogged(QUuid,QString)), m_progressModel.data(), SLOT(appendToLog(QUuid,QString)), Qt::QueuedConnection);
+	connect(thread.data(), SIGNAL(processStatistics(QUuid,JobStatistics)), this, SLOT(processStatistics(QUuid,JobStatistics)), Qt::QueuedConnection);
 	connect(this, SIGNAL(abortRunningTasks()), thread.data(), SLOT(abort()), Qt::DirectConnection);
 
 	//Initialize thread object
@@ -648,6 +695,7 @@ void ProcessingDialog::startNextJob(void)
 	}
 
 	//Give it a go!
+	m_jobCost->jobStarted(thread->getId(), currentFile.techInfo().duration(), needsDecoding(currentFile), countFilters(currentFile));
 	if(!thread->start(m_threadPool.data()))
 	{
 		qWarning("Job failed to start or the file was skipped!");
@@ -679,9 +727,13 @@ void ProcessingDialog::doneEncoding(void)
 	
 	if((!m_pendingJobs.isEmpty()) && (!m_userAborted))
 	{
-		QTimer::singleShot(25, this, SLOT(startNextJob()));
-		qDebug("%d files left, starting next job...", m_pendingJobs.count());
-		return;
+		if(m_runningThreads < static_cast<unsigned int>(m_threadPool->maxThreadCount()))
+		{
+			QTimer::singleShot(25, this, SLOT(startNextJob()));
+			qDebug("%d files left, starting next job...", m_pendingJobs.count());
+			return;
+		}
+		qDebug("%d files left, but the number of instances has been reduced.", m_pendingJobs.count());
 	}
 	
 	if(m_runningThreads > 0)
@@ -693,12 +745,45 @@ void ProcessingDialog::doneEncoding(void)
 	QApplication::setOverrideCursor(Qt::WaitCursor);
 	qDebug("Running jobs: %u", m_runningThreads);
 
+	m_mailboxTimer->stop();
+	drainMailbox();
+
+	if(!m_jobCost.isNull())
+	{
+		m_jobCost->save();
+	}
+
 	if(!m_userAborted && m_settings->createPlaylist() && !m_settings->outputToSourceDir())
 	{
 		SET_PROGRESS_TEXT(tr("Creating the playlist file, please wait..."));
 		qApp->processEvents(QEventLoop::ExcludeUserInputEvents);
 		writePlayList();
 	}
+
+	if(!m_jobStatistics.isEmpty())
+	{
+		writeStatistics();
+	}
+
+	ProcessThread::releaseSourceImages();
+
+	quint64 spawnCount; qint64 spawnWaitTotal, spawnWaitMax;
+	AbstractTool::spawnStatistics(spawnCount, spawnWaitTotal, spawnWaitMax);
+	if(spawnCount > 0)
+	{
+		double spawnWaitP50, spawnWaitP95, spawnWaitP99;
+		AbstractTool::spawnPercentiles(spawnWaitP50, spawnWaitP95, spawnWaitP99);
+		m_progressModel->addSystemMessage(tr("Started %1 processes, waiting %2 ms on average (maximum %3 ms) for a spawn slot.").arg(QString::number(spawnCount), QString::number(spawnWaitTotal / static_cast<qint64>(spawnCount)), QString::number(spawnWaitMax)), ProgressModel::SysMsg_Performance);
+		m_progressModel->addSystemMessage(tr("Spawn slot wait time percentiles: p50 = %1 ms, p95 = %2 ms, p99 = %3 ms.").arg(QString::number(spawnWaitP50, 'f', 1), QString::number(spawnWaitP95, 'f', 1), QString::number(spawnWaitP99, 'f', 1)), ProgressModel::SysMsg_Performance);
+	}
+
+	m_progressModel->addSystemMessage(tr("Job logs: The log buffers peaked at %1 KB, %2 KB have been moved to the temporary folder.").arg(QString::number((m_progressModel->getLogBufferPeak() + 1023ui64) / 1024ui64), QString::number((m_progressModel->getLogSpilledBytes() + 1023ui64) / 1024ui64)), ProgressModel::SysMsg_Performance);
+
+	quint64 workingSet, peakWorkingSet;
+	if(RAMObserverThread::processMemory(workingSet, peakWorkingSet))
+	{
+		m_progressModel->addSystemMessage(tr("Process memory: The working set is %1 MB, its peak since start-up was %2 MB.").arg(QString::number(workingSet / 1048576ui64), QString::number(peakWorkingSet / 1048576ui64)), ProgressModel::SysMsg_Performance);
+	}
 	
 	if(m_userAborted)
 	{
@@ -782,6 +867,15 @@ void ProcessingDialog::doneEncoding(void)
 
 void ProcessingDialog::processFinished(const QUuid &jobId, const QString &outFileName, int success)
 {
+	//Deliver the final status and log of the job
+	m_mailbox->retire(jobId, m_progressModel.data());
+
+	//The job cost has been learned from the statistics already, which are delivered first (if any)
+	if(!m_jobCost.isNull())
+	{
+		m_jobCost->jobDiscarded(jobId);
+	}
+
 	if(success > 0)
 	{
 		m_playList.insert(jobId, outFileName);
@@ -796,30 +890,63 @@ void ProcessingDialog::processFinished(const QUuid &jobId, const QString &outFil
 	{
 		m_failedJobs.append(jobId);
 	}
+}
 
-	//Update filter as soon as a job finished!
-	if(m_progressViewFilter >= 0)
+void ProcessingDialog::drainMailbox(void)
+{
+	m_mailbox->drain(m_progressModel.data());
+}
+
+void ProcessingDialog::processStatistics(const QUuid &jobId, const JobStatistics &statistics)
+{
+	m_jobStatistics.insert(jobId, statistics);
+
+	if(!m_jobCost.isNull())
 	{
-		QTimer::singleShot(0, this, SLOT(progressViewFilterChanged()));
+		m_jobCost->jobFinished(jobId, statistics);
 	}
 }
 
 void ProcessingDialog::progressModelChanged(void)
 {
-	//Update filter as soon as the model changes!
+	//Hidden rows move along with the removed rows, so only the info label needs to be updated
+	updateFilterInfo();
+	QTimer::singleShot(0, ui->view_log, SLOT(scrollToBottom()));
+}
+
+void ProcessingDialog::progressModelReset(void)
+{
+	QTimer::singleShot(0, this, SLOT(progressViewFilterChanged()));
+	QTimer::singleShot(0, ui->view_log, SLOT(scrollToBottom()));
+}
+
+void ProcessingDialog::progressModelRowsInserted(const QModelIndex& /*parent*/, int first, int last)
+{
+	//Only the new rows need to be filtered
 	if(m_progressViewFilter >= 0)
 	{
-		QTimer::singleShot(0, this, SLOT(progressViewFilterChanged()));
+		filterRows(first, last);
+		updateFilterInfo();
 	}
 
 	QTimer::singleShot(0, ui->view_log, SLOT(scrollToBottom()));
 }
 
+void ProcessingDialog::progressModelDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+	//Only the changed rows need to be filtered, e.g. when a job has finished
+	if(m_progressViewFilter >= 0)
+	{
+		filterRows(topLeft.row(), bottomRight.row());
+		updateFilterInfo();
+	}
+}
+
 void ProcessingDialog::logViewDoubleClicked(const QModelIndex &index)
 {
 	if(m_runningThreads == 0)
 	{
-		const QStringList &logFile = m_progressModel->getLogFile(index);
+		const QStringList logFile = m_progressModel->getLogFile(index);
 		
 		if(!logFile.isEmpty())
 		{
@@ -923,16 +1050,31 @@ void ProcessingDialog::contextMenuFilterActionTriggered(void)
  */
 void ProcessingDialog::progressViewFilterChanged(void)
 {
-	bool matchFound = false;
+	filterRows(0, m_progressModel->rowCount() - 1);
+	updateFilterInfo();
+}
 
-	for(int i = 0; i < ui->view_log->model()->rowCount(); i++)
+////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////
+
+void ProcessingDialog::filterRows(const int first, const int last)
+{
+	for(int i = qMax(0, first); i <= last; i++)
 	{
-		QModelIndex index = (m_progressViewFilter >= 0) ? m_progressModel->index(i, 0) : QModelIndex();
-		const bool bHide = index.isValid() ? (m_progressModel->getJobState(index) != m_progressViewFilter) : false;
-		ui->view_log->setRowHidden(i, bHide); matchFound = matchFound || (!bHide);
+		const bool bHide = (m_progressViewFilter >= 0) ? (m_progressModel->getJobState(m_progressModel->index(i, 0)) != m_progressViewFilter) : false;
+		if(ui->view_log->isRowHidden(i) != bHide)
+		{
+			ui->view_log->setRowHidden(i, bHide);
+		}
 	}
+}
+
+void ProcessingDialog::updateFilterInfo(void)
+{
+	const bool matchFound = (m_progressViewFilter < 0) || (m_progressModel->getJobCount(static_cast<ProgressModel::JobState>(m_progressViewFilter)) > 0);
 
-	if((m_progressViewFilter >= 0) && (!matchFound))
+	if(!matchFound)
 	{
 		if(m_filterInfoLabel->isHidden() || (dynamic_cast<IntUserData*>(m_filterInfoLabel->userData(0))->value() != m_progressViewFilter))
 		{
@@ -951,24 +1093,168 @@ void ProcessingDialog::progressViewFilterChanged(void)
 	}
 }
 
-////////////////////////////////////////////////////////////
-// Private Functions
-////////////////////////////////////////////////////////////
-
 QThreadPool *ProcessingDialog::createThreadPool(void)
 {
-	quint32 maximumInstances = qBound(0U, m_settings->maximumInstances(), MAX_INSTANCES);
+	const quint32 userInstances = qBound(0U, m_settings->maximumInstances(), MAX_INSTANCES);
+	quint32 maximumInstances = userInstances, instanceLimit = userInstances;
 	if (maximumInstances < 1U)
 	{
 		const MUtils::CPUFetaures::cpu_info_t cpuFeatures = MUtils::CPUFetaures::detect();
 		const quint32 nProcessors = qBound(1U, cpuFeatures.count, MAX_INSTANCES);
 		maximumInstances = isFastSeekingDevice(m_tempFolder) ? nProcessors : cores2instances(nProcessors);
+		instanceLimit = nProcessors;
 	}
 	QThreadPool *const threadPool = new QThreadPool();
 	threadPool->setMaxThreadCount(qBound(1U, maximumInstances, static_cast<unsigned int>(m_pendingJobs.count())));
+
+	//The adaptive controller never exceeds the user's choice, or the number of processors
+	if (m_settings->adaptiveInstancesEnabled())
+	{
+		m_concurrency.reset(new ConcurrencyController(threadPool->maxThreadCount(), qBound(1U, instanceLimit, static_cast<unsigned int>(m_pendingJobs.count()))));
+	}
 	return threadPool;
 }
 
+/*
+ * Start the pending jobs "longest processing time first", so that a single long file at the end of the list
+ * does not keep one instance busy long after all the other files have been completed
+ */
+void ProcessingDialog::sortPendingJobs(void)
+{
+	const int jobCount = m_pendingJobs.count();
+	const unsigned int threadCount = m_threadPool.isNull() ? 1U : qMax(1, m_threadPool->maxThreadCount());
+	if((jobCount < 2) || (threadCount < 2U))
+	{
+		return;
+	}
+
+	//Files with unknown duration are assumed to have the average duration
+	quint64 durationSum = 0U, durationCount = 0U;
+	for(int i = 0; i < jobCount; i++)
+	{
+		if(const unsigned int duration = m_pendingJobs.at(i).second.techInfo().duration())
+		{
+			durationSum += duration;
+			durationCount++;
+		}
+	}
+	const double averageDuration = (durationCount > 0U) ? (static_cast<double>(durationSum) / static_cast<double>(durationCount)) : 0.0;
+
+	//Estimate the cost of each job
+	QVector<double> costs(jobCount);
+	QVector<int> order(jobCount);
+	for(int i = 0; i < jobCount; i++)
+	{
+		const AudioFileModel &audioFile = m_pendingJobs.at(i).second;
+		const unsigned int duration = audioFile.techInfo().duration();
+		costs[i] = m_jobCost->estimate((duration > 0U) ? static_cast<double>(duration) : averageDuration, needsDecoding(audioFile), countFilters(audioFile));
+		order[i] = i;
+	}
+
+	//Sort by descending cost, jobs of equal cost remain in the original order
+	qStableSort(order.begin(), order.end(), [&costs](const int &a, const int &b) { return costs[a] > costs[b]; });
+
+	QVector<double> sortedCosts(jobCount);
+	QList<QPair<unsigned int, AudioFileModel>> sortedJobs;
+	for(int i = 0; i < jobCount; i++)
+	{
+		sortedCosts[i] = costs[order[i]];
+		sortedJobs.append(m_pendingJobs.at(order[i]));
+	}
+	m_pendingJobs.swap(sortedJobs);
+
+	//Report the estimated improvement
+	const double makespanOriginal = JobCostModel::makespan(costs, threadCount);
+	const double makespanSorted = JobCostModel::makespan(sortedCosts, threadCount);
+	qDebug("Job ordering: Estimated makespan %.1f sec -> %.1f sec", makespanOriginal, makespanSorted);
+	if((makespanSorted > 0.0) && (makespanSorted < makespanOriginal))
+	{
+		m_progressModel->addSystemMessage(tr("Job ordering: Estimated total time reduced from %1 to %2 (%3% faster).").arg(time2text(qRound64(makespanOriginal * 1000.0)), time2text(qRound64(makespanSorted * 1000.0)), QString::number(qRound(100.0 * (1.0 - (makespanSorted / makespanOriginal))))), ProgressModel::SysMsg_Performance);
+	}
+}
+
+unsigned int ProcessingDialog::countFilters(const AudioFileModel &audioFile) const
+{
+	unsigned int filterCount = 0U;
+	if(m_settings->forceStereoDownmix())
+	{
+		filterCount++;
+	}
+	if(m_settings->samplingRate() > 0)
+	{
+		const int targetRate = SettingsModel::samplingRates[qBound(1, m_settings->samplingRate(), 6)];
+		if((targetRate != static_cast<int>(audioFile.techInfo().audioSamplerate())) || (audioFile.techInfo().audioSamplerate() == 0))
+		{
+			if(!EncoderRegistry::getEncoderInfo(m_settings->compressionEncoder())->isResamplingSupported()) filterCount++;
+		}
+	}
+	if((m_settings->toneAdjustBass() != 0) || (m_settings->toneAdjustTreble() != 0))
+	{
+		filterCount++;
+	}
+	if(m_settings->normalizationFilterEnabled())
+	{
+		filterCount++;
+	}
+	return filterCount;
+}
+
+void ProcessingDialog::adjustConcurrency(void)
+{
+	if(m_threadPool.isNull() || m_userAborted || (m_initThreads > 0))
+	{
+		return;
+	}
+
+	const ConcurrencyController::Decision decision = m_concurrency->update(!m_pendingJobs.isEmpty());
+	if(decision == ConcurrencyController::Decision_None)
+	{
+		return;
+	}
+
+	const int previousInstances = m_stages.isNull() ? m_threadPool->maxThreadCount() : static_cast<int>(m_stages->instances());
+	const int currentInstances = static_cast<int>(m_concurrency->instances());
+	if(currentInstances == previousInstances)
+	{
+		return;
+	}
+
+	QString reason;
+	switch(decision)
+	{
+	case ConcurrencyController::Decision_CpuIdle:
+		reason = tr("CPU usage is at %1%").arg(QString::number(qRound(m_concurrency->cpuUsage() * 100.0)));
+		break;
+	case ConcurrencyController::Decision_MemoryPressure:
+		reason = tr("memory usage is at %1%").arg(QString::number(qRound(m_concurrency->memoryLoad() * 100.0)));
+		break;
+	case ConcurrencyController::Decision_LowDiskSpace:
+		reason = tr("only %1 MB of temporary disk space left").arg(QString::number(m_concurrency->freeSpace() / 1048576ui64));
+		break;
+	case ConcurrencyController::Decision_DiskBusy:
+		reason = tr("the temporary disk throughput dropped to %1 MB/s").arg(QString::number(m_concurrency->throughput() / 1048576.0, 'f', 1));
+		break;
+	}
+
+	if(!m_stages.isNull())
+	{
+		m_stages->setInstances(currentInstances);
+		m_threadPool->setMaxThreadCount(currentInstances + static_cast<int>(m_stages->lookAhead()));
+	}
+	else
+	{
+		m_threadPool->setMaxThreadCount(currentInstances);
+	}
+	m_progressModel->addSystemMessage(tr("Adjusting the number of parallel instances from %1 to %2, because %3.").arg(QString::number(previousInstances), QString::number(currentInstances), reason), ProgressModel::SysMsg_Performance);
+
+	//Start additional jobs, if the number of instances has been raised
+	const int additionalJobs = qMin(m_threadPool->maxThreadCount() - static_cast<int>(m_runningThreads), m_pendingJobs.count());
+	for(int i = 0; i < additionalJobs; i++)
+	{
+		QTimer::singleShot(25 * (i + 1), this, SLOT(startNextJob()));
+	}
+}
+
 void ProcessingDialog::writePlayList(void)
 {
 	if(m_succeededJobs.count() <= 0 || m_allJobs.count() <= 0)
@@ -997,10 +1283,11 @@ void ProcessingDialog::writePlayList(void)
 	playListName = MUtils::clean_file_name(playListName, true);
 
 	//Create list of audio files
-	for(int i = 0; i < m_allJobs.count(); i++)
+	const QSet<QUuid> succeededJobs = m_succeededJobs.toSet();
+	for(QMap<unsigned int, QUuid>::ConstIterator iter = m_allJobs.constBegin(); iter != m_allJobs.constEnd(); iter++)
 	{
-		if(!m_succeededJobs.contains(m_allJobs.at(i))) continue;
-		list << QDir::toNativeSeparators(QDir(m_settings->outputDir()).relativeFilePath(m_playList.value(m_allJobs.at(i), "N/A")));
+		if(!succeededJobs.contains(iter.value())) continue;
+		list << QDir::toNativeSeparators(QDir(m_settings->outputDir()).relativeFilePath(m_playList.value(iter.value(), "N/A")));
 	}
 
 	//Use prefix?
@@ -1054,6 +1341,51 @@ void ProcessingDialog::writePlayList(void)
 	}
 }
 
+void ProcessingDialog::writeStatistics(void)
+{
+	QList<JobStatistics> statistics;
+	quint64 totalDuration = 0;
+	qint64 totalQueueWait = 0;
+
+	//Collect statistics in the original order of the file list
+	for(QMap<unsigned int, QUuid>::ConstIterator iter = m_allJobs.constBegin(); iter != m_allJobs.constEnd(); iter++)
+	{
+		if(m_jobStatistics.contains(iter.value()))
+		{
+			const JobStatistics &jobStatistics = m_jobStatistics[iter.value()];
+			if(jobStatistics.result() > 0)
+			{
+				totalDuration += jobStatistics.duration();
+			}
+			totalQueueWait += jobStatistics.queueWait();
+			statistics << jobStatistics;
+		}
+	}
+
+	if((!m_totalTime.isNull()) && m_totalTime->isValid() && (m_totalTime->elapsed() > 0))
+	{
+		const double realtimeFactor = static_cast<double>(totalDuration) / (static_cast<double>(m_totalTime->elapsed()) / 1000.0);
+		m_progressModel->addSystemMessage(tr("Throughput: %1 of audio processed at %2x realtime, total queue wait was %3.").arg(time2text(static_cast<qint64>(totalDuration) * 1000), QString().sprintf("%.1f", realtimeFactor), time2text(totalQueueWait)), ProgressModel::SysMsg_Performance);
+	}
+
+	if(statistics.isEmpty() || (!m_settings->statisticsExportEnabled()))
+	{
+		return;
+	}
+
+	//Write the statistics next to the output files
+	const QString outputDir = m_settings->outputToSourceDir() ? QFileInfo(statistics.first().outputFile()).absolutePath() : m_settings->outputDir();
+	const QString baseName = QString("%1/LameXP_Statistics_%2").arg(outputDir, QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss"));
+	if(JobStatistics::exportBatch(statistics, baseName))
+	{
+		m_progressModel->addSystemMessage(tr("Job statistics have been saved to: %1").arg(QDir::toNativeSeparators(baseName + ".{csv,json}")), ProgressModel::SysMsg_Info);
+	}
+	else
+	{
+		m_progressModel->addSystemMessage(tr("Failed to save the job statistics to: %1").arg(QDir::toNativeSeparators(baseName + ".{csv,json}")), ProgressModel::SysMsg_Warning);
+	}
+}
+
 void ProcessingDialog::updateMetaInfo(AudioFileModel &audioFile)
 {
 	if(!m_settings->writeMetaTags())
@@ -1083,6 +1415,12 @@ void ProcessingDialog::cpuUsageHasChanged(const double val)
 	
 	ui->label_cpu->setText(QString().sprintf(" %d%%", qRound(val * 100.0)));
 	UPDATE_MIN_WIDTH(ui->label_cpu);
+
+	if(!m_concurrency.isNull())
+	{
+		m_concurrency->setCpuUsage(val);
+		adjustConcurrency();
+	}
 }
 
 void ProcessingDialog::ramUsageHasChanged(const double val)
@@ -1090,10 +1428,20 @@ void ProcessingDialog::ramUsageHasChanged(const double val)
 	
 	ui->label_ram->setText(QString().sprintf(" %d%%", qRound(val * 100.0)));
 	UPDATE_MIN_WIDTH(ui->label_ram);
+
+	if(!m_concurrency.isNull())
+	{
+		m_concurrency->setMemoryLoad(val);
+	}
 }
 
 void ProcessingDialog::diskUsageHasChanged(const quint64 val)
 {
+	if(!m_concurrency.isNull())
+	{
+		m_concurrency->setFreeSpace(val);
+	}
+
 	int postfix = 0;
 	const char *postfixStr[6] = {"B", "KB", "MB", "GB", "TB", "PB"};
 	double space = static_cast<double>(val);
@@ -1108,6 +1456,14 @@ void ProcessingDialog::diskUsageHasChanged(const quint64 val)
 	UPDATE_MIN_WIDTH(ui->label_disk);
 }
 
+void ProcessingDialog::diskThroughputHasChanged(const double val)
+{
+	if(!m_concurrency.isNull())
+	{
+		m_concurrency->setThroughput(val);
+	}
+}
+
 bool ProcessingDialog::shutdownComputer(void)
 {
 	const int iTimeout = m_settings->hibernateComputer() ? 10 : 30;
@@ -1203,6 +1559,12 @@ quint32 ProcessingDialog::cores2instances(const quint32 &cores)
 	return static_cast<quint32>(qRound(y));
 }
 
+bool ProcessingDialog::needsDecoding(const AudioFileModel &audioFile)
+{
+	const AudioFileModel_TechInfo &techInfo = audioFile.techInfo();
+	return (techInfo.containerType().compare("Wave", Qt::CaseInsensitive) != 0) || (techInfo.audioType().compare("PCM", Qt::CaseInsensitive) != 0);
+}
+
 QString ProcessingDialog::time2text(const qint64 &msec)
 {
 	const qint64 MILLISECONDS_PER_DAY = 86399999;	//24x60x60x1000 - 1
@@ -26,13 +26,19 @@
 #include <QUuid>
 #include <QSystemTrayIcon>
 #include <QMap>
+#include <QHash>
 
 class AbstractEncoder;
 class AudioFileModel;
 class AudioFileModel_MetaInfo;
+class ConcurrencyController;
 class CPUObserverThread;
 class DiskObserverThread;
 class FileListModel;
+class JobStatistics;
+class JobCostModel;
+class ProcessMailbox;
+class ProcessStages;
 class ProcessThread;
 class ProgressModel;
 class QActionGroup;
@@ -41,6 +47,7 @@ class QMenu;
 class QModelIndex;
 class QMovie;
 class QThreadPool;
+class QTimer;
 class QElapsedTimer;
 class RAMObserverThread;
 class SettingsModel;
@@ -84,7 +91,11 @@ private slots:
 	void doneEncoding(void);
 	void abortEncoding(bool force = false);
 	void processFinished(const QUuid &jobId, const QString &outFileName, int success);
+	void processStatistics(const QUuid &jobId, const JobStatistics &statistics);
 	void progressModelChanged(void);
+	void progressModelReset(void);
+	void progressModelRowsInserted(const QModelIndex &parent, int first, int last);
+	void progressModelDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
 	void logViewDoubleClicked(const QModelIndex &index);
 	void logViewSectionSizeChanged(int, int, int);
 	void contextMenuTriggered(const QPoint &pos);
@@ -95,7 +106,9 @@ private slots:
 	void cpuUsageHasChanged(const double val);
 	void ramUsageHasChanged(const double val);
 	void diskUsageHasChanged(const quint64 val);
+	void diskThroughputHasChanged(const double val);
 	void progressViewFilterChanged(void);
+	void drainMailbox(void);
 
 signals:
 	void abortRunningTasks(void);
@@ -111,18 +124,25 @@ private:
 	Ui::ProcessingDialog *ui; //for Qt UIC
 
 	QThreadPool *createThreadPool(void);
+	void filterRows(const int first, const int last);
+	void updateFilterInfo(void);
+	void sortPendingJobs(void);
+	void adjustConcurrency(void);
+	unsigned int countFilters(const AudioFileModel &audioFile) const;
 	void updateMetaInfo(AudioFileModel &audioFile);
 	void writePlayList(void);
+	void writeStatistics(void);
 	bool shutdownComputer(void);
 	
 	QScopedPointer<QThreadPool> m_threadPool;
-	QList<AudioFileModel> m_pendingJobs;
+	QList<QPair<unsigned int, AudioFileModel>> m_pendingJobs;
 	const SettingsModel *const m_settings;
 	const AudioFileModel_MetaInfo *const m_metaInfo;
 	const QString m_tempFolder;
 	QScopedPointer<QMovie> m_progressIndicator;
 	QScopedPointer<ProgressModel> m_progressModel;
 	QMap<QUuid,QString> m_playList;
+	QHash<QUuid, JobStatistics> m_jobStatistics;
 	QScopedPointer<QMenu> m_contextMenu;
 	QScopedPointer<QActionGroup> m_progressViewFilterGroup;
 	QScopedPointer<QLabel> m_filterInfoLabel;
@@ -130,7 +150,7 @@ private:
 	unsigned int m_initThreads;
 	unsigned int m_runningThreads;
 	unsigned int m_currentFile;
-	QList<QUuid> m_allJobs;
+	QMap<unsigned int, QUuid> m_allJobs;
 	QList<QUuid> m_succeededJobs;
 	QList<QUuid> m_failedJobs;
 	QList<QUuid> m_skippedJobs;
@@ -146,6 +166,11 @@ private:
 	int m_progressViewFilter;
 	QScopedPointer<QColor> m_defaultColor;
 	QScopedPointer<FileExtsModel> m_fileExts;
+	QScopedPointer<JobCostModel> m_jobCost;
+	QScopedPointer<ConcurrencyController> m_concurrency;
+	QScopedPointer<ProcessStages> m_stages;
+	QScopedPointer<ProcessMailbox> m_mailbox;
+	QScopedPointer<QTimer> m_mailboxTimer;
 	QScopedPointer<MUtils::Taskbar7> m_taskbar;
 	QScopedPointer<QIcon> m_iconRunning;
 	QScopedPointer<QIcon> m_iconError;
@@ -155,4 +180,5 @@ private:
 	static bool isFastSeekingDevice(const QString &path);
 	static quint32 cores2instances(const quint32 &cores);
 	static QString time2text(const qint64 &msec);
+	static bool needsDecoding(const AudioFileModel &audioFile);
 };
@@ -108,6 +108,12 @@ const bool AbstractEncoder::needsTimingInfo(void)
 	return false;
 }
 
+//Does the encoder accept a Wave stream from stdin? (source file will be "-")
+const bool AbstractEncoder::supportsPipeInput(void)
+{
+	return false;
+}
+
 
 /*
  * Helper functions
@@ -72,6 +72,7 @@ public:
 	virtual const unsigned int *supportedChannelCount(void);
 	virtual const unsigned int *supportedBitdepths(void);
 	virtual const bool needsTimingInfo(void);
+	virtual const bool supportsPipeInput(void);
 
 	//Common setter methods
 	virtual void setBitrate(const int &bitrate);
@@ -23,6 +23,7 @@
 #include "Encoder_DCA.h"
 
 #include "Global.h"
+#include "Tool_ProgressMatcher.h"
 #include "Model_Settings.h"
 
 #include <QProcess>
@@ -155,26 +156,7 @@ bool DCAEncoder::encode(const QString &sourceFile, const AudioFileModel_MetaInfo
 		return false;
 	}
 
-	int prevProgress = -1;
-	QRegExp regExp(L1S("\\[(\\d+)\\.(\\d+)%\\]"));
-
-	const result_t result = awaitProcess(process, abortFlag, [this, &prevProgress, &regExp](const QString &text)
-	{
-		if (regExp.lastIndexIn(text) >= 0)
-		{
-			qint32 newProgress;
-			if (MUtils::regexp_parse_int32(regExp, newProgress))
-			{
-				if (newProgress > prevProgress)
-				{
-					emit statusUpdated(newProgress);
-					prevProgress = NEXT_PROGRESS(newProgress);
-				}
-			}
-			return true;
-		}
-		return false;
-	});
+	const result_t result = awaitProcess(process, abortFlag, ProgressMatcher("[", "]"));
 	
 	return (result == RESULT_SUCCESS);
 }
@@ -23,6 +23,7 @@
 #include "Encoder_FLAC.h"
 
 #include "Global.h"
+#include "Tool_ProgressMatcher.h"
 #include "Model_Settings.h"
 
 #include <QProcess>
@@ -156,6 +157,8 @@ bool FLACEncoder::encode(const QString &sourceFile, const AudioFileModel_MetaInf
 
 	if(!m_configCustomParams.isEmpty()) args << m_configCustomParams.split(" ", QString::SkipEmptyParts);
 
+	if(sourceFile == L1S("-")) args << L1S("--ignore-chunk-sizes");
+
 	args << L1S("-f") << L1S("-o") << QDir::toNativeSeparators(outputFile);
 	args << QDir::toNativeSeparators(sourceFile);
 
@@ -164,26 +167,7 @@ bool FLACEncoder::encode(const QString &sourceFile, const AudioFileModel_MetaInf
 		return false;
 	}
 
-	int prevProgress = -1;
-	QRegExp regExp(L1S("\\b(\\d+)% complete"));
-
-	const result_t result = awaitProcess(process, abortFlag, [this, &prevProgress, &regExp](const QString &text)
-	{
-		if (regExp.lastIndexIn(text) >= 0)
-		{
-			qint32 newProgress;
-			if (MUtils::regexp_parse_int32(regExp, newProgress))
-			{
-				if (newProgress > prevProgress)
-				{
-					emit statusUpdated(newProgress);
-					prevProgress = NEXT_PROGRESS(newProgress);
-				}
-			}
-			return true;
-		}
-		return false;
-	});
+	const result_t result = awaitProcess(process, abortFlag, ProgressMatcher("", " complete"));
 
 	return (result == RESULT_SUCCESS);
 }
@@ -213,6 +197,11 @@ const unsigned int *FLACEncoder::supportedBitdepths(void)
 	return supportedBPS;
 }
 
+const bool FLACEncoder::supportsPipeInput(void)
+{
+	return true;
+}
+
 const AbstractEncoderInfo *FLACEncoder::getEncoderInfo(void)
 {
 	return &g_flacEncoderInfo;
@@ -23,6 +23,7 @@
 #include "Encoder_MP3.h"
 
 #include "Global.h"
+#include "Tool_ProgressMatcher.h"
 #include "Model_Settings.h"
 
 #include <QProcess>
@@ -244,26 +245,7 @@ bool MP3Encoder::encode(const QString &sourceFile, const AudioFileModel_MetaInfo
 		return false;
 	}
 
-	int prevProgress = -1;
-	QRegExp regExp(L1S("\\(.*(\\d+)%\\)\\|"));
-
-	const result_t result = awaitProcess(process, abortFlag, [this, &prevProgress, &regExp](const QString &text)
-	{
-		if (regExp.lastIndexIn(text) >= 0)
-		{
-			qint32 newProgress;
-			if (MUtils::regexp_parse_int32(regExp, newProgress))
-			{
-				if (newProgress > prevProgress)
-				{
-					emit statusUpdated(newProgress);
-					prevProgress = NEXT_PROGRESS(newProgress);
-				}
-			}
-			return true;
-		}
-		return false;
-	});
+	const result_t result = awaitProcess(process, abortFlag, ProgressMatcher("(", ")|"));
 
 	return (result == RESULT_SUCCESS);
 }
@@ -304,6 +286,11 @@ const unsigned int *MP3Encoder::supportedChannelCount(void)
 	return supportedChannels;
 }
 
+const bool MP3Encoder::supportsPipeInput(void)
+{
+	return true;
+}
+
 void MP3Encoder::setAlgoQuality(int value)
 {
 	m_algorithmQuality = qBound(0, value, 3);
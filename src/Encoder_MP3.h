@@ -38,6 +38,7 @@ public:
 	virtual bool encode(const QString &sourceFile, const AudioFileModel_MetaInfo &metaInfo, const unsigned int duration, const unsigned int channels, const QString &outputFile, QAtomicInt &abortFlag);
 	virtual bool isFormatSupported(const QString &containerType, const QString &containerProfile, const QString &formatType, const QString &formatProfile, const QString &formatVersion);
 	virtual const unsigned int *supportedChannelCount(void);
+	virtual const bool supportsPipeInput(void);
 	
 	//Advanced options
 	virtual void setAlgoQuality(int value);
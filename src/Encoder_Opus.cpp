@@ -27,6 +27,7 @@
 
 //Internal
 #include "Global.h"
+#include "Tool_ProgressMatcher.h"
 #include "Model_Settings.h"
 #include "MimeTypes.h"
 
@@ -199,6 +200,7 @@ bool OpusEncoder::encode(const QString &sourceFile, const AudioFileModel_MetaInf
 	if(!metaInfo.cover().isEmpty())   args << L1S("--picture") << makeCoverParam(metaInfo.cover());
 
 	if(!m_configCustomParams.isEmpty()) args << m_configCustomParams.split(" ", QString::SkipEmptyParts);
+	if(sourceFile == L1S("-"))          args << L1S("--ignorelength");
 
 	args << QDir::toNativeSeparators(sourceFile);
 	args << QDir::toNativeSeparators(outputFile);
@@ -208,26 +210,7 @@ bool OpusEncoder::encode(const QString &sourceFile, const AudioFileModel_MetaInf
 		return false;
 	}
 
-	int prevProgress = -1;
-	QRegExp regExp(L1S("\\[.\\]\\s+(\\d+)%"));
-
-	const result_t result = awaitProcess(process, abortFlag, [this, &prevProgress, &regExp](const QString &text)
-	{
-		if (regExp.lastIndexIn(text) >= 0)
-		{
-			qint32 newProgress;
-			if (MUtils::regexp_parse_int32(regExp, newProgress))
-			{
-				if (newProgress > prevProgress)
-				{
-					emit statusUpdated(newProgress);
-					prevProgress = NEXT_PROGRESS(newProgress);
-				}
-			}
-			return true;
-		}
-		return false;
-	});
+	const result_t result = awaitProcess(process, abortFlag, ProgressMatcher("]"));
 	
 	return (result == RESULT_SUCCESS);
 }
@@ -299,6 +282,11 @@ const bool OpusEncoder::needsTimingInfo(void)
 	return true;
 }
 
+const bool OpusEncoder::supportsPipeInput(void)
+{
+	return true;
+}
+
 const AbstractEncoderInfo *OpusEncoder::getEncoderInfo(void)
 {
 	return &g_opusEncoderInfo;
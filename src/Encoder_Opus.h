@@ -39,6 +39,7 @@ public:
 	virtual const unsigned int *supportedChannelCount(void);
 	virtual const unsigned int *supportedBitdepths(void);
 	virtual const bool needsTimingInfo(void);
+	virtual const bool supportsPipeInput(void);
 
 	//Advanced options
 	virtual void setOptimizeFor(int optimizeFor);
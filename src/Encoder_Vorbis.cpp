@@ -188,6 +188,8 @@ bool VorbisEncoder::encode(const QString &sourceFile, const AudioFileModel_MetaI
 
 	if(!m_configCustomParams.isEmpty()) args << m_configCustomParams.split(" ", QString::SkipEmptyParts);
 
+	if(sourceFile == L1S("-")) args << L1S("--ignorelength");
+
 	args << L1S("-o") << QDir::toNativeSeparators(outputFile);
 	args << QDir::toNativeSeparators(sourceFile);
 
@@ -240,6 +242,11 @@ bool VorbisEncoder::isFormatSupported(const QString &containerType, const QStrin
 	return false;
 }
 
+const bool VorbisEncoder::supportsPipeInput(void)
+{
+	return true;
+}
+
 void VorbisEncoder::setBitrateLimits(int minimumBitrate, int maximumBitrate)
 {
 	m_configBitrateMinimum = minimumBitrate;
@@ -23,9 +23,40 @@
 #include "Filter_Abstract.h"
 
 AbstractFilter::AbstractFilter(void)
+:
+	m_ignoreInputLength(false)
 {
 }
 
 AbstractFilter::~AbstractFilter(void)
 {
 }
+
+/*
+ * Default implementation
+ */
+
+AbstractFilter::FilterResult AbstractFilter::pipeCommand(QString& /*program*/, QStringList& /*args*/, AudioFileModel_TechInfo *const /*formatInfo*/)
+{
+	return FILTER_FAILURE; /*filter does not support streaming from stdin to stdout*/
+}
+
+bool AbstractFilter::supportsPipe(void) const
+{
+	return false;
+}
+
+AbstractFilter::SoxEffectClass AbstractFilter::soxEffectClass(void) const
+{
+	return SOX_EFFECT_NONE; /*filter is not based on SoX*/
+}
+
+AbstractFilter::FilterResult AbstractFilter::soxEffects(QStringList& /*effects*/, AudioFileModel_TechInfo *const /*formatInfo*/)
+{
+	return FILTER_FAILURE;
+}
+
+void AbstractFilter::soxDitherEffects(QStringList& /*effects*/) const
+{
+	/*filter does not require dithering*/
+}
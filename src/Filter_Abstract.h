@@ -42,7 +42,30 @@ public:
 		FILTER_FAILURE = 2
 	};
 
+	//SoX effect classes, in the order they are applied within a combined chain
+	enum SoxEffectClass
+	{
+		SOX_EFFECT_NONE  = -1,
+		SOX_EFFECT_REMIX =  0,
+		SOX_EFFECT_TONE  =  1,
+		SOX_EFFECT_RATE  =  2,
+		SOX_EFFECT_GAIN  =  3
+	};
+
 	//Internal decoder API
 	virtual FilterResult apply(const QString &sourceFile, const QString &outputFile, AudioFileModel_TechInfo *const formatInfo, QAtomicInt &abortFlag) = 0;
+	virtual FilterResult pipeCommand(QString &program, QStringList &args, AudioFileModel_TechInfo *const formatInfo);
+	virtual bool supportsPipe(void) const;
+
+	//SoX effects API (allows combining filters into a single SoX invocation)
+	virtual SoxEffectClass soxEffectClass(void) const;
+	virtual FilterResult soxEffects(QStringList &effects, AudioFileModel_TechInfo *const formatInfo);
+	virtual void soxDitherEffects(QStringList &effects) const;
+
+	//Large file support (input is a RIFF file with an overflowed length)
+	void setIgnoreInputLength(const bool &ignoreLength) { m_ignoreInputLength = ignoreLength; }
+
+protected:
+	bool m_ignoreInputLength;
 };
 
@@ -24,6 +24,7 @@
 
 //Internal
 #include "Global.h"
+#include "Tool_ProgressMatcher.h"
 #include "Tool_WaveProperties.h"
 #include "Model_AudioFile.h"
 
@@ -33,7 +34,6 @@
 //Qt
 #include <QDir>
 #include <QProcess>
-#include <QRegExp>
 
 #define IS_VALID(X) (((X) != 0U) && ((X) != UINT_MAX))
 
@@ -68,9 +68,76 @@ AbstractFilter::FilterResult DownmixFilter::apply(const QString &sourceFile, con
 
 	args << "-V3" << "-S";
 	args << "--guard" << "--temp" << ".";
+	if(m_ignoreInputLength)
+	{
+		args << "--ignore-length";
+	}
 	args << QDir::toNativeSeparators(sourceFile);
 	args << QDir::toNativeSeparators(outputFile);
 
+	appendEffects(args, channels);
+
+	if(!startProcess(process, m_binary, args, QFileInfo(outputFile).canonicalPath()))
+	{
+		return AbstractFilter::FILTER_FAILURE;
+	}
+
+	const result_t result = awaitProcess(process, abortFlag, ProgressMatcher("In:"));
+
+	if (result != RESULT_SUCCESS)
+	{
+		return AbstractFilter::FILTER_FAILURE;
+	}
+	
+	formatInfo->setAudioChannels(2);
+	return AbstractFilter::FILTER_SUCCESS;
+}
+
+AbstractFilter::FilterResult DownmixFilter::pipeCommand(QString &program, QStringList &args, AudioFileModel_TechInfo *const formatInfo)
+{
+	QStringList effects;
+	const FilterResult result = soxEffects(effects, formatInfo);
+
+	if(result == AbstractFilter::FILTER_SUCCESS)
+	{
+		args << "-V2";
+		args << "--guard" << "--temp" << ".";
+		args << "-t" << "wav" << "-";
+		args << "-t" << "wav" << "-";
+		args << effects;
+		program = m_binary;
+	}
+
+	return result;
+}
+
+bool DownmixFilter::supportsPipe(void) const
+{
+	return true;
+}
+
+AbstractFilter::SoxEffectClass DownmixFilter::soxEffectClass(void) const
+{
+	return AbstractFilter::SOX_EFFECT_REMIX;
+}
+
+AbstractFilter::FilterResult DownmixFilter::soxEffects(QStringList &effects, AudioFileModel_TechInfo *const formatInfo)
+{
+	const unsigned int channels = formatInfo->audioChannels();
+
+	if(IS_VALID(channels) && (channels <= 2))
+	{
+		return AbstractFilter::FILTER_SKIPPED;
+	}
+
+	appendEffects(effects, channels);
+
+	formatInfo->setAudioChannels(2);
+	return AbstractFilter::FILTER_SUCCESS;
+}
+
+void DownmixFilter::appendEffects(QStringList &args, const unsigned int &channels)
+{
 	switch(channels)
 	{
 	case 3: //3.0 (L/R/C)
@@ -99,38 +166,4 @@ AbstractFilter::FilterResult DownmixFilter::apply(const QString &sourceFile, con
 		args << "channels" << QString::number(2);
 		break;
 	}
-
-	if(!startProcess(process, m_binary, args, QFileInfo(outputFile).canonicalPath()))
-	{
-		return AbstractFilter::FILTER_FAILURE;
-	}
-
-	int prevProgress = -1;
-	QRegExp regExp("In:(\\d+)(\\.\\d+)*%");
-
-	const result_t result = awaitProcess(process, abortFlag, [this, &prevProgress, &regExp](const QString &text)
-	{
-		if (regExp.lastIndexIn(text) >= 0)
-		{
-			qint32 newProgress;
-			if (MUtils::regexp_parse_int32(regExp, newProgress))
-			{
-				if (newProgress > prevProgress)
-				{
-					emit statusUpdated(newProgress);
-					prevProgress = NEXT_PROGRESS(newProgress);
-				}
-			}
-			return true;
-		}
-		return false;
-	});
-
-	if (result != RESULT_SUCCESS)
-	{
-		return AbstractFilter::FILTER_FAILURE;
-	}
-	
-	formatInfo->setAudioChannels(2);
-	return AbstractFilter::FILTER_SUCCESS;
 }
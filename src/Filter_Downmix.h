@@ -33,7 +33,13 @@ public:
 	~DownmixFilter(void);
 
 	virtual FilterResult apply(const QString &sourceFile, const QString &outputFile, AudioFileModel_TechInfo *const formatInfo, QAtomicInt &abortFlag);
+	virtual FilterResult pipeCommand(QString &program, QStringList &args, AudioFileModel_TechInfo *const formatInfo);
+	virtual bool supportsPipe(void) const;
+	virtual SoxEffectClass soxEffectClass(void) const;
+	virtual FilterResult soxEffects(QStringList &effects, AudioFileModel_TechInfo *const formatInfo);
 
 private:
+	static void appendEffects(QStringList &args, const unsigned int &channels);
+
 	const QString m_binary;
 };
@@ -24,6 +24,7 @@
 
 //Internal
 #include "Global.h"
+#include "Tool_ProgressMatcher.h"
 
 //MUtils
 #include <MUtils/Global.h>
@@ -32,7 +33,6 @@
 //Qt
 #include <QDir>
 #include <QProcess>
-#include <QRegExp>
 
 static double dbToLinear(const double &value)
 {
@@ -64,9 +64,43 @@ AbstractFilter::FilterResult NormalizeFilter::apply(const QString &sourceFile, c
 
 	args << "-V3" << "-S";
 	args << "--temp" << ".";
+	if(m_ignoreInputLength)
+	{
+		args << "--ignore-length";
+	}
 	args << QDir::toNativeSeparators(sourceFile);
 	args << QDir::toNativeSeparators(outputFile);
 
+	appendEffects(args);
+
+	if(!startProcess(process, m_binary, args, QFileInfo(outputFile).canonicalPath()))
+	{
+		return AbstractFilter::FILTER_FAILURE;
+	}
+
+	const result_t result = awaitProcess(process, abortFlag, ProgressMatcher("In:"));
+
+	if (result != RESULT_SUCCESS)
+	{
+		return AbstractFilter::FILTER_FAILURE;
+	}
+	
+	return AbstractFilter::FILTER_SUCCESS;
+}
+
+AbstractFilter::SoxEffectClass NormalizeFilter::soxEffectClass(void) const
+{
+	return AbstractFilter::SOX_EFFECT_GAIN;
+}
+
+AbstractFilter::FilterResult NormalizeFilter::soxEffects(QStringList &effects, AudioFileModel_TechInfo* /*formatInfo*/)
+{
+	appendEffects(effects);
+	return AbstractFilter::FILTER_SUCCESS;
+}
+
+void NormalizeFilter::appendEffects(QStringList &args) const
+{
 	if(!m_useDynAudNorm)
 	{
 		args << "gain";
@@ -83,37 +117,4 @@ AbstractFilter::FilterResult NormalizeFilter::apply(const QString &sourceFile, c
 			args << "-n";
 		}
 	}
-
-	if(!startProcess(process, m_binary, args, QFileInfo(outputFile).canonicalPath()))
-	{
-		return AbstractFilter::FILTER_FAILURE;
-	}
-
-	int prevProgress = -1;
-	QRegExp regExp("In:(\\d+)(\\.\\d+)*%");
-
-	const result_t result = awaitProcess(process, abortFlag, [this, &prevProgress, &regExp](const QString &text)
-	{
-		if (regExp.lastIndexIn(text) >= 0)
-		{
-			qint32 newProgress;
-			if (MUtils::regexp_parse_int32(regExp, newProgress))
-			{
-				if (newProgress > prevProgress)
-				{
-					emit statusUpdated(newProgress);
-					prevProgress = NEXT_PROGRESS(newProgress);
-				}
-			}
-			return true;
-		}
-		return false;
-	});
-
-	if (result != RESULT_SUCCESS)
-	{
-		return AbstractFilter::FILTER_FAILURE;
-	}
-	
-	return AbstractFilter::FILTER_SUCCESS;
 }
@@ -24,6 +24,10 @@
 
 #include "Filter_Abstract.h"
 
+/*
+ * Normalization needs to see the complete input before the first sample can be written, so this filter does not
+ * support streaming. Jobs that use it are processed with explicit intermediate files.
+ */
 class NormalizeFilter : public AbstractFilter
 {
 public:
@@ -31,8 +35,12 @@ public:
 	~NormalizeFilter(void);
 
 	virtual FilterResult apply(const QString &sourceFile, const QString &outputFile, AudioFileModel_TechInfo *const formatInfo, QAtomicInt &abortFlag);
+	virtual SoxEffectClass soxEffectClass(void) const;
+	virtual FilterResult soxEffects(QStringList &effects, AudioFileModel_TechInfo *const formatInfo);
 
 private:
+	void appendEffects(QStringList &args) const;
+
 	const QString m_binary;
 	const bool m_useDynAudNorm;
 	const bool m_channelsCoupled;
@@ -24,6 +24,7 @@
 
 //Internal
 #include "Global.h"
+#include "Tool_ProgressMatcher.h"
 #include "Model_AudioFile.h"
 
 //MUtils
@@ -32,7 +33,6 @@
 //Qt
 #include <QDir>
 #include <QProcess>
-#include <QRegExp>
 
 static __inline int multipleOf(int value, int base)
 {
@@ -75,6 +75,10 @@ AbstractFilter::FilterResult ResampleFilter::apply(const QString &sourceFile, co
 
 	args << "-V3" << "-S";
 	args << "--guard" << "--temp" << ".";
+	if(m_ignoreInputLength)
+	{
+		args << "--ignore-length";
+	}
 	args << QDir::toNativeSeparators(sourceFile);
 
 	if(m_bitDepth)
@@ -84,50 +88,75 @@ AbstractFilter::FilterResult ResampleFilter::apply(const QString &sourceFile, co
 
 	args << QDir::toNativeSeparators(outputFile);
 
-	if(m_samplingRate)
-	{
-		args << "rate";
-		args << ((m_bitDepth > 16) ? "-v" : "-h");			//if resampling at/to > 16 bit depth (i.e. most commonly 24-bit), use VHQ (-v), otherwise, use HQ (-h)
-		args << ((m_samplingRate > 40000) ? "-L" : "-I");	//if resampling to < 40k, use intermediate phase (-I), otherwise use linear phase (-L)
-		args << QString::number(m_samplingRate);
-	}
+	appendEffects(args);
+	appendDither(args);
 
-	if((m_bitDepth || m_samplingRate) && (m_bitDepth <= 16))
+	if(!startProcess(process, m_binary, args, QFileInfo(outputFile).canonicalPath()))
 	{
-		args << "dither" << "-s";					//if you're mastering to 16-bit, you also need to add 'dither' (and in most cases noise-shaping) after the rate
+		return AbstractFilter::FILTER_FAILURE;
 	}
 
-	if(!startProcess(process, m_binary, args, QFileInfo(outputFile).canonicalPath()))
+	const result_t result = awaitProcess(process, abortFlag, ProgressMatcher("In:"));
+
+	if (result != RESULT_SUCCESS)
 	{
 		return AbstractFilter::FILTER_FAILURE;
 	}
+	
+	if (m_samplingRate)
+	{
+		formatInfo->setAudioSamplerate(m_samplingRate);
+	}
+	if (m_bitDepth)
+	{
+		formatInfo->setAudioBitdepth(m_bitDepth);
+	}
 
-	int prevProgress = -1;
-	QRegExp regExp("In:(\\d+)(\\.\\d+)*%");
+	return AbstractFilter::FILTER_SUCCESS;
+}
+
+AbstractFilter::FilterResult ResampleFilter::pipeCommand(QString &program, QStringList &args, AudioFileModel_TechInfo *const formatInfo)
+{
+	QStringList effects;
+	const FilterResult result = soxEffects(effects, formatInfo);
 
-	const result_t result = awaitProcess(process, abortFlag, [this, &prevProgress, &regExp](const QString &text)
+	if(result == AbstractFilter::FILTER_SUCCESS)
 	{
-		if (regExp.lastIndexIn(text) >= 0)
+		appendDither(effects);
+		args << "-V2";
+		args << "--guard" << "--temp" << ".";
+		args << "-t" << "wav" << "-";
+		if(m_bitDepth)
 		{
-			qint32 newProgress;
-			if (MUtils::regexp_parse_int32(regExp, newProgress))
-			{
-				if (newProgress > prevProgress)
-				{
-					emit statusUpdated(newProgress);
-					prevProgress = NEXT_PROGRESS(newProgress);
-				}
-			}
-			return true;
+			args << "-b" << QString::number(m_bitDepth);
 		}
-		return false;
-	});
+		args << "-t" << "wav" << "-";
+		args << effects;
+		program = m_binary;
+	}
 
-	if (result != RESULT_SUCCESS)
+	return result;
+}
+
+bool ResampleFilter::supportsPipe(void) const
+{
+	return true;
+}
+
+AbstractFilter::SoxEffectClass ResampleFilter::soxEffectClass(void) const
+{
+	return AbstractFilter::SOX_EFFECT_RATE;
+}
+
+AbstractFilter::FilterResult ResampleFilter::soxEffects(QStringList &effects, AudioFileModel_TechInfo *const formatInfo)
+{
+	if((m_samplingRate == static_cast<int>(formatInfo->audioSamplerate())) && (m_bitDepth == static_cast<int>(formatInfo->audioBitdepth())))
 	{
-		return AbstractFilter::FILTER_FAILURE;
+		return AbstractFilter::FILTER_SKIPPED;
 	}
-	
+
+	appendEffects(effects);
+
 	if (m_samplingRate)
 	{
 		formatInfo->setAudioSamplerate(m_samplingRate);
@@ -139,3 +168,27 @@ AbstractFilter::FilterResult ResampleFilter::apply(const QString &sourceFile, co
 
 	return AbstractFilter::FILTER_SUCCESS;
 }
+
+void ResampleFilter::soxDitherEffects(QStringList &effects) const
+{
+	appendDither(effects);
+}
+
+void ResampleFilter::appendEffects(QStringList &args) const
+{
+	if(m_samplingRate)
+	{
+		args << "rate";
+		args << ((m_bitDepth > 16) ? "-v" : "-h");			//if resampling at/to > 16 bit depth (i.e. most commonly 24-bit), use VHQ (-v), otherwise, use HQ (-h)
+		args << ((m_samplingRate > 40000) ? "-L" : "-I");	//if resampling to < 40k, use intermediate phase (-I), otherwise use linear phase (-L)
+		args << QString::number(m_samplingRate);
+	}
+}
+
+void ResampleFilter::appendDither(QStringList &args) const
+{
+	if((m_bitDepth || m_samplingRate) && (m_bitDepth <= 16))
+	{
+		args << "dither" << "-s";					//if you're mastering to 16-bit, you also need to add 'dither' (and in most cases noise-shaping) after the rate
+	}
+}
@@ -31,8 +31,16 @@ public:
 	~ResampleFilter(void);
 
 	virtual FilterResult apply(const QString &sourceFile, const QString &outputFile, AudioFileModel_TechInfo *const formatInfo, QAtomicInt &abortFlag);
+	virtual FilterResult pipeCommand(QString &program, QStringList &args, AudioFileModel_TechInfo *const formatInfo);
+	virtual bool supportsPipe(void) const;
+	virtual SoxEffectClass soxEffectClass(void) const;
+	virtual FilterResult soxEffects(QStringList &effects, AudioFileModel_TechInfo *const formatInfo);
+	virtual void soxDitherEffects(QStringList &effects) const;
 
 private:
+	void appendEffects(QStringList &args) const;
+	void appendDither(QStringList &args) const;
+
 	const QString m_binary;
 	int m_samplingRate;
 	int m_bitDepth;
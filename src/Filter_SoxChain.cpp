@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+#include "Filter_SoxChain.h"
+
+//Internal
+#include "Global.h"
+#include "Tool_ProgressMatcher.h"
+#include "Model_AudioFile.h"
+
+//MUtils
+#include <MUtils/Exception.h>
+
+//Qt
+#include <QDir>
+#include <QProcess>
+
+#define IS_VALID(X) (((X) != 0U) && ((X) != UINT_MAX))
+
+SoxChainFilter::SoxChainFilter(void)
+:
+	m_binary(lamexp_tools_lookup("sox.exe"))
+{
+	if(m_binary.isEmpty())
+	{
+		MUTILS_THROW("Error initializing SoX filter. Tool 'sox.exe' is not registred!");
+	}
+}
+
+SoxChainFilter::~SoxChainFilter(void)
+{
+	while(!m_filters.isEmpty())
+	{
+		delete m_filters.takeFirst();
+	}
+}
+
+void SoxChainFilter::addFilter(AbstractFilter *const filter)
+{
+	if(filter->soxEffectClass() == AbstractFilter::SOX_EFFECT_NONE)
+	{
+		MUTILS_THROW("Filter can not be added to SoX chain, because it is not based on SoX!");
+	}
+
+	m_filters.append(filter);
+}
+
+AbstractFilter::FilterResult SoxChainFilter::apply(const QString &sourceFile, const QString &outputFile, AudioFileModel_TechInfo *const formatInfo, QAtomicInt &abortFlag)
+{
+	QProcess process;
+	QStringList args, effects;
+
+	unsigned int outputBits = 0;
+	AudioFileModel_TechInfo outputInfo(*formatInfo);
+
+	const FilterResult effectsResult = makeEffects(effects, outputBits, &outputInfo);
+	if(effectsResult != AbstractFilter::FILTER_SUCCESS)
+	{
+		if(effectsResult == AbstractFilter::FILTER_SKIPPED)
+		{
+			messageLogged("Skipping filter chain!");
+		}
+		return effectsResult;
+	}
+
+	args << "-V3" << "-S";
+	args << "--guard" << "--temp" << ".";
+	if(m_ignoreInputLength)
+	{
+		args << "--ignore-length";
+	}
+	args << QDir::toNativeSeparators(sourceFile);
+
+	if(outputBits)
+	{
+		args << "-b" << QString::number(outputBits);
+	}
+
+	args << QDir::toNativeSeparators(outputFile);
+	args << effects;
+
+	if(!startProcess(process, m_binary, args, QFileInfo(outputFile).canonicalPath()))
+	{
+		return AbstractFilter::FILTER_FAILURE;
+	}
+
+	const result_t result = awaitProcess(process, abortFlag, ProgressMatcher("In:"));
+
+	if (result != RESULT_SUCCESS)
+	{
+		return AbstractFilter::FILTER_FAILURE;
+	}
+
+	*formatInfo = outputInfo;
+	return AbstractFilter::FILTER_SUCCESS;
+}
+
+AbstractFilter::FilterResult SoxChainFilter::pipeCommand(QString &program, QStringList &args, AudioFileModel_TechInfo *const formatInfo)
+{
+	QStringList effects;
+	unsigned int outputBits = 0;
+
+	if(!supportsPipe())
+	{
+		return AbstractFilter::FILTER_FAILURE;
+	}
+
+	const FilterResult result = makeEffects(effects, outputBits, formatInfo);
+
+	if(result == AbstractFilter::FILTER_SUCCESS)
+	{
+		args << "-V2";
+		args << "--guard" << "--temp" << ".";
+		args << "-t" << "wav" << "-";
+		if(outputBits)
+		{
+			args << "-b" << QString::number(outputBits);
+		}
+		args << "-t" << "wav" << "-";
+		args << effects;
+		program = m_binary;
+	}
+
+	return result;
+}
+
+/*
+ * The chain can only be streamed, if every single filter can be streamed
+ */
+bool SoxChainFilter::supportsPipe(void) const
+{
+	for(QList<AbstractFilter*>::ConstIterator iter = m_filters.constBegin(); iter != m_filters.constEnd(); iter++)
+	{
+		if(!(*iter)->supportsPipe())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+ * Collect the effects of all filters, ordered by effect class (remix -> bass/treble -> rate -> gain), followed by dither
+ */
+AbstractFilter::FilterResult SoxChainFilter::makeEffects(QStringList &effects, unsigned int &outputBits, AudioFileModel_TechInfo *const formatInfo)
+{
+	const unsigned int inputBits = formatInfo->audioBitdepth();
+	bool bHaveEffects = false;
+	QStringList dither;
+
+	for(int effectClass = AbstractFilter::SOX_EFFECT_REMIX; effectClass <= AbstractFilter::SOX_EFFECT_GAIN; effectClass++)
+	{
+		for(QList<AbstractFilter*>::ConstIterator iter = m_filters.constBegin(); iter != m_filters.constEnd(); iter++)
+		{
+			if((*iter)->soxEffectClass() == effectClass)
+			{
+				switch((*iter)->soxEffects(effects, formatInfo))
+				{
+				case AbstractFilter::FILTER_SUCCESS:
+					if(dither.isEmpty())
+					{
+						(*iter)->soxDitherEffects(dither);
+					}
+					bHaveEffects = true;
+					break;
+				case AbstractFilter::FILTER_FAILURE:
+					return AbstractFilter::FILTER_FAILURE;
+				}
+			}
+		}
+	}
+
+	//Dither must be the final effect, otherwise any subsequent gain would quantize it away
+	effects << dither;
+
+	//Only request a specific output bit depth, if one of the filters has changed it
+	const unsigned int bitdepth = formatInfo->audioBitdepth();
+	outputBits = ((bitdepth != inputBits) && IS_VALID(bitdepth) && (bitdepth != AudioFileModel::BITDEPTH_IEEE_FLOAT32)) ? bitdepth : 0;
+
+	return bHaveEffects ? AbstractFilter::FILTER_SUCCESS : AbstractFilter::FILTER_SKIPPED;
+}
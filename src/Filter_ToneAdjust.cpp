@@ -24,6 +24,7 @@
 
 //Internal
 #include "Global.h"
+#include "Tool_ProgressMatcher.h"
 
 //MUtils
 #include <MUtils/Exception.h>
@@ -31,7 +32,6 @@
 //Qt
 #include <QDir>
 #include <QProcess>
-#include <QRegExp>
 #include <QFileInfo>
 
 ToneAdjustFilter::ToneAdjustFilter(int bass, int treble)
@@ -58,43 +58,21 @@ AbstractFilter::FilterResult ToneAdjustFilter::apply(const QString &sourceFile,
 
 	args << "-V3" << "-S";
 	args << "--guard" << "--temp" << ".";
+	if(m_ignoreInputLength)
+	{
+		args << "--ignore-length";
+	}
 	args << QDir::toNativeSeparators(sourceFile);
 	args << QDir::toNativeSeparators(outputFile);
 
-	if(m_bass != 0)
-	{
-		args << "bass" << QString().sprintf("%s%.2f", ((m_bass < 0) ? "-" : "+"), static_cast<double>(abs(m_bass)) / 100.0);
-	}
-	if(m_treble != 0)
-	{
-		args << "treble" << QString().sprintf("%s%.2f", ((m_treble < 0) ? "-" : "+"), static_cast<double>(abs(m_treble)) / 100.0);
-	}
+	appendEffects(args);
 
 	if(!startProcess(process, m_binary, args, QFileInfo(outputFile).canonicalPath()))
 	{
 		return AbstractFilter::FILTER_FAILURE;
 	}
 
-	int prevProgress = -1;
-	QRegExp regExp("In:(\\d+)(\\.\\d+)*%");
-
-	const result_t result = awaitProcess(process, abortFlag, [this, &prevProgress, &regExp](const QString &text)
-	{
-		if (regExp.lastIndexIn(text) >= 0)
-		{
-			qint32 newProgress;
-			if (MUtils::regexp_parse_int32(regExp, newProgress))
-			{
-				if (newProgress > prevProgress)
-				{
-					emit statusUpdated(newProgress);
-					prevProgress = NEXT_PROGRESS(newProgress);
-				}
-			}
-			return true;
-		}
-		return false;
-	});
+	const result_t result = awaitProcess(process, abortFlag, ProgressMatcher("In:"));
 
 	if (result != RESULT_SUCCESS)
 	{
@@ -103,3 +81,49 @@ AbstractFilter::FilterResult ToneAdjustFilter::apply(const QString &sourceFile,
 	
 	return AbstractFilter::FILTER_SUCCESS;
 }
+
+AbstractFilter::FilterResult ToneAdjustFilter::pipeCommand(QString &program, QStringList &args, AudioFileModel_TechInfo *const formatInfo)
+{
+	QStringList effects;
+	const FilterResult result = soxEffects(effects, formatInfo);
+
+	if(result == AbstractFilter::FILTER_SUCCESS)
+	{
+		args << "-V2";
+		args << "--guard" << "--temp" << ".";
+		args << "-t" << "wav" << "-";
+		args << "-t" << "wav" << "-";
+		args << effects;
+		program = m_binary;
+	}
+
+	return result;
+}
+
+bool ToneAdjustFilter::supportsPipe(void) const
+{
+	return true;
+}
+
+AbstractFilter::SoxEffectClass ToneAdjustFilter::soxEffectClass(void) const
+{
+	return AbstractFilter::SOX_EFFECT_TONE;
+}
+
+AbstractFilter::FilterResult ToneAdjustFilter::soxEffects(QStringList &effects, AudioFileModel_TechInfo* /*formatInfo*/)
+{
+	appendEffects(effects);
+	return AbstractFilter::FILTER_SUCCESS;
+}
+
+void ToneAdjustFilter::appendEffects(QStringList &args) const
+{
+	if(m_bass != 0)
+	{
+		args << "bass" << QString().sprintf("%s%.2f", ((m_bass < 0) ? "-" : "+"), static_cast<double>(abs(m_bass)) / 100.0);
+	}
+	if(m_treble != 0)
+	{
+		args << "treble" << QString().sprintf("%s%.2f", ((m_treble < 0) ? "-" : "+"), static_cast<double>(abs(m_treble)) / 100.0);
+	}
+}
@@ -31,8 +31,14 @@ public:
 	~ToneAdjustFilter(void);
 
 	virtual FilterResult apply(const QString &sourceFile, const QString &outputFile, AudioFileModel_TechInfo *const formatInfo, QAtomicInt &abortFlag);
+	virtual FilterResult pipeCommand(QString &program, QStringList &args, AudioFileModel_TechInfo *const formatInfo);
+	virtual bool supportsPipe(void) const;
+	virtual SoxEffectClass soxEffectClass(void) const;
+	virtual FilterResult soxEffects(QStringList &effects, AudioFileModel_TechInfo *const formatInfo);
 
 private:
+	void appendEffects(QStringList &args) const;
+
 	const QString m_binary;
 	int m_bass;
 	int m_treble;
@@ -25,6 +25,7 @@
 //Internal
 #include "Global.h"
 #include "FileHash.h"
+#include "ToolCache.h"
 
 //MUtils
 #include <MUtils/OSSupport.h>
@@ -267,6 +268,45 @@ static __forceinline void doValidateHash(HANDLE &fileHandle, const int &fileDesc
 	}
 }
 
+static __forceinline bool doQueryFileId(const HANDLE &fileHandle, ToolCache::file_id_t &fileId)
+{
+	BY_HANDLE_FILE_INFORMATION info;
+	if(GetFileInformationByHandle(fileHandle, &info))
+	{
+		fileId.fileSize  = (quint64(info.nFileSizeHigh) << 32) | quint64(info.nFileSizeLow);
+		fileId.fileTime  = qint64((quint64(info.ftLastWriteTime.dwHighDateTime) << 32) | quint64(info.ftLastWriteTime.dwLowDateTime));
+		fileId.volumeId  = quint32(info.dwVolumeSerialNumber);
+		fileId.fileIndex = (quint64(info.nFileIndexHigh) << 32) | quint64(info.nFileIndexLow);
+		return true;
+	}
+	return false;
+}
+
+/*
+ * Trust model: the file is locked at this point, so it can not change while in use. If its size, modification time
+ * and file-id still match the manifest entry, it is assumed to be unchanged since it was verified, and the full hash
+ * is skipped. The manifest checksum is not a trust anchor (its seed is public), hence this shortcut is restricted to
+ * the trusted folder, which normal users can not write to. Binaries in user-writable locations, such as the
+ * persistent tools folder, are always verified by their full hash.
+ */
+static __forceinline void doValidateCached(HANDLE &fileHandle, const int &fileDescriptor, const QByteArray &expectedHash, const QString &filePath)
+{
+	ToolCache::file_id_t fileId;
+	ToolCache *const toolCache = ToolCache::instance();
+	const bool haveFileId = toolCache && doQueryFileId(fileHandle, fileId);
+	if(haveFileId && toolCache->verify(filePath, fileId, expectedHash))
+	{
+		return;
+	}
+
+	doValidateHash(fileHandle, fileDescriptor, expectedHash, filePath);
+
+	if(haveFileId)
+	{
+		toolCache->insert(filePath, fileId, expectedHash);
+	}
+}
+
 static __forceinline bool doRemoveFile(const QString &filePath)
 {
 	for (quint32 delay = 0U; delay <= MAX_LOCK_DELAY / 4; delay = NEXT_DELAY(delay))
@@ -313,8 +353,15 @@ LockedFile::LockedFile(QResource *const resource, const QString &outPath, const
 	//Get file descriptor
 	doInitFileDescriptor(fileHandle, m_fileDescriptor);
 
-	//Validate file hash
-	doValidateHash(fileHandle, m_fileDescriptor, expectedHash, m_filePath);
+	//Validate file hash, files that will be kept are recorded in the manifest
+	if(m_bOwnsFile || expectedHash.isEmpty())
+	{
+		doValidateHash(fileHandle, m_fileDescriptor, expectedHash, m_filePath);
+	}
+	else
+	{
+		doValidateCached(fileHandle, m_fileDescriptor, expectedHash, m_filePath);
+	}
 }
 
 LockedFile::LockedFile(const QString &filePath, const QByteArray &expectedHash, const bool bOwnsFile)
@@ -334,8 +381,15 @@ LockedFile::LockedFile(const QString &filePath, const QByteArray &expectedHash,
 	//Get file descriptor
 	doInitFileDescriptor(fileHandle, m_fileDescriptor);
 
-	//Validate file hash
-	doValidateHash(fileHandle, m_fileDescriptor, expectedHash, m_filePath);
+	//Validate file hash, unless the file is unchanged since it was verified
+	if(m_bOwnsFile || expectedHash.isEmpty())
+	{
+		doValidateHash(fileHandle, m_fileDescriptor, expectedHash, m_filePath);
+	}
+	else
+	{
+		doValidateCached(fileHandle, m_fileDescriptor, expectedHash, m_filePath);
+	}
 }
 
 LockedFile::LockedFile(const QString &filePath, const bool bOwnsFile)
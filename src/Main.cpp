@@ -32,6 +32,7 @@
 #include "Model_AudioFile.h"
 #include "Encoder_Abstract.h"
 #include "ShellIntegration.h"
+#include "Benchmark.h"
 
 //MUitls
 #include <MUtils/Global.h>
@@ -270,6 +271,19 @@ static int lamexp_main(int &argc, char **argv)
 		InitializationThread::selfTest();
 	}
 
+	//Benchmark mode?
+	if(arguments.contains("benchmark"))
+	{
+		QScopedPointer<InitializationThread> poInitializationThread(new InitializationThread(cpuFeatures));
+		poInitializationThread->runSyncronized();
+		if(!poInitializationThread->getSuccess())
+		{
+			qWarning("Initialization has failed, unable to run the benchmarks!");
+			return EXIT_FAILURE;
+		}
+		return Benchmark::run(arguments.values("benchmark")) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
 	//Main application loop
 	iResult = lamexp_main_loop(arguments, cpuFeatures, ipcChannel.data(), iShutdown);
 
@@ -30,6 +30,10 @@
 
 //Qt
 #include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QAtomicInt>
+#include <QCryptographicHash>
 #include <QMutex>
 #include <QMutexLocker>
 
@@ -37,19 +41,24 @@
 // Shared data class
 ////////////////////////////////////////////////////////////
 
+/*
+ * All artwork instances are kept in a process-wide store, keyed by the file path or, for extracted
+ * images, by the hash of the image content. Equal images thus share a single file and file handle.
+ * Copies only touch the atomic reference counter, the store mutex is held for lookups and removal.
+ */
 class ArtworkModel_SharedData
 {
 	friend ArtworkModel;
 
 protected:
-	ArtworkModel_SharedData(const QString &filePath, const bool isOwner)
+	ArtworkModel_SharedData(const QString &key, const QString &filePath, const bool isOwner)
 	:
-		m_isOwner(isOwner),
+		m_key(key),
 		m_filePath(filePath),
-		m_fileHandle(NULL)
+		m_isOwner(isOwner),
+		m_fileHandle(NULL),
+		m_referenceCounter(1)
 	{
-		m_referenceCounter = 1;
-
 		if(!m_filePath.isEmpty())
 		{
 			QFile *file = new QFile(m_filePath);
@@ -78,12 +87,42 @@ protected:
 		}
 	}
 
+	static ArtworkModel_SharedData *lookup(const QString &key)
+	{
+		QMutexLocker lock(&s_mutex);
+		QHash<QString, ArtworkModel_SharedData*>::const_iterator iter = s_store.constFind(key);
+		if(iter != s_store.constEnd())
+		{
+			ArtworkModel_SharedData *const ptr = iter.value();
+			forever
+			{
+				const int count = ptr->m_referenceCounter;
+				if(count < 1)
+				{
+					break; /*last reference is being released right now*/
+				}
+				if(ptr->m_referenceCounter.testAndSetOrdered(count, count + 1))
+				{
+					return ptr;
+				}
+			}
+		}
+		return NULL;
+	}
+
+	static ArtworkModel_SharedData *create(const QString &key, const QString &filePath, const bool isOwner)
+	{
+		ArtworkModel_SharedData *const ptr = new ArtworkModel_SharedData(key, filePath, isOwner);
+		QMutexLocker lock(&s_mutex);
+		s_store.insert(key, ptr);
+		return ptr;
+	}
+
 	static ArtworkModel_SharedData *attach(ArtworkModel_SharedData *ptr)
 	{
 		if(ptr)
 		{
-			QMutexLocker lock(&s_mutex);
-			ptr->m_referenceCounter = ptr->m_referenceCounter + 1;
+			ptr->m_referenceCounter.ref();
 			return ptr;
 		}
 		return NULL;
@@ -93,32 +132,45 @@ protected:
 	{
 		if(*ptr)
 		{
-			QMutexLocker lock(&s_mutex);
-			if((*ptr)->m_referenceCounter > 0)
+			if(!(*ptr)->m_referenceCounter.deref())
 			{
-				(*ptr)->m_referenceCounter = (*ptr)->m_referenceCounter - 1;
-				if((*ptr)->m_referenceCounter < 1)
+				QMutexLocker lock(&s_mutex);
+				QHash<QString, ArtworkModel_SharedData*>::iterator iter = s_store.find((*ptr)->m_key);
+				if((iter != s_store.end()) && (iter.value() == (*ptr)))
 				{
-					delete (*ptr);
+					s_store.erase(iter);
 				}
-			}
-			else
-			{
-				qWarning("[ArtworkModel::detach] Ref counter already zero!");
+				lock.unlock();
+				delete (*ptr);
 			}
 			*ptr = NULL;
 		}
 	}
 
+	static QString pathKey(const QString &filePath, const bool isOwner)
+	{
+		return QString("%1:%2").arg(isOwner ? "temp" : "file", QFileInfo(filePath).absoluteFilePath().toLower());
+	}
+
+	static QString dataKey(const QByteArray &content)
+	{
+		return QString("data:%1").arg(QString::fromLatin1(QCryptographicHash::hash(content, QCryptographicHash::Sha1).toHex().constData()));
+	}
+
+	const QString m_key;
 	const QString m_filePath;
 	const bool m_isOwner;
 	QFile *m_fileHandle;
-	unsigned int m_referenceCounter;
+	QAtomicInt m_referenceCounter;
 
 	static QMutex s_mutex;
+	static QHash<QString, ArtworkModel_SharedData*> s_store;
 };
 
 QMutex ArtworkModel_SharedData::s_mutex;
+QHash<QString, ArtworkModel_SharedData*> ArtworkModel_SharedData::s_store;
+
+static const QString g_nullString;
 
 ////////////////////////////////////////////////////////////
 // Constructor & Destructor
@@ -126,42 +178,37 @@ QMutex ArtworkModel_SharedData::s_mutex;
 
 ArtworkModel::ArtworkModel(void)
 :
-	m_mutex(new QMutex)
+	m_data(NULL)
 {
-	m_data = NULL;
 }
 
 ArtworkModel::ArtworkModel(const QString &fileName, bool isOwner)
 :
-	m_mutex(new QMutex)
+	m_data(NULL)
 {
-	m_data = new ArtworkModel_SharedData(fileName, isOwner);
+	setFilePath(fileName, isOwner);
 }
 
 ArtworkModel::ArtworkModel(const ArtworkModel &model)
 :
-	m_mutex(new QMutex)
+	m_data(ArtworkModel_SharedData::attach(model.m_data))
 {
-	m_data = ArtworkModel_SharedData::attach(model.m_data);
 }
 
 ArtworkModel &ArtworkModel::operator=(const ArtworkModel &model)
 {
-	QMutexLocker lock(m_mutex);
 	if(m_data != model.m_data)
 	{
+		ArtworkModel_SharedData *const data = ArtworkModel_SharedData::attach(model.m_data);
 		ArtworkModel_SharedData::detach(&m_data);
-		m_data = ArtworkModel_SharedData::attach(model.m_data);
+		m_data = data;
 	}
 	return (*this);
 }
 
 ArtworkModel::~ArtworkModel(void)
 {
-	QMutexLocker lock(m_mutex);
 	ArtworkModel_SharedData::detach(&m_data);
-	lock.unlock();
-	MUTILS_DELETE(m_mutex);
 }
 
 ////////////////////////////////////////////////////////////
@@ -170,28 +217,72 @@ ArtworkModel::~ArtworkModel(void)
 
 const QString &ArtworkModel::filePath(void) const
 {
-	QMutexLocker lock(m_mutex);
-	return (m_data) ? m_data->m_filePath : m_nullString;
+	return (m_data) ? m_data->m_filePath : g_nullString;
 }
 
 bool ArtworkModel::isOwner(void) const
 {
-	QMutexLocker lock(m_mutex);
 	return (m_data) ? m_data->m_isOwner : false;
 }
 
 void ArtworkModel::setFilePath(const QString &newPath, bool isOwner)
 {
-	QMutexLocker lock(m_mutex);
 	ArtworkModel_SharedData::detach(&m_data);
 	if(!newPath.isEmpty())
 	{
-		m_data = new ArtworkModel_SharedData(newPath, isOwner);
+		const QString key = ArtworkModel_SharedData::pathKey(newPath, isOwner);
+		m_data = ArtworkModel_SharedData::lookup(key);
+		if(!m_data)
+		{
+			m_data = ArtworkModel_SharedData::create(key, newPath, isOwner);
+		}
+	}
+}
+
+bool ArtworkModel::setData(const QByteArray &content, const QString &suffix)
+{
+	ArtworkModel_SharedData::detach(&m_data);
+	if(content.isEmpty())
+	{
+		return false;
+	}
+
+	const QString key = ArtworkModel_SharedData::dataKey(content);
+	m_data = ArtworkModel_SharedData::lookup(key);
+	if(m_data)
+	{
+		return true; /*same image is already in the store*/
+	}
+
+	QFile file(QString("%1/%2.%3").arg(MUtils::temp_folder(), MUtils::next_rand_str(), suffix));
+	if(!file.open(QIODevice::WriteOnly))
+	{
+		qWarning("[ArtworkModel] Failed to create artwork file!");
+		return false;
+	}
+
+	const bool success = (file.write(content) == content.size());
+	file.close();
+	if(!success)
+	{
+		qWarning("[ArtworkModel] Failed to write artwork file!");
+		file.remove();
+		return false;
+	}
+
+	//Another thread may have stored the same image in the meantime
+	m_data = ArtworkModel_SharedData::lookup(key);
+	if(m_data)
+	{
+		file.remove();
+		return true;
 	}
+
+	m_data = ArtworkModel_SharedData::create(key, file.fileName(), true);
+	return true;
 }
 
 void ArtworkModel::clear(void)
 {
-	QMutexLocker lock(m_mutex);
 	ArtworkModel_SharedData::detach(&m_data);
 }
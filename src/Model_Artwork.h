@@ -25,7 +25,7 @@
 #include <QString>
 
 class ArtworkModel_SharedData;
-class QMutex;
+class QByteArray;
 
 class ArtworkModel
 {
@@ -39,12 +39,11 @@ public:
 	const QString &filePath(void) const;
 	bool isOwner(void) const;
 	void setFilePath(const QString &newPath, bool isOwner = true);
+	bool setData(const QByteArray &content, const QString &suffix);
 	void clear(void);
 	
 	inline bool isEmpty(void) const { return (m_data == NULL); }
 
 private:
-	const QString m_nullString;
 	ArtworkModel_SharedData *m_data;
-	QMutex *m_mutex;
 };
@@ -30,9 +30,9 @@
 
 //Qt
 #include <QTime>
-#include <QObject>
+#include <QMutex>
 #include <QMutexLocker>
-#include <QFile>
+#include <QSet>
 
 //CRT
 #include <limits.h>
@@ -51,22 +51,20 @@ while(0)
 } \
 while(0)
 
-//if((!(OTHER.NAME.isEmpty())) && ((FORCE) || (this.NAME.isEmpty()))) /*this.NAME = OTHER.NAME;*/ \
-
 #define UPDATE_STR(OTHER, FORCE, NAME) do \
 { \
-	if(!(((OTHER).NAME).isEmpty())) \
+	if(!(((OTHER)->NAME).isEmpty())) \
 	{ \
-		if((FORCE) || ((this->NAME).isEmpty())) (this->NAME) = ((OTHER).NAME); \
+		if((FORCE) || ((m_data.constData()->NAME).isEmpty())) (m_data->NAME) = ((OTHER)->NAME); \
 	} \
 } \
 while(0)
 
 #define UPDATE_INT(OTHER, FORCE, NAME) do \
 { \
-	if(((OTHER).NAME) > 0) \
+	if(((OTHER)->NAME) > 0) \
 	{ \
-		if((FORCE) || ((this->NAME) == 0)) (this->NAME) = ((OTHER).NAME); \
+		if((FORCE) || ((m_data.constData()->NAME) == 0)) (m_data->NAME) = ((OTHER)->NAME); \
 	} \
 } \
 while(0)
@@ -77,53 +75,88 @@ while(0)
 } \
 while(0)
 
+///////////////////////////////////////////////////////////////////////////////
+// Audio File - String Pool
+///////////////////////////////////////////////////////////////////////////////
+
+static const int STRING_POOL_MAX_SIZE = 4096;
+static const int STRING_POOL_MAX_LENGTH = 64;
+
+static QMutex        g_stringPoolMutex;
+static QSet<QString> g_stringPool;
+
+QString AudioFileModel_StringPool::intern(const QString &str)
+{
+	const QString value = str.trimmed();
+	if(value.isEmpty() || (value.length() > STRING_POOL_MAX_LENGTH))
+	{
+		return value;
+	}
+
+	QMutexLocker lock(&g_stringPoolMutex);
+
+	QSet<QString>::const_iterator iter = g_stringPool.constFind(value);
+	if(iter != g_stringPool.constEnd())
+	{
+		return (*iter);
+	}
+
+	if(g_stringPool.count() < STRING_POOL_MAX_SIZE)
+	{
+		g_stringPool.insert(value);
+	}
+
+	return value;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Audio File - Meta Info
 ///////////////////////////////////////////////////////////////////////////////
 
 AudioFileModel_MetaInfo::AudioFileModel_MetaInfo(void)
+:
+	m_data(new AudioFileModel_MetaInfo_Data())
 {
-	reset();
 }
 
 AudioFileModel_MetaInfo::AudioFileModel_MetaInfo(const AudioFileModel_MetaInfo &model)
+:
+	m_data(model.m_data)
 {
-	ASSIGN_VAL(model, m_titel);
-	ASSIGN_VAL(model, m_artist);
-	ASSIGN_VAL(model, m_album);
-	ASSIGN_VAL(model, m_genre);
-	ASSIGN_VAL(model, m_comment);
-	ASSIGN_VAL(model, m_cover);
-	ASSIGN_VAL(model, m_year);
-	ASSIGN_VAL(model, m_position);
 }
 
 AudioFileModel_MetaInfo &AudioFileModel_MetaInfo::operator=(const AudioFileModel_MetaInfo &model)
 {
-	ASSIGN_VAL(model, m_titel);
-	ASSIGN_VAL(model, m_artist);
-	ASSIGN_VAL(model, m_album);
-	ASSIGN_VAL(model, m_genre);
-	ASSIGN_VAL(model, m_comment);
-	ASSIGN_VAL(model, m_cover);
-	ASSIGN_VAL(model, m_year);
-	ASSIGN_VAL(model, m_position);
-
+	m_data = model.m_data;
 	return (*this);
 }
 
-#define IS_EMPTY(X) ((X).isEmpty() ? "YES" : "NO")
-
 void AudioFileModel_MetaInfo::update(const AudioFileModel_MetaInfo &model, const bool replace)
 {
-	UPDATE_STR(model, replace, m_titel);
-	UPDATE_STR(model, replace, m_artist);
-	UPDATE_STR(model, replace, m_album);
-	UPDATE_STR(model, replace, m_genre);
-	UPDATE_STR(model, replace, m_comment);
-	UPDATE_STR(model, replace, m_cover);
-	UPDATE_INT(model, replace, m_year);
-	UPDATE_INT(model, replace, m_position);
+	const AudioFileModel_MetaInfo_Data *const other = model.m_data.constData();
+	if(other == m_data.constData())
+	{
+		return; /*same data, nothing to update*/
+	}
+
+	UPDATE_STR(other, replace, m_titel);
+	UPDATE_STR(other, replace, m_artist);
+	UPDATE_STR(other, replace, m_album);
+	UPDATE_STR(other, replace, m_genre);
+	UPDATE_STR(other, replace, m_comment);
+	UPDATE_STR(other, replace, m_cover);
+	UPDATE_INT(other, replace, m_year);
+	UPDATE_INT(other, replace, m_position);
+
+	//An explicitly assigned cover always takes precedence over the embedded one
+	if(!m_data.constData()->m_cover.isEmpty())
+	{
+		if(m_data.constData()->m_coverEmbedded) m_data->m_coverEmbedded = false;
+	}
+	else if(other->m_coverEmbedded)
+	{
+		if(!m_data.constData()->m_coverEmbedded) m_data->m_coverEmbedded = true;
+	}
 }
 
 AudioFileModel_MetaInfo::~AudioFileModel_MetaInfo(void)
@@ -133,43 +166,38 @@ AudioFileModel_MetaInfo::~AudioFileModel_MetaInfo(void)
 
 void AudioFileModel_MetaInfo::reset(void)
 {
-	m_titel.clear();
-	m_artist.clear();
-	m_album.clear();
-	m_genre.clear();
-	m_comment.clear();
-	m_cover.clear();
-	m_year = 0;
-	m_position = 0;
+	m_data = new AudioFileModel_MetaInfo_Data();
 }
 
 void AudioFileModel_MetaInfo::print(void) const
 {
-	PRINT_S(m_titel);
-	PRINT_S(m_artist);
-	PRINT_S(m_album);
-	PRINT_S(m_genre);
-	PRINT_S(m_comment);
-	PRINT_S(m_cover.filePath());
-	PRINT_U(m_year);
-	PRINT_U(m_position);
+	const AudioFileModel_MetaInfo_Data *const data = m_data.constData();
+	PRINT_S(data->m_titel);
+	PRINT_S(data->m_artist);
+	PRINT_S(data->m_album);
+	PRINT_S(data->m_genre);
+	PRINT_S(data->m_comment);
+	PRINT_S(data->m_cover.filePath());
+	PRINT_U(data->m_year);
+	PRINT_U(data->m_position);
 }
 
 bool  AudioFileModel_MetaInfo::empty(const bool &ignoreArtwork) const
 {
+	const AudioFileModel_MetaInfo_Data *const data = m_data.constData();
 	bool isEmpty = true;
 
-	if(!m_titel.isEmpty())   isEmpty = false;
-	if(!m_artist.isEmpty())  isEmpty = false;
-	if(!m_album.isEmpty())   isEmpty = false;
-	if(!m_genre.isEmpty())   isEmpty = false;
-	if(!m_comment.isEmpty()) isEmpty = false;
-	if(m_year)               isEmpty = false;
-	if(m_position)           isEmpty = false;
+	if(!data->m_titel.isEmpty())   isEmpty = false;
+	if(!data->m_artist.isEmpty())  isEmpty = false;
+	if(!data->m_album.isEmpty())   isEmpty = false;
+	if(!data->m_genre.isEmpty())   isEmpty = false;
+	if(!data->m_comment.isEmpty()) isEmpty = false;
+	if(data->m_year)               isEmpty = false;
+	if(data->m_position)           isEmpty = false;
 
 	if(!ignoreArtwork)
 	{
-		if(!m_cover.isEmpty())
+		if((!data->m_cover.isEmpty()) || data->m_coverEmbedded)
 		{
 			isEmpty = false;
 		}
@@ -183,41 +211,20 @@ bool  AudioFileModel_MetaInfo::empty(const bool &ignoreArtwork) const
 ///////////////////////////////////////////////////////////////////////////////
 
 AudioFileModel_TechInfo::AudioFileModel_TechInfo(void)
+:
+	m_data(new AudioFileModel_TechInfo_Data())
 {
-	reset();
 }
 
 AudioFileModel_TechInfo::AudioFileModel_TechInfo(const AudioFileModel_TechInfo &model)
+:
+	m_data(model.m_data)
 {
-	ASSIGN_VAL(model, m_containerType);
-	ASSIGN_VAL(model, m_containerProfile);
-	ASSIGN_VAL(model, m_audioType);
-	ASSIGN_VAL(model, m_audioProfile);
-	ASSIGN_VAL(model, m_audioVersion);
-	ASSIGN_VAL(model, m_audioEncodeLib);
-	ASSIGN_VAL(model, m_audioSamplerate);
-	ASSIGN_VAL(model, m_audioChannels);
-	ASSIGN_VAL(model, m_audioBitdepth);
-	ASSIGN_VAL(model, m_audioBitrate);
-	ASSIGN_VAL(model, m_audioBitrateMode);
-	ASSIGN_VAL(model, m_duration);
 }
 
 AudioFileModel_TechInfo &AudioFileModel_TechInfo::operator=(const AudioFileModel_TechInfo &model)
 {
-	ASSIGN_VAL(model, m_containerType);
-	ASSIGN_VAL(model, m_containerProfile);
-	ASSIGN_VAL(model, m_audioType);
-	ASSIGN_VAL(model, m_audioProfile);
-	ASSIGN_VAL(model, m_audioVersion);
-	ASSIGN_VAL(model, m_audioEncodeLib);
-	ASSIGN_VAL(model, m_audioSamplerate);
-	ASSIGN_VAL(model, m_audioChannels);
-	ASSIGN_VAL(model, m_audioBitdepth);
-	ASSIGN_VAL(model, m_audioBitrate);
-	ASSIGN_VAL(model, m_audioBitrateMode);
-	ASSIGN_VAL(model, m_duration);
-
+	m_data = model.m_data;
 	return (*this);
 }
 
@@ -228,18 +235,7 @@ AudioFileModel_TechInfo::~AudioFileModel_TechInfo(void)
 
 void AudioFileModel_TechInfo::reset(void)
 {
-	m_containerType.clear();
-	m_containerProfile.clear();
-	m_audioType.clear();
-	m_audioProfile.clear();
-	m_audioVersion.clear();
-	m_audioEncodeLib.clear();
-	m_audioSamplerate = 0;
-	m_audioChannels = 0;
-	m_audioBitdepth = 0;
-	m_audioBitrate = 0;
-	m_audioBitrateMode = 0;
-	m_duration = 0;
+	m_data = new AudioFileModel_TechInfo_Data();
 }
 
 ////////////////////////////////////////////////////////////
@@ -248,10 +244,10 @@ void AudioFileModel_TechInfo::reset(void)
 
 AudioFileModel::AudioFileModel(const QString &path)
 :
-	m_filePath(path)
+	m_filePath(path),
+	m_sourceOffset(-1),
+	m_sourceLength(-1)
 {
-	m_metaInfo.reset();
-	m_techInfo.reset();
 }
 
 AudioFileModel::AudioFileModel(const AudioFileModel &model)
@@ -259,6 +255,8 @@ AudioFileModel::AudioFileModel(const AudioFileModel &model)
 	ASSIGN_VAL(model, m_filePath);
 	ASSIGN_VAL(model, m_metaInfo);
 	ASSIGN_VAL(model, m_techInfo);
+	ASSIGN_VAL(model, m_sourceOffset);
+	ASSIGN_VAL(model, m_sourceLength);
 }
 
 AudioFileModel &AudioFileModel::operator=(const AudioFileModel &model)
@@ -266,6 +264,8 @@ AudioFileModel &AudioFileModel::operator=(const AudioFileModel &model)
 	ASSIGN_VAL(model, m_filePath);
 	ASSIGN_VAL(model, m_metaInfo);
 	ASSIGN_VAL(model, m_techInfo);
+	ASSIGN_VAL(model, m_sourceOffset);
+	ASSIGN_VAL(model, m_sourceLength);
 
 	return (*this);
 }
@@ -281,6 +281,7 @@ void AudioFileModel::reset(void)
 	m_filePath.clear();
 	m_metaInfo.reset();
 	m_techInfo.reset();
+	m_sourceOffset = m_sourceLength = -1;
 }
 
 /*------------------------------------*/
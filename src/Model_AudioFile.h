@@ -22,19 +22,48 @@
 
 #pragma once
 
-#include <QObject>
 #include <QString>
+#include <QSharedData>
+#include <QCoreApplication>
 
 #include "Model_Artwork.h"
 
+///////////////////////////////////////////////////////////////////////////////
+// Audio File - String Pool
+///////////////////////////////////////////////////////////////////////////////
+
+class AudioFileModel_StringPool
+{
+public:
+	//Returns a trimmed copy of the string that shares its data with all equal strings
+	static QString intern(const QString &str);
+
+private:
+	AudioFileModel_StringPool(void) {}
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // Audio File - Meta Info
 ///////////////////////////////////////////////////////////////////////////////
 
-class AudioFileModel_MetaInfo : public QObject
+class AudioFileModel_MetaInfo_Data : public QSharedData
 {
-	Q_OBJECT
+public:
+	AudioFileModel_MetaInfo_Data(void) : m_coverEmbedded(false), m_year(0), m_position(0) {}
 
+	QString      m_titel;
+	QString      m_artist;
+	QString      m_album;
+	QString      m_genre;
+	QString      m_comment;
+	ArtworkModel m_cover;
+	bool         m_coverEmbedded; /*source contains cover art that has not been extracted yet*/
+	unsigned int m_year;
+	unsigned int m_position;
+};
+
+class AudioFileModel_MetaInfo
+{
 public:
 	//Constructors & Destructor
 	AudioFileModel_MetaInfo(void);
@@ -43,24 +72,27 @@ public:
 	~AudioFileModel_MetaInfo(void);
 
 	//Getter
-	inline const QString &title(void)   const { return m_titel; }
-	inline const QString &artist(void)  const { return m_artist; }
-	inline const QString &album(void)   const { return m_album; }
-	inline const QString &genre(void)   const { return m_genre; }
-	inline const QString &comment(void) const { return m_comment; }
-	inline const QString &cover(void)   const { return m_cover.filePath(); }
-	inline unsigned int year(void)      const { return m_year; }
-	inline unsigned int position(void)  const { return m_position; }
+	inline const QString &title(void)   const { return m_data->m_titel; }
+	inline const QString &artist(void)  const { return m_data->m_artist; }
+	inline const QString &album(void)   const { return m_data->m_album; }
+	inline const QString &genre(void)   const { return m_data->m_genre; }
+	inline const QString &comment(void) const { return m_data->m_comment; }
+	inline const QString &cover(void)   const { return m_data->m_cover.filePath(); }
+	inline bool coverEmbedded(void)     const { return m_data->m_coverEmbedded; }
+	inline unsigned int year(void)      const { return m_data->m_year; }
+	inline unsigned int position(void)  const { return m_data->m_position; }
 
 	//Setter
-	inline void setTitle(const QString &titel)                    { m_titel = titel.trimmed(); }
-	inline void setArtist(const QString &artist)                  { m_artist = artist.trimmed(); }
-	inline void setAlbum(const QString &album)                    { m_album = album.trimmed(); }
-	inline void setGenre(const QString &genre)                    { m_genre = genre.trimmed(); }
-	inline void setComment(const QString &comment)                { m_comment = comment.trimmed(); }
-	inline void setCover(const QString &path, const bool isOwner) { m_cover.setFilePath(path, isOwner); }
-	inline void setYear(const unsigned int year)                  { m_year = year; }
-	inline void setPosition(const unsigned int position)          { m_position = position; }
+	inline void setTitle(const QString &titel)                    { m_data->m_titel = titel.trimmed(); }
+	inline void setArtist(const QString &artist)                  { m_data->m_artist = artist.trimmed(); }
+	inline void setAlbum(const QString &album)                    { m_data->m_album = album.trimmed(); }
+	inline void setGenre(const QString &genre)                    { m_data->m_genre = AudioFileModel_StringPool::intern(genre); }
+	inline void setComment(const QString &comment)                { m_data->m_comment = comment.trimmed(); }
+	inline void setCover(const QString &path, const bool isOwner) { m_data->m_cover.setFilePath(path, isOwner); m_data->m_coverEmbedded = false; }
+	inline bool setCoverData(const QByteArray &data, const QString &type) { m_data->m_coverEmbedded = false; return m_data->m_cover.setData(data, type); }
+	inline void setCoverEmbedded(const bool embedded)             { m_data->m_coverEmbedded = embedded; }
+	inline void setYear(const unsigned int year)                  { m_data->m_year = year; }
+	inline void setPosition(const unsigned int position)          { m_data->m_position = position; }
 
 	//Is empty?
 	bool empty(const bool &ignoreArtwork) const;
@@ -75,24 +107,34 @@ public:
 	void print(void) const;
 
 private:
-	QString      m_titel;
-	QString      m_artist;
-	QString      m_album;
-	QString      m_genre;
-	QString      m_comment;
-	ArtworkModel m_cover;
-	unsigned int m_year;
-	unsigned int m_position;
+	QSharedDataPointer<AudioFileModel_MetaInfo_Data> m_data;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 // Audio File - Technical Info
 ///////////////////////////////////////////////////////////////////////////////
 
-class AudioFileModel_TechInfo : public QObject
+class AudioFileModel_TechInfo_Data : public QSharedData
 {
-	Q_OBJECT
+public:
+	AudioFileModel_TechInfo_Data(void) : m_audioSamplerate(0), m_audioChannels(0), m_audioBitdepth(0), m_audioBitrate(0), m_audioBitrateMode(0), m_duration(0) {}
+
+	QString m_containerType;
+	QString m_containerProfile;
+	QString m_audioType;
+	QString m_audioProfile;
+	QString m_audioVersion;
+	QString m_audioEncodeLib;
+	unsigned int m_audioSamplerate;
+	unsigned int m_audioChannels;
+	unsigned int m_audioBitdepth;
+	unsigned int m_audioBitrate;
+	unsigned int m_audioBitrateMode;
+	unsigned int m_duration;
+};
 
+class AudioFileModel_TechInfo
+{
 public:
 	//Constructors & Destructor
 	AudioFileModel_TechInfo(void);
@@ -101,58 +143,47 @@ public:
 	~AudioFileModel_TechInfo(void);
 
 	//Getter
-	inline const QString &containerType(void)    const { return m_containerType; }
-	inline const QString &containerProfile(void) const { return m_containerProfile; }
-	inline const QString &audioType(void)        const { return m_audioType; }
-	inline const QString &audioProfile(void)     const { return m_audioProfile; }
-	inline const QString &audioVersion(void)     const { return m_audioVersion; }
-	inline const QString &audioEncodeLib(void)   const { return m_audioEncodeLib; }
-	inline unsigned int audioSamplerate(void)    const { return m_audioSamplerate; }
-	inline unsigned int audioChannels(void)      const { return m_audioChannels; }
-	inline unsigned int audioBitdepth(void)      const { return m_audioBitdepth; }
-	inline unsigned int audioBitrate(void)       const { return m_audioBitrate; }
-	inline unsigned int audioBitrateMode(void)   const { return m_audioBitrateMode; }
-	inline unsigned int duration(void)           const { return m_duration; }
+	inline const QString &containerType(void)    const { return m_data->m_containerType; }
+	inline const QString &containerProfile(void) const { return m_data->m_containerProfile; }
+	inline const QString &audioType(void)        const { return m_data->m_audioType; }
+	inline const QString &audioProfile(void)     const { return m_data->m_audioProfile; }
+	inline const QString &audioVersion(void)     const { return m_data->m_audioVersion; }
+	inline const QString &audioEncodeLib(void)   const { return m_data->m_audioEncodeLib; }
+	inline unsigned int audioSamplerate(void)    const { return m_data->m_audioSamplerate; }
+	inline unsigned int audioChannels(void)      const { return m_data->m_audioChannels; }
+	inline unsigned int audioBitdepth(void)      const { return m_data->m_audioBitdepth; }
+	inline unsigned int audioBitrate(void)       const { return m_data->m_audioBitrate; }
+	inline unsigned int audioBitrateMode(void)   const { return m_data->m_audioBitrateMode; }
+	inline unsigned int duration(void)           const { return m_data->m_duration; }
 
 	//Setter
-	inline void setContainerType(const QString &containerType)           { m_containerType = containerType.trimmed(); }
-	inline void setContainerProfile(const QString &containerProfile)     { m_containerProfile = containerProfile.trimmed(); }
-	inline void setAudioType(const QString &audioType)                   { m_audioType = audioType.trimmed(); }
-	inline void setAudioProfile(const QString &audioProfile)             { m_audioProfile = audioProfile.trimmed(); }
-	inline void setAudioVersion(const QString &audioVersion)             { m_audioVersion = audioVersion.trimmed(); }
-	inline void setAudioEncodeLib(const QString &audioEncodeLib)         { m_audioEncodeLib = audioEncodeLib.trimmed(); }
-	inline void setAudioSamplerate(const unsigned int audioSamplerate)   { m_audioSamplerate = audioSamplerate; }
-	inline void setAudioChannels(const unsigned int audioChannels)       { m_audioChannels = audioChannels; }
-	inline void setAudioBitdepth(const unsigned int audioBitdepth)       { m_audioBitdepth = audioBitdepth; }
-	inline void setAudioBitrate(const unsigned int audioBitrate)         { m_audioBitrate = audioBitrate; }
-	inline void setAudioBitrateMode(const unsigned int audioBitrateMode) { m_audioBitrateMode = audioBitrateMode; }
-	inline void setDuration(const unsigned int duration)                 { m_duration = duration; }
+	inline void setContainerType(const QString &containerType)           { m_data->m_containerType = AudioFileModel_StringPool::intern(containerType); }
+	inline void setContainerProfile(const QString &containerProfile)     { m_data->m_containerProfile = AudioFileModel_StringPool::intern(containerProfile); }
+	inline void setAudioType(const QString &audioType)                   { m_data->m_audioType = AudioFileModel_StringPool::intern(audioType); }
+	inline void setAudioProfile(const QString &audioProfile)             { m_data->m_audioProfile = AudioFileModel_StringPool::intern(audioProfile); }
+	inline void setAudioVersion(const QString &audioVersion)             { m_data->m_audioVersion = AudioFileModel_StringPool::intern(audioVersion); }
+	inline void setAudioEncodeLib(const QString &audioEncodeLib)         { m_data->m_audioEncodeLib = AudioFileModel_StringPool::intern(audioEncodeLib); }
+	inline void setAudioSamplerate(const unsigned int audioSamplerate)   { m_data->m_audioSamplerate = audioSamplerate; }
+	inline void setAudioChannels(const unsigned int audioChannels)       { m_data->m_audioChannels = audioChannels; }
+	inline void setAudioBitdepth(const unsigned int audioBitdepth)       { m_data->m_audioBitdepth = audioBitdepth; }
+	inline void setAudioBitrate(const unsigned int audioBitrate)         { m_data->m_audioBitrate = audioBitrate; }
+	inline void setAudioBitrateMode(const unsigned int audioBitrateMode) { m_data->m_audioBitrateMode = audioBitrateMode; }
+	inline void setDuration(const unsigned int duration)                 { m_data->m_duration = duration; }
 
 	//Reset
 	void reset(void);
 
 private:
-	QString m_containerType;
-	QString m_containerProfile;
-	QString m_audioType;
-	QString m_audioProfile;
-	QString m_audioVersion;
-	QString m_audioEncodeLib;
-	unsigned int m_audioSamplerate;
-	unsigned int m_audioChannels;
-	unsigned int m_audioBitdepth;
-	unsigned int m_audioBitrate;
-	unsigned int m_audioBitrateMode;
-	unsigned int m_duration;
+	QSharedDataPointer<AudioFileModel_TechInfo_Data> m_data;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 // Audio File Model
 ///////////////////////////////////////////////////////////////////////////////
 
-class AudioFileModel : public QObject
+class AudioFileModel
 {
-	Q_OBJECT
+	Q_DECLARE_TR_FUNCTIONS(AudioFileModel)
 
 public:
 	//Types
@@ -184,6 +215,12 @@ public:
 	inline void setMetaInfo(const AudioFileModel_MetaInfo &metaInfo) { m_metaInfo = metaInfo; }
 	inline void setTechInfo(const AudioFileModel_TechInfo &techInfo) { m_techInfo = techInfo; }
 
+	//Source range (tracks of a Cue Sheet), given in CD frames
+	inline bool hasSourceRange(void) const                               { return (m_sourceOffset >= 0); }
+	inline qint64 sourceOffset(void) const                               { return m_sourceOffset; }
+	inline qint64 sourceLength(void) const                               { return m_sourceLength; }
+	inline void setSourceRange(const qint64 offset, const qint64 length) { m_sourceOffset = offset; m_sourceLength = length; }
+
 	//Helpers
 	const QString durationInfo(void) const;
 	const QString containerInfo(void) const;
@@ -197,4 +234,6 @@ private:
 	QString m_filePath;
 	AudioFileModel_MetaInfo m_metaInfo;
 	AudioFileModel_TechInfo m_techInfo;
+	qint64 m_sourceOffset; /*a negative offset means the whole file is used*/
+	qint64 m_sourceLength; /*a negative length means up to the end of the file*/
 };
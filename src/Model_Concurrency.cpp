@@ -0,0 +1,163 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+#include "Model_Concurrency.h"
+
+////////////////////////////////////////////////////////////
+// Constants
+////////////////////////////////////////////////////////////
+
+static const double       CPU_IDLE       = 0.75;        //CPU utilization below which we may start another instance
+static const unsigned int CPU_SAMPLES    = 3U;          //number of consecutive "idle" samples required to grow
+static const double       MEMORY_HIGH    = 0.90;        //memory load above which we drop an instance
+static const double       MEMORY_CLEAR   = 0.80;        //memory load that must be reached again before we may grow
+static const unsigned int MEMORY_SAMPLES = 2U;          //number of consecutive "high" samples required to shrink
+static const quint64      DISK_LOW       = 1073741824ui64; //free space on the temp drive below which we drop an instance
+static const double       DISK_BUSY      = 0.35;        //write throughput (relative to the peak) below which we drop an instance
+static const double       DISK_CLEAR     = 0.60;        //write throughput (relative to the peak) required to grow
+static const unsigned int DISK_SAMPLES   = 2U;          //number of consecutive "busy" samples required to shrink
+static const unsigned int COOLDOWN       = 3U;          //number of samples to wait after each decision
+
+////////////////////////////////////////////////////////////
+// Constructor & Destructor
+////////////////////////////////////////////////////////////
+
+ConcurrencyController::ConcurrencyController(const unsigned int &initial, const unsigned int &maximum)
+:
+	m_maximum(qMax(1U, maximum)),
+	m_instances(qBound(1U, initial, qMax(1U, maximum))),
+	m_cpuUsage(1.0),
+	m_memoryLoad(0.0),
+	m_freeSpace(quint64(-1)),
+	m_throughput(-1.0),
+	m_peakThroughput(-1.0),
+	m_cpuIdleCount(0U),
+	m_memoryHighCount(0U),
+	m_diskBusyCount(0U),
+	m_cooldown(COOLDOWN),
+	m_memoryBlocked(false)
+{
+}
+
+ConcurrencyController::~ConcurrencyController(void)
+{
+}
+
+////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////
+
+void ConcurrencyController::setCpuUsage(const double &usage)
+{
+	m_cpuUsage = qBound(0.0, usage, 1.0);
+}
+
+void ConcurrencyController::setMemoryLoad(const double &load)
+{
+	m_memoryLoad = qBound(0.0, load, 1.0);
+}
+
+void ConcurrencyController::setFreeSpace(const quint64 &freeSpace)
+{
+	m_freeSpace = freeSpace;
+}
+
+void ConcurrencyController::setThroughput(const double &throughput)
+{
+	//The peak is the throughput of the drive when our jobs leave enough headroom
+	m_throughput = qMax(0.0, throughput);
+	m_peakThroughput = qMax(m_peakThroughput, m_throughput);
+	m_diskBusyCount = isDiskBusy(DISK_BUSY) ? (m_diskBusyCount + 1U) : 0U;
+}
+
+ConcurrencyController::Decision ConcurrencyController::update(const bool &jobsPending)
+{
+	m_cpuIdleCount = (m_cpuUsage < CPU_IDLE) ? (m_cpuIdleCount + 1U) : 0U;
+	m_memoryHighCount = (m_memoryLoad > MEMORY_HIGH) ? (m_memoryHighCount + 1U) : 0U;
+	if(m_memoryBlocked && (m_memoryLoad < MEMORY_CLEAR))
+	{
+		m_memoryBlocked = false;
+	}
+
+	//Running out of disk space is critical, so we shrink regardless of the cooldown
+	if((m_instances > 1U) && isDiskSpaceLow(1.0))
+	{
+		m_instances--;
+		m_cooldown = COOLDOWN;
+		return Decision_LowDiskSpace;
+	}
+
+	if(m_cooldown > 0U)
+	{
+		m_cooldown--;
+		return Decision_None;
+	}
+
+	if((m_instances > 1U) && (m_memoryHighCount >= MEMORY_SAMPLES))
+	{
+		m_instances--;
+		m_memoryHighCount = 0U;
+		m_memoryBlocked = true;
+		m_cooldown = COOLDOWN;
+		return Decision_MemoryPressure;
+	}
+
+	if((m_instances > 1U) && (m_diskBusyCount >= DISK_SAMPLES))
+	{
+		m_instances--;
+		m_diskBusyCount = 0U;
+		m_cooldown = COOLDOWN;
+		return Decision_DiskBusy;
+	}
+
+	//Only grow if there is headroom for *all* resources, the thresholds differ from the shrink thresholds to avoid oscillation
+	if(jobsPending && (m_instances < m_maximum) && (m_cpuIdleCount >= CPU_SAMPLES) && (!m_memoryBlocked) && (m_memoryLoad < MEMORY_CLEAR) && (!isDiskSpaceLow(2.0)) && (!isDiskBusy(DISK_CLEAR)))
+	{
+		m_instances++;
+		m_cpuIdleCount = 0U;
+		m_cooldown = COOLDOWN;
+		return Decision_CpuIdle;
+	}
+
+	return Decision_None;
+}
+
+////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////
+
+bool ConcurrencyController::isDiskSpaceLow(const double &factor) const
+{
+	if(m_freeSpace == quint64(-1))
+	{
+		return false; /*unknown*/
+	}
+	return (static_cast<double>(m_freeSpace) < (factor * static_cast<double>(DISK_LOW)));
+}
+
+bool ConcurrencyController::isDiskBusy(const double &threshold) const
+{
+	if((m_throughput < 0.0) || (m_peakThroughput <= 0.0))
+	{
+		return false; /*unknown*/
+	}
+	return (m_throughput < (threshold * m_peakThroughput));
+}
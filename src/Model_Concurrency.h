@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <QtGlobal>
+
+////////////////////////////////////////////////////////////
+// Concurrency Controller
+////////////////////////////////////////////////////////////
+
+/*
+ * Feedback controller that raises or lowers the number of parallel instances during a batch, based on the
+ * measured CPU utilization, memory load, the write throughput and the free space of the temp drive.
+ * The number of instances never exceeds the given maximum, i.e. the user's choice or the number of cores.
+ */
+class ConcurrencyController
+{
+public:
+	enum Decision
+	{
+		Decision_None = 0,
+		Decision_CpuIdle = 1,
+		Decision_MemoryPressure = 2,
+		Decision_LowDiskSpace = 3,
+		Decision_DiskBusy = 4
+	};
+
+	ConcurrencyController(const unsigned int &initial, const unsigned int &maximum);
+	~ConcurrencyController(void);
+
+	void setCpuUsage(const double &usage);
+	void setMemoryLoad(const double &load);
+	void setFreeSpace(const quint64 &freeSpace);
+	void setThroughput(const double &throughput);
+
+	Decision update(const bool &jobsPending);
+	unsigned int instances(void) const { return m_instances; }
+
+	double cpuUsage(void) const { return m_cpuUsage; }
+	double memoryLoad(void) const { return m_memoryLoad; }
+	quint64 freeSpace(void) const { return m_freeSpace; }
+	double throughput(void) const { return m_throughput; }
+
+private:
+	bool isDiskSpaceLow(const double &factor) const;
+	bool isDiskBusy(const double &threshold) const;
+
+	const unsigned int m_maximum;
+	unsigned int m_instances;
+
+	double m_cpuUsage;
+	double m_memoryLoad;
+	quint64 m_freeSpace;
+	double m_throughput;
+	double m_peakThroughput;
+
+	unsigned int m_cpuIdleCount;
+	unsigned int m_memoryHighCount;
+	unsigned int m_diskBusyCount;
+	unsigned int m_cooldown;
+	bool m_memoryBlocked;
+};
@@ -28,7 +28,6 @@
 
 //MUtils
 #include <MUtils/Global.h>
-#include <MUtils/OSSupport.h>
 
 //Qt
 #include <QApplication>
@@ -37,14 +36,15 @@
 #include <QFont>
 #include <QTime>
 #include <QTextCodec>
-#include <QTextStream>
 #include <QMutexLocker>
+#include <QHash>
 
 //CRT
 #include <float.h>
 #include <limits>
 
-#define UNQUOTE(STR) STR.split("\"",  QString::SkipEmptyParts).first().trimmed()
+//Progress is reported whenever another chunk of the Cue Sheet has been parsed, the value is given in bytes
+static const int PROGRESS_INTERVAL = 16384;
 
 ////////////////////////////////////////////////////////////
 // Helper Classes
@@ -114,6 +114,100 @@ private:
 	QList<CueSheetTrack*> m_tracks;
 };
 
+////////////////////////////////////////////////////////////
+// Tokenizer
+////////////////////////////////////////////////////////////
+
+typedef enum
+{
+	KEYWORD_NONE = 0,
+	KEYWORD_FILE,
+	KEYWORD_TRACK,
+	KEYWORD_INDEX,
+	KEYWORD_TITLE,
+	KEYWORD_PERFORMER,
+	KEYWORD_REM,
+	KEYWORD_REM_GENRE,
+	KEYWORD_REM_DATE
+}
+cue_keyword_t;
+
+static const struct
+{
+	const char *const name;
+	const cue_keyword_t keyword;
+}
+CUE_KEYWORDS[] =
+{
+	{ "FILE",      KEYWORD_FILE      },
+	{ "TRACK",     KEYWORD_TRACK     },
+	{ "INDEX",     KEYWORD_INDEX     },
+	{ "TITLE",     KEYWORD_TITLE     },
+	{ "PERFORMER", KEYWORD_PERFORMER },
+	{ "REM",       KEYWORD_REM       },
+	{ "GENRE",     KEYWORD_REM_GENRE },
+	{ "DATE",      KEYWORD_REM_DATE  },
+	{ NULL,        KEYWORD_NONE      }
+};
+
+//Split a line into (at most) maxTokens tokens, a token is either a quoted string or a run of non-space characters
+static int tokenizeLine(const QChar *pos, const QChar *const end, QString *const tokens, const int maxTokens)
+{
+	int count = 0;
+	while(pos < end)
+	{
+		if(pos->isSpace())
+		{
+			pos++;
+			continue;
+		}
+		if(count >= maxTokens)
+		{
+			return count + 1; /*too many tokens*/
+		}
+		const bool quoted = ((*pos) == QLatin1Char('"'));
+		const QChar *const begin = quoted ? (++pos) : pos;
+		while((pos < end) && (quoted ? ((*pos) != QLatin1Char('"')) : (!pos->isSpace())))
+		{
+			pos++;
+		}
+		tokens[count++] = QString(begin, pos - begin);
+		if(quoted && (pos < end))
+		{
+			pos++; /*skip closing quote*/
+		}
+	}
+	return count;
+}
+
+//Keywords are looked up case-insensitively, the table is initialized once while holding the model mutex
+static cue_keyword_t lookupKeyword(const QString &token)
+{
+	static QHash<QString, cue_keyword_t> keywords;
+	if(keywords.isEmpty())
+	{
+		for(int i = 0; CUE_KEYWORDS[i].name; i++)
+		{
+			keywords.insert(QString::fromLatin1(CUE_KEYWORDS[i].name), CUE_KEYWORDS[i].keyword);
+		}
+	}
+	return keywords.value(token.toUpper(), KEYWORD_NONE);
+}
+
+//Genres are looked up case-insensitively, the table is initialized once while holding the model mutex
+static const char *lookupGenre(const QString &name)
+{
+	static QHash<QString, const char*> genres;
+	if(genres.isEmpty())
+	{
+		for(int i = 0; g_lamexp_generes[i]; i++)
+		{
+			genres.insert(QString::fromLatin1(g_lamexp_generes[i]).toLower(), g_lamexp_generes[i]);
+		}
+	}
+	return genres.value(name.toLower(), NULL);
+}
+
 ////////////////////////////////////////////////////////////
 // Constructor & Destructor
 ////////////////////////////////////////////////////////////
@@ -468,7 +562,6 @@ int CueSheetModel::parseCueFile(QFile &cueFile, const QDir &baseDir, QCoreApplic
 {
 	cueFile.reset();
 	qDebug("\n[Cue Sheet Import]");
-	bool bForceLatin1 = false;
 
 	//Reject very large files, as parsing might take until forever
 	if(cueFile.size() >= 10485760i64)
@@ -477,32 +570,20 @@ int CueSheetModel::parseCueFile(QFile &cueFile, const QDir &baseDir, QCoreApplic
 		return 2;
 	}
 
-	//Test selected Codepage for decoding errors
+	//Decode the whole file at once, fall back to Latin-1 if the selected Codepage produces decoding errors
 	qDebug("Character encoding is: %s.", codec->name().constData());
-	const QString replacementSymbol = QString(QChar(QChar::ReplacementCharacter));
-	QByteArray testData = cueFile.peek(1048576);
-	if((!testData.isEmpty()) && codec->toUnicode(testData.constData(), testData.size()).contains(replacementSymbol))
+	const QByteArray data = cueFile.readAll();
+	QString text = codec->toUnicode(data.constData(), data.size());
+	if(text.contains(QChar(QChar::ReplacementCharacter)))
 	{
 		qWarning("Decoding error using selected codepage (%s). Enforcing Latin-1.", codec->name().constData());
-		bForceLatin1 = true;
-	}
-	testData.clear();
-
-	//Init text stream
-	QTextStream cueStream(&cueFile);
-	cueStream.setAutoDetectUnicode(false);
-	cueStream.setCodec(bForceLatin1 ? "latin1" : codec->name());
-	cueStream.seek(0i64);
-
-	//Create regular expressions
-	QRegExp rxFile("^FILE\\s+(\"[^\"]+\"|\\S+)\\s+(\\w+)$", Qt::CaseInsensitive);
-	QRegExp rxTrack("^TRACK\\s+(\\d+)\\s(\\w+)$", Qt::CaseInsensitive);
-	QRegExp rxIndex("^INDEX\\s+(\\d+)\\s+([0-9:]+)$", Qt::CaseInsensitive);
-	QRegExp rxTitle("^TITLE\\s+(\"[^\"]+\"|\\S+)$", Qt::CaseInsensitive);
-	QRegExp rxPerformer("^PERFORMER\\s+(\"[^\"]+\"|\\S+)$", Qt::CaseInsensitive);
-	QRegExp rxGenre("^REM\\s+GENRE\\s+(\"[^\"]+\"|\\S+)$", Qt::CaseInsensitive);
-	QRegExp rxYear("^REM\\s+DATE\\s+(\\d+)$", Qt::CaseInsensitive);
-	
+		text = QString::fromLatin1(data.constData(), data.size());
+	}
+	if(text.startsWith(QChar(QChar::ByteOrderMark)))
+	{
+		text.remove(0, 1);
+	}
+
 	bool bPreamble = true;
 	bool bUnsupportedTrack = false;
 
@@ -511,27 +592,67 @@ int CueSheetModel::parseCueFile(QFile &cueFile, const QDir &baseDir, QCoreApplic
 
 	m_albumInfo.reset();
 
+	const QChar *const textBegin = text.constData();
+	const QChar *const textEnd = textBegin + text.length();
+	const qint64 textLength = qMax(text.length(), 1), dataSize = data.size();
+	int nextProgress = 0;
+
+	emit progressMaxChanged(static_cast<unsigned int>(dataSize));
+	emit progressValChanged(0U);
+
 	//Loop over the Cue Sheet until all lines were processed
-	for(int lines = 0; lines < INT_MAX; lines++)
+	QString token[4];
+	const QChar *lineBegin = textBegin;
+	for(int lines = 0; lineBegin < textEnd; lines++)
 	{
-		if(application)
+		const QChar *lineEnd = lineBegin;
+		while((lineEnd < textEnd) && ((*lineEnd) != QLatin1Char('\n')) && ((*lineEnd) != QLatin1Char('\r')))
 		{
-			application->processEvents();
-			if(lines < 128) MUtils::OS::sleep_ms(10);
+			lineEnd++;
 		}
-		
-		if(cueStream.atEnd())
+
+		const int nTokens = tokenizeLine(lineBegin, lineEnd, token, 4);
+		lineBegin = lineEnd;
+		if((lineBegin < textEnd) && ((*lineBegin) == QLatin1Char('\r'))) lineBegin++;
+		if((lineBegin < textEnd) && ((*lineBegin) == QLatin1Char('\n'))) lineBegin++;
+
+		//The text has been decoded as a whole, so the bytes consumed are derived from the characters consumed
+		if((lineBegin - textBegin) >= nextProgress)
 		{
-			qDebug("End of Cue Sheet file.");
-			break;
+			emit progressValChanged(static_cast<unsigned int>((static_cast<qint64>(lineBegin - textBegin) * dataSize) / textLength));
+			if(application) application->processEvents();
+			nextProgress = static_cast<int>(lineBegin - textBegin) + PROGRESS_INTERVAL;
 		}
 
-		QString line = cueStream.readLine().trimmed();
-		
-		/* --- FILE --- */
-		if(rxFile.indexIn(line) >= 0)
+		if(nTokens < 2)
 		{
-			qDebug("%03d File: <%s> <%s>", lines, MUTILS_UTF8(rxFile.cap(1)), MUTILS_UTF8(rxFile.cap(2)));
+			continue;
+		}
+
+		cue_keyword_t keyword = lookupKeyword(token[0]);
+		if(keyword == KEYWORD_REM)
+		{
+			keyword = (nTokens == 3) ? lookupKeyword(token[1]) : KEYWORD_NONE;
+			if((keyword != KEYWORD_REM_GENRE) && (keyword != KEYWORD_REM_DATE))
+			{
+				continue;
+			}
+			token[1] = token[2];
+		}
+		else if((keyword == KEYWORD_REM_GENRE) || (keyword == KEYWORD_REM_DATE))
+		{
+			continue;
+		}
+
+		switch(keyword)
+		{
+		/* --- FILE --- */
+		case KEYWORD_FILE:
+			if(nTokens != 3)
+			{
+				break;
+			}
+			qDebug("%03d File: <%s> <%s>", lines, MUTILS_UTF8(token[1]), MUTILS_UTF8(token[2]));
 			if(currentFile)
 			{
 				if(currentTrack)
@@ -560,28 +681,30 @@ int CueSheetModel::parseCueFile(QFile &cueFile, const QDir &baseDir, QCoreApplic
 			{
 				MUTILS_DELETE(currentTrack);
 			}
-			if(!rxFile.cap(2).compare("WAVE", Qt::CaseInsensitive) || !rxFile.cap(2).compare("MP3", Qt::CaseInsensitive) || !rxFile.cap(2).compare("AIFF", Qt::CaseInsensitive))
+			if((!token[1].trimmed().isEmpty()) && ((!token[2].compare("WAVE", Qt::CaseInsensitive)) || (!token[2].compare("MP3", Qt::CaseInsensitive)) || (!token[2].compare("AIFF", Qt::CaseInsensitive))))
 			{
-				currentFile = new CueSheetFile(baseDir.absoluteFilePath(UNQUOTE(rxFile.cap(1))));
+				currentFile = new CueSheetFile(baseDir.absoluteFilePath(token[1].trimmed()));
 				qDebug("%03d File path: <%s>", lines, currentFile->fileName().toUtf8().constData());
 			}
 			else
 			{
 				bUnsupportedTrack = true;
-				qWarning("%03d Skipping unsupported file of type '%s'.", lines, MUTILS_UTF8(rxFile.cap(2)));
+				qWarning("%03d Skipping unsupported file of type '%s'.", lines, MUTILS_UTF8(token[2]));
 				currentFile = NULL;
 			}
 			bPreamble = false;
 			currentTrack = NULL;
-			continue;
-		}
-		
+			break;
+
 		/* --- TRACK --- */
-		if(rxTrack.indexIn(line) >= 0)
-		{
+		case KEYWORD_TRACK:
+			if(nTokens != 3)
+			{
+				break;
+			}
 			if(currentFile)
 			{
-				qDebug("%03d   Track: <%s> <%s>", lines, MUTILS_UTF8(rxTrack.cap(1)), MUTILS_UTF8(rxTrack.cap(2)));
+				qDebug("%03d   Track: <%s> <%s>", lines, MUTILS_UTF8(token[1]), MUTILS_UTF8(token[2]));
 				if(currentTrack)
 				{
 					if(currentTrack->isValid())
@@ -594,14 +717,16 @@ int CueSheetModel::parseCueFile(QFile &cueFile, const QDir &baseDir, QCoreApplic
 						MUTILS_DELETE(currentTrack);
 					}
 				}
-				if(!rxTrack.cap(2).compare("AUDIO", Qt::CaseInsensitive))
+				bool ok = false;
+				const int trackNo = token[1].toInt(&ok);
+				if(ok && (!token[2].compare("AUDIO", Qt::CaseInsensitive)))
 				{
-					currentTrack = new CueSheetTrack(currentFile, rxTrack.cap(1).toInt());
+					currentTrack = new CueSheetTrack(currentFile, trackNo);
 				}
 				else
 				{
 					bUnsupportedTrack = true;
-					qWarning("%03d   Skipping unsupported track of type '%s'.", lines, MUTILS_UTF8(rxTrack.cap(2)));
+					qWarning("%03d   Skipping unsupported track of type '%s'.", lines, MUTILS_UTF8(token[2]));
 					currentTrack = NULL;
 				}
 			}
@@ -610,104 +735,100 @@ int CueSheetModel::parseCueFile(QFile &cueFile, const QDir &baseDir, QCoreApplic
 				MUTILS_DELETE(currentTrack);
 			}
 			bPreamble = false;
-			continue;
-		}
-		
+			break;
+
 		/* --- INDEX --- */
-		if(rxIndex.indexIn(line) >= 0)
-		{
-			if(currentFile && currentTrack)
+		case KEYWORD_INDEX:
+			if((nTokens == 3) && currentFile && currentTrack)
 			{
-				qDebug("%03d     Index: <%s> <%s>", lines, MUTILS_UTF8(rxIndex.cap(1)), MUTILS_UTF8(rxIndex.cap(2)));
-				if(rxIndex.cap(1).toInt() == 1)
+				qDebug("%03d     Index: <%s> <%s>", lines, MUTILS_UTF8(token[1]), MUTILS_UTF8(token[2]));
+				bool ok = false;
+				if((token[1].toInt(&ok) == 1) && ok)
 				{
-					currentTrack->setStartIndex(parseTimeIndex(rxIndex.cap(2)));
+					currentTrack->setStartIndex(parseTimeIndex(token[2]));
 				}
 			}
-			continue;
-		}
+			break;
 
 		/* --- TITLE --- */
-		if(rxTitle.indexIn(line) >= 0)
-		{
+		case KEYWORD_TITLE:
+			if(nTokens != 2)
+			{
+				break;
+			}
 			if(bPreamble)
 			{
-				m_albumInfo.setAlbum(UNQUOTE(rxTitle.cap(1)).simplified());
+				m_albumInfo.setAlbum(token[1].simplified());
 			}
 			else if(currentFile && currentTrack)
 			{
-				qDebug("%03d     Title: <%s>", lines, MUTILS_UTF8(rxTitle.cap(1)));
-				currentTrack->metaInfo().setTitle(UNQUOTE(rxTitle.cap(1)).simplified());
+				qDebug("%03d     Title: <%s>", lines, MUTILS_UTF8(token[1]));
+				currentTrack->metaInfo().setTitle(token[1].simplified());
 			}
-			continue;
-		}
+			break;
 
 		/* --- PERFORMER --- */
-		if(rxPerformer.indexIn(line) >= 0)
-		{
+		case KEYWORD_PERFORMER:
+			if(nTokens != 2)
+			{
+				break;
+			}
 			if(bPreamble)
 			{
-				m_albumInfo.setArtist(UNQUOTE(rxPerformer.cap(1)).simplified());
+				m_albumInfo.setArtist(token[1].simplified());
 			}
 			else if(currentFile && currentTrack)
 			{
-				qDebug("%03d     Title: <%s>", lines, MUTILS_UTF8(rxPerformer.cap(1)));
-				currentTrack->metaInfo().setArtist(UNQUOTE(rxPerformer.cap(1)).simplified());
+				qDebug("%03d     Performer: <%s>", lines, MUTILS_UTF8(token[1]));
+				currentTrack->metaInfo().setArtist(token[1].simplified());
 			}
-			continue;
-		}
+			break;
 
 		/* --- GENRE --- */
-		if(rxGenre.indexIn(line) >= 0)
-		{
-			if(bPreamble)
+		case KEYWORD_REM_GENRE:
+			if(const char *const genre = lookupGenre(token[1].simplified()))
 			{
-				QString temp = UNQUOTE(rxGenre.cap(1)).simplified();
-				for(int i = 0; g_lamexp_generes[i]; i++)
+				if(bPreamble)
 				{
-					if(temp.compare(g_lamexp_generes[i], Qt::CaseInsensitive) == 0)
-					{
-						m_albumInfo.setGenre(QString(g_lamexp_generes[i]));
-						break;
-					}
+					m_albumInfo.setGenre(QString::fromLatin1(genre));
 				}
-			}
-			else if(currentFile && currentTrack)
-			{
-				qDebug("%03d     Genre: <%s>", lines, MUTILS_UTF8(rxGenre.cap(1)));
-				QString temp = UNQUOTE(rxGenre.cap(1).simplified());
-				for(int i = 0; g_lamexp_generes[i]; i++)
+				else if(currentFile && currentTrack)
 				{
-					if(temp.compare(g_lamexp_generes[i], Qt::CaseInsensitive) == 0)
-					{
-						currentTrack->metaInfo().setGenre(QString(g_lamexp_generes[i]));
-						break;
-					}
+					qDebug("%03d     Genre: <%s>", lines, genre);
+					currentTrack->metaInfo().setGenre(QString::fromLatin1(genre));
 				}
 			}
-			continue;
-		}
+			break;
 
 		/* --- YEAR --- */
-		if(rxYear.indexIn(line) >= 0)
-		{
-			if(bPreamble)
-			{
-				bool ok = false;
-				unsigned int temp = rxYear.cap(1).toUInt(&ok);
-				if(ok) m_albumInfo.setYear(temp);
-			}
-			else if(currentFile && currentTrack)
+		case KEYWORD_REM_DATE:
 			{
-				qDebug("%03d     Year: <%s>", lines, MUTILS_UTF8(rxPerformer.cap(1)));
 				bool ok = false;
-				unsigned int temp = rxYear.cap(1).toUInt(&ok);
-				if(ok) currentTrack->metaInfo().setYear(temp);
+				const unsigned int year = token[1].toUInt(&ok);
+				if(!ok)
+				{
+					break;
+				}
+				if(bPreamble)
+				{
+					m_albumInfo.setYear(year);
+				}
+				else if(currentFile && currentTrack)
+				{
+					qDebug("%03d     Year: <%u>", lines, year);
+					currentTrack->metaInfo().setYear(year);
+				}
 			}
-			continue;
+			break;
+
+		default:
+			break;
 		}
 	}
 
+	qDebug("End of Cue Sheet file.");
+	emit progressValChanged(static_cast<unsigned int>(dataSize));
+
 	//Append the very last track/file that is still pending
 	if(currentFile)
 	{
@@ -738,12 +859,6 @@ int CueSheetModel::parseCueFile(QFile &cueFile, const QDir &baseDir, QCoreApplic
 	int nFiles = m_files.count();
 	for(int i = 0; i < nFiles; i++)
 	{
-		if(application)
-		{
-			application->processEvents();
-			MUtils::OS::sleep_ms(10);
-		}
-
 		currentFile = m_files.at(i);
 		int nTracks = currentFile->trackCount();
 		if(nTracks > 1)
@@ -771,11 +886,6 @@ int CueSheetModel::parseCueFile(QFile &cueFile, const QDir &baseDir, QCoreApplic
 
 		for(int i = 0; i < nFiles; i++)
 		{
-			if(application)
-			{
-				application->processEvents();
-				MUtils::OS::sleep_ms(10);
-			}
 			currentFile = m_files.at(i);
 			int nTracks = currentFile->trackCount();
 			if(nTracks > 1)
@@ -822,12 +932,13 @@ int CueSheetModel::parseCueFile(QFile &cueFile, const QDir &baseDir, QCoreApplic
 
 double CueSheetModel::parseTimeIndex(const QString &index)
 {
-	QRegExp rxTimeIndex("\\s*(\\d+)\\s*:\\s*(\\d+)\\s*:\\s*(\\d+)\\s*");
-	
-	if(rxTimeIndex.indexIn(index) >= 0)
+	//Time index is given as "mm:ss:ff", where "ff" are CD frames (75 per second)
+	const QStringList parts = index.split(QLatin1Char(':'));
+	if(parts.count() == 3)
 	{
-		int time[3];
-		if(MUtils::regexp_parse_int32(rxTimeIndex, time, 3))
+		bool ok[3] = { false, false, false };
+		const int time[3] = { parts[0].toInt(&ok[0]), parts[1].toInt(&ok[1]), parts[2].toInt(&ok[2]) };
+		if(ok[0] && ok[1] && ok[2])
 		{
 			return static_cast<double>(60 * time[0]) + static_cast<double>(time[1]) + (static_cast<double>(time[2]) / 75.0);
 		}
@@ -71,6 +71,10 @@ public:
 	//Cue Sheet functions
 	int loadCueSheet(const QString &cueFile, QCoreApplication *application = NULL, QTextCodec *forceCodec= NULL);
 
+signals:
+	void progressValChanged(unsigned int);
+	void progressMaxChanged(unsigned int);
+
 private:
 	int parseCueFile(QFile &cueFile, const QDir &baseDir, QCoreApplication *application, const QTextCodec *codec);
 	double parseTimeIndex(const QString &index);
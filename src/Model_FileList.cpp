@@ -40,6 +40,12 @@
 #define CHECK_HDR(STR,NAM) (!(STR).compare((NAM), Qt::CaseInsensitive))
 #define MAKE_KEY(PATH) (QDir::fromNativeSeparators(PATH).toLower())
 
+//Tracks of a Cue Sheet share the same source file, so they are distinguished by their offset
+static inline QString MAKE_FILE_KEY(const AudioFileModel &file)
+{
+	return file.hasSourceRange() ? QString("%1#%2").arg(MAKE_KEY(file.filePath()), QString::number(file.sourceOffset())) : MAKE_KEY(file.filePath());
+}
+
 static inline int LOG10(int x)
 {
 	int ret = 1;
@@ -156,7 +162,7 @@ void FileListModel::addFile(const QString &filePath)
 
 void FileListModel::addFile(const AudioFileModel &file)
 {
-	const QString key = MAKE_KEY(file.filePath()); 
+	const QString key = MAKE_FILE_KEY(file); 
 	const bool flag = (!m_blockUpdates);
 
 	if(!m_fileStore.contains(key))
@@ -169,18 +175,83 @@ void FileListModel::addFile(const AudioFileModel &file)
 	}
 }
 
+void FileListModel::addFiles(const QList<AudioFileModel> &files)
+{
+	const bool flag = (!m_blockUpdates);
+	QList<QString> newKeys;
+
+	for(QList<AudioFileModel>::ConstIterator iter = files.constBegin(); iter != files.constEnd(); iter++)
+	{
+		const QString key = MAKE_FILE_KEY(*iter);
+		if(!m_fileStore.contains(key))
+		{
+			m_fileStore.insert(key, *iter);
+			newKeys.append(key);
+		}
+	}
+
+	if(!newKeys.isEmpty())
+	{
+		if(flag) beginInsertRows(QModelIndex(), m_fileList.count(), m_fileList.count() + newKeys.count() - 1);
+		m_fileList.append(newKeys);
+		if(flag) endInsertRows();
+		emit rowAppended();
+	}
+}
+
 bool FileListModel::removeFile(const QModelIndex &index)
 {
-	const int row = index.row();
-	if(row >= 0 && row < m_fileList.count())
+	return (removeFiles(QModelIndexList() << index) > 0);
+}
+
+/*
+ * Remove all given rows, each contiguous range is erased in one call and with a single signal (from the bottom up).
+ * If updates are blocked, no signals are required, so the remaining rows are compacted in a single pass instead.
+ */
+int FileListModel::removeFiles(const QModelIndexList &indexes)
+{
+	const QList<QPair<int, int>> ranges = makeRanges(indexes, m_fileList.count());
+	int removedCount = 0;
+
+	if(m_blockUpdates)
 	{
-		beginResetModel();
-		m_fileStore.remove(m_fileList.at(row));
-		m_fileList.removeAt(row);
-		endResetModel();
-		return true;
+		QList<QString> remaining;
+		remaining.reserve(m_fileList.count());
+		int row = 0;
+		for(QList<QPair<int, int>>::ConstIterator iter = ranges.constBegin(); iter != ranges.constEnd(); iter++)
+		{
+			while(row < iter->first)
+			{
+				remaining.append(m_fileList.at(row++));
+			}
+			while(row <= iter->second)
+			{
+				m_fileStore.remove(m_fileList.at(row++));
+			}
+			removedCount += (iter->second - iter->first + 1);
+		}
+		while(row < m_fileList.count())
+		{
+			remaining.append(m_fileList.at(row++));
+		}
+		m_fileList.swap(remaining);
+		return removedCount;
 	}
-	return false;
+
+	for(int i = ranges.count() - 1; i >= 0; i--)
+	{
+		const int first = ranges.at(i).first, last = ranges.at(i).second;
+		beginRemoveRows(QModelIndex(), first, last);
+		for(int row = first; row <= last; row++)
+		{
+			m_fileStore.remove(m_fileList.at(row));
+		}
+		m_fileList.erase(m_fileList.begin() + first, m_fileList.begin() + (last + 1));
+		endRemoveRows();
+		removedCount += (last - first + 1);
+	}
+
+	return removedCount;
 }
 
 void FileListModel::clearFiles(void)
@@ -195,9 +266,11 @@ bool FileListModel::moveFile(const QModelIndex &index, int delta)
 {
 	if(delta != 0 && index.row() >= 0 && index.row() < m_fileList.count() && index.row() + delta >= 0 && index.row() + delta < m_fileList.count())
 	{
-		beginResetModel();
-		m_fileList.move(index.row(), index.row() + delta);
-		endResetModel();
+		const int row = index.row(), target = row + delta;
+		const bool flag = (!m_blockUpdates);
+		if(flag) beginMoveRows(QModelIndex(), row, row, QModelIndex(), (delta > 0) ? (target + 1) : target);
+		m_fileList.move(row, target);
+		if(flag) endMoveRows();
 		return true;
 	}
 	else
@@ -206,6 +279,38 @@ bool FileListModel::moveFile(const QModelIndex &index, int delta)
 	}
 }
 
+/*
+ * Move all given rows up (delta < 0) or down (delta > 0) by one position, keeping their relative order
+ */
+bool FileListModel::moveFiles(const QModelIndexList &indexes, int delta)
+{
+	const QList<QPair<int, int>> ranges = makeRanges(indexes, m_fileList.count());
+	if((ranges.isEmpty()) || ((delta != -1) && (delta != 1)) || ((delta < 0) && (ranges.first().first < 1)) || ((delta > 0) && (ranges.last().second >= m_fileList.count() - 1)))
+	{
+		return false;
+	}
+
+	//Moving a range by one position is the same as moving its neighbour to the other side
+	const bool flag = (!m_blockUpdates);
+	for(int i = 0; i < ranges.count(); i++)
+	{
+		const QPair<int, int> &range = ranges.at((delta < 0) ? i : (ranges.count() - 1 - i));
+		if(delta < 0)
+		{
+			if(flag) beginMoveRows(QModelIndex(), range.first, range.second, QModelIndex(), range.first - 1);
+			m_fileList.move(range.first - 1, range.second);
+		}
+		else
+		{
+			if(flag) beginMoveRows(QModelIndex(), range.first, range.second, QModelIndex(), range.second + 2);
+			m_fileList.move(range.second + 1, range.first);
+		}
+		if(flag) endMoveRows();
+	}
+
+	return true;
+}
+
 const AudioFileModel &FileListModel::getFile(const QModelIndex &index)
 {
 	if(index.row() >= 0 && index.row() < m_fileList.count())
@@ -229,13 +334,12 @@ bool FileListModel::setFile(const QModelIndex &index, const AudioFileModel &audi
 	if(index.row() >= 0 && index.row() < m_fileList.count())
 	{
 		const QString oldKey = m_fileList.at(index.row());
-		const QString newKey = MAKE_KEY(audioFile.filePath());
+		const QString newKey = MAKE_FILE_KEY(audioFile);
 		
-		beginResetModel();
 		m_fileList.replace(index.row(), newKey);
 		m_fileStore.remove(oldKey);
 		m_fileStore.insert(newKey, audioFile);
-		endResetModel();
+		if(!m_blockUpdates) emit dataChanged(this->index(index.row(), 0), this->index(index.row(), columnCount() - 1));
 		return true;
 	}
 	else
@@ -521,6 +625,35 @@ bool FileListModel::checkArray(const bool *a, const bool val, size_t len)
 	return false;
 }
 
+/*
+ * Convert a list of indexes into sorted, non-overlapping ranges of rows (first, last)
+ */
+QList<QPair<int, int>> FileListModel::makeRanges(const QModelIndexList &indexes, const int &rowCount)
+{
+	QList<int> rows;
+	for(QModelIndexList::ConstIterator iter = indexes.constBegin(); iter != indexes.constEnd(); iter++)
+	{
+		if((iter->row() >= 0) && (iter->row() < rowCount))
+		{
+			rows << iter->row();
+		}
+	}
+	qSort(rows);
+
+	QList<QPair<int, int>> ranges;
+	for(QList<int>::ConstIterator iter = rows.constBegin(); iter != rows.constEnd(); iter++)
+	{
+		if((!ranges.isEmpty()) && ((*iter) <= ranges.last().second + 1))
+		{
+			ranges.last().second = qMax(ranges.last().second, *iter);
+			continue;
+		}
+		ranges << qMakePair(*iter, *iter);
+	}
+
+	return ranges;
+}
+
 QString FileListModel::int2str(const int &value) const
 {
 	if(m_fileList.count() < 10)
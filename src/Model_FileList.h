@@ -26,6 +26,7 @@
 
 #include <QAbstractTableModel>
 #include <QIcon>
+#include <QPair>
 
 class FileListModel : public QAbstractTableModel
 {
@@ -43,8 +44,10 @@ public:
 
 	//Edit functions
 	bool removeFile(const QModelIndex &index);
+	int removeFiles(const QModelIndexList &indexes);
 	void clearFiles(void);
 	bool moveFile(const QModelIndex &index, int delta);
+	bool moveFiles(const QModelIndexList &indexes, int delta);
 	const AudioFileModel &getFile(const QModelIndex &index);
 	bool setFile(const QModelIndex &index, const AudioFileModel &audioFile);
 	AudioFileModel &operator[] (const QModelIndex &index);
@@ -78,6 +81,7 @@ public:
 public slots:
 	void addFile(const QString &filePath);
 	void addFile(const AudioFileModel &file);
+	void addFiles(const QList<AudioFileModel> &files);
 
 signals:
 	void rowAppended(void);
@@ -89,5 +93,6 @@ private:
 	const QIcon m_fileIcon;
 
 	QString int2str(const int &value) const;
+	static QList<QPair<int, int>> makeRanges(const QModelIndexList &indexes, const int &rowCount);
 	static bool checkArray(const bool *a, const bool val, size_t len);
 };
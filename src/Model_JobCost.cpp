@@ -0,0 +1,232 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+#include "Model_JobCost.h"
+
+//Internal
+#include "Global.h"
+#include "Model_JobStatistics.h"
+
+//MUtils
+#include <MUtils/Global.h>
+
+//Qt
+#include <QApplication>
+#include <QDesktopServices>
+#include <QSettings>
+#include <QFileInfo>
+#include <QDir>
+
+//CRT
+#include <algorithm>
+
+////////////////////////////////////////////////////////////
+// Constants
+////////////////////////////////////////////////////////////
+
+static const double DEFAULT_FACTOR = 0.05;   //initial encoder realtime factor, until we have learned a better one
+static const double MIN_FACTOR     = 0.0001;
+static const double MAX_FACTOR     = 10.0;
+static const double DECODE_FACTOR  = 0.02;   //decoding overhead, relative to the duration
+static const double FILTER_FACTOR  = 0.03;   //overhead per filter step, relative to the duration
+static const double JOB_OVERHEAD   = 0.5;    //fixed overhead per job (process creation, file operations), in seconds
+static const double MIN_WEIGHT     = 0.2;    //minimum weight of a new sample in the moving average
+
+////////////////////////////////////////////////////////////
+// Constructor & Destructor
+////////////////////////////////////////////////////////////
+
+JobCostModel::JobCostModel(const int encoderId)
+:
+	m_encoderId(encoderId),
+	m_encoderFactor(DEFAULT_FACTOR),
+	m_encoderSamples(0U),
+	m_dirty(false)
+{
+	load();
+}
+
+JobCostModel::~JobCostModel(void)
+{
+	save();
+}
+
+////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////
+
+double JobCostModel::estimate(const double &duration, const bool &decode, const unsigned int &filterCount) const
+{
+	double factor = m_encoderFactor;
+	if(decode)
+	{
+		factor += DECODE_FACTOR;
+	}
+	factor += FILTER_FACTOR * static_cast<double>(filterCount);
+	return JOB_OVERHEAD + (qMax(0.0, duration) * factor);
+}
+
+void JobCostModel::jobStarted(const QUuid &jobId, const double &duration, const bool &decode, const unsigned int &filterCount)
+{
+	job_info_t &jobInfo = m_runningJobs[jobId];
+	jobInfo.duration = duration;
+	jobInfo.decode = decode;
+	jobInfo.filterCount = filterCount;
+}
+
+/*
+ * Learns from the time the job actually spent in its stages. The wall-clock time since admission is not used,
+ * because it includes the waiting for stage slots (and GUI latency), which grows with the queue depth.
+ */
+void JobCostModel::jobFinished(const QUuid &jobId, const JobStatistics &statistics)
+{
+	if(!m_runningJobs.contains(jobId))
+	{
+		return;
+	}
+
+	const job_info_t jobInfo = m_runningJobs.take(jobId);
+	if((statistics.result() <= 0) || (jobInfo.duration < 1.0))
+	{
+		return; /*failed, skipped or unknown duration, nothing to learn*/
+	}
+
+	//Compute the encoder factor that would have predicted the observed time
+	double sample = 0.0;
+	const qint64 streamTime = statistics.stageTime(JobStatistics::Stage_Stream);
+	if(streamTime > 0)
+	{
+		//Streaming mode, decoder, filters and encoder were running as a single pipeline
+		sample = (static_cast<double>(streamTime) / 1000.0 / jobInfo.duration) - FILTER_FACTOR * static_cast<double>(jobInfo.filterCount);
+		if(jobInfo.decode)
+		{
+			sample -= DECODE_FACTOR;
+		}
+	}
+	else
+	{
+		const qint64 encodeTime = statistics.stageTime(JobStatistics::Stage_Encode);
+		if(encodeTime <= 0)
+		{
+			return; /*no encoding time recorded, nothing to learn*/
+		}
+		sample = static_cast<double>(encodeTime) / 1000.0 / jobInfo.duration;
+	}
+	sample = qBound(MIN_FACTOR, sample, MAX_FACTOR);
+
+	//Update the moving average
+	const double weight = qMax(MIN_WEIGHT, 1.0 / static_cast<double>(m_encoderSamples + 1U));
+	m_encoderFactor = qBound(MIN_FACTOR, ((1.0 - weight) * m_encoderFactor) + (weight * sample), MAX_FACTOR);
+	m_encoderSamples++;
+	m_dirty = true;
+}
+
+void JobCostModel::jobDiscarded(const QUuid &jobId)
+{
+	m_runningJobs.remove(jobId);
+}
+
+bool JobCostModel::save(void)
+{
+	if(!m_dirty)
+	{
+		return true;
+	}
+
+	const QString fileName = modelFile();
+	if(fileName.isEmpty())
+	{
+		return false;
+	}
+
+	QSettings settings(fileName, QSettings::IniFormat);
+	settings.beginGroup(QString().sprintf("Encoder_%d", m_encoderId));
+	settings.setValue("Factor", m_encoderFactor);
+	settings.setValue("Samples", m_encoderSamples);
+	settings.endGroup();
+	settings.sync();
+
+	if(settings.status() != QSettings::NoError)
+	{
+		qWarning("JobCostModel: Failed to write \"%s\" file!", MUTILS_UTF8(fileName));
+		return false;
+	}
+
+	qDebug("JobCostModel: Encoder #%d factor is %.4f (%u samples)", m_encoderId, m_encoderFactor, m_encoderSamples);
+	m_dirty = false;
+	return true;
+}
+
+/*
+ * Simulates greedy list scheduling of the given jobs (in the given order) on "threadCount" parallel threads
+ */
+double JobCostModel::makespan(const QVector<double> &costs, const unsigned int &threadCount)
+{
+	QVector<double> finishTime(qMax(1U, threadCount), 0.0);
+	for(QVector<double>::ConstIterator iter = costs.constBegin(); iter != costs.constEnd(); iter++)
+	{
+		*std::min_element(finishTime.begin(), finishTime.end()) += (*iter);
+	}
+	return *std::max_element(finishTime.constBegin(), finishTime.constEnd());
+}
+
+////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////
+
+void JobCostModel::load(void)
+{
+	const QString fileName = modelFile();
+	if(fileName.isEmpty() || (!QFileInfo(fileName).exists()))
+	{
+		return;
+	}
+
+	QSettings settings(fileName, QSettings::IniFormat);
+	settings.beginGroup(QString().sprintf("Encoder_%d", m_encoderId));
+
+	bool okay[2] = { false, false };
+	const double factor = settings.value("Factor", DEFAULT_FACTOR).toDouble(&okay[0]);
+	const quint32 samples = settings.value("Samples", 0U).toUInt(&okay[1]);
+	if(okay[0] && okay[1] && (samples > 0U))
+	{
+		m_encoderFactor = qBound(MIN_FACTOR, factor, MAX_FACTOR);
+		m_encoderSamples = samples;
+	}
+
+	settings.endGroup();
+}
+
+QString JobCostModel::modelFile(void)
+{
+	if(!lamexp_version_portable())
+	{
+		const QString dataPath = QDesktopServices::storageLocation(QDesktopServices::DataLocation);
+		if((!dataPath.isEmpty()) && QDir().mkpath(dataPath))
+		{
+			return QString("%1/jobcost.ini").arg(QDir(dataPath).canonicalPath());
+		}
+		return QString();
+	}
+
+	const QFileInfo appPath(QApplication::applicationFilePath());
+	return QString("%1/%2.jobcost.ini").arg(appPath.absolutePath(), appPath.completeBaseName());
+}
@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <QString>
+#include <QHash>
+#include <QUuid>
+#include <QVector>
+
+class JobStatistics;
+
+////////////////////////////////////////////////////////////
+// Job Cost Model
+////////////////////////////////////////////////////////////
+
+/*
+ * Estimates the processing time of an encoding job as "duration x realtime factor" of the selected encoder,
+ * plus the decoding and filtering overhead. Per-encoder factors are learned from the stage timing of the completed
+ * jobs and are persisted across sessions, so that the pending jobs can be started "longest processing time first".
+ */
+class JobCostModel
+{
+public:
+	JobCostModel(const int encoderId);
+	~JobCostModel(void);
+
+	double estimate(const double &duration, const bool &decode, const unsigned int &filterCount) const;
+	void jobStarted(const QUuid &jobId, const double &duration, const bool &decode, const unsigned int &filterCount);
+	void jobFinished(const QUuid &jobId, const JobStatistics &statistics);
+	void jobDiscarded(const QUuid &jobId);
+	bool save(void);
+
+	static double makespan(const QVector<double> &costs, const unsigned int &threadCount);
+
+private:
+	typedef struct
+	{
+		double duration;
+		bool decode;
+		unsigned int filterCount;
+	}
+	job_info_t;
+
+	void load(void);
+
+	static QString modelFile(void);
+
+	const int m_encoderId;
+	double m_encoderFactor;
+	quint32 m_encoderSamples;
+	bool m_dirty;
+	QHash<QUuid, job_info_t> m_runningJobs;
+};
@@ -0,0 +1,242 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+#include "Model_JobStatistics.h"
+
+//Internal
+#include "Global.h"
+
+//MUtils
+#include <MUtils/Global.h>
+
+//Qt
+#include <QFile>
+#include <QDir>
+#include <QTextStream>
+#include <QStringList>
+
+////////////////////////////////////////////////////////////
+// Constants
+////////////////////////////////////////////////////////////
+
+static const char *const STAGE_NAMES[] =
+{
+	"decode", "analyze", "filter", "encode", "stream"
+};
+
+////////////////////////////////////////////////////////////
+// Constructor
+////////////////////////////////////////////////////////////
+
+JobStatistics::JobStatistics(void)
+:
+	m_bytesIn(0),
+	m_bytesOut(0),
+	m_duration(0),
+	m_result(0),
+	m_totalTime(0),
+	m_queueWait(0)
+{
+}
+
+////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////
+
+void JobStatistics::addStage(const Stage &stage, const QString &name, const qint64 &msec)
+{
+	stage_t entry;
+	entry.stage = stage;
+	entry.name = name;
+	entry.msec = msec;
+	m_stages.append(entry);
+}
+
+qint64 JobStatistics::stageTime(const Stage &stage) const
+{
+	qint64 msec = 0;
+	for(QList<stage_t>::ConstIterator iter = m_stages.constBegin(); iter != m_stages.constEnd(); iter++)
+	{
+		if(iter->stage == stage) msec += iter->msec;
+	}
+	return msec;
+}
+
+double JobStatistics::realtimeFactor(void) const
+{
+	return (m_totalTime > 0) ? (static_cast<double>(m_duration) / (static_cast<double>(m_totalTime) / 1000.0)) : 0.0;
+}
+
+QString JobStatistics::toText(void) const
+{
+	QStringList lines;
+	lines << QString::fromLatin1("Job statistics:");
+	for(QList<stage_t>::ConstIterator iter = m_stages.constBegin(); iter != m_stages.constEnd(); iter++)
+	{
+		const QString name = iter->name.isEmpty() ? QString::fromLatin1(STAGE_NAMES[iter->stage]) : QString("%1 (%2)").arg(QString::fromLatin1(STAGE_NAMES[iter->stage]), iter->name);
+		lines << QString().sprintf("  %-32s %10.3f sec", MUTILS_UTF8(name), static_cast<double>(iter->msec) / 1000.0);
+	}
+	lines << QString().sprintf("  %-32s %10.3f sec", "queue wait", static_cast<double>(m_queueWait) / 1000.0);
+	lines << QString().sprintf("  %-32s %10.3f sec", "total", static_cast<double>(m_totalTime) / 1000.0);
+	lines << QString().sprintf("  %-32s %10u sec", "audio duration", m_duration);
+	lines << QString().sprintf("  %-32s %10.2fx", "realtime factor", realtimeFactor());
+	lines << QString().sprintf("  %-32s %10llu bytes", "input size", m_bytesIn);
+	lines << QString().sprintf("  %-32s %10llu bytes", "output size", m_bytesOut);
+	return lines.join("\n");
+}
+
+QString JobStatistics::toCsv(void) const
+{
+	QStringList fields;
+	fields << csvQuote(QDir::toNativeSeparators(m_sourceFile));
+	fields << csvQuote(QDir::toNativeSeparators(m_outputFile));
+	fields << resultName(m_result);
+	fields << QString::number(m_duration);
+	fields << QString::number(m_bytesIn);
+	fields << QString::number(m_bytesOut);
+	fields << QString::number(m_queueWait);
+	for(int stage = Stage_Decode; stage <= Stage_Stream; stage++)
+	{
+		fields << QString::number(stageTime(static_cast<Stage>(stage)));
+	}
+	fields << QString::number(m_totalTime);
+	fields << QString().sprintf("%.3f", realtimeFactor());
+	return fields.join(",");
+}
+
+QString JobStatistics::toJson(void) const
+{
+	QStringList stages;
+	for(QList<stage_t>::ConstIterator iter = m_stages.constBegin(); iter != m_stages.constEnd(); iter++)
+	{
+		stages << QString("{ \"stage\": \"%1\", \"name\": %2, \"msec\": %3 }").arg(QString::fromLatin1(STAGE_NAMES[iter->stage]), jsonQuote(iter->name), QString::number(iter->msec));
+	}
+
+	QStringList fields;
+	fields << QString("\"source\": %1").arg(jsonQuote(QDir::toNativeSeparators(m_sourceFile)));
+	fields << QString("\"output\": %1").arg(jsonQuote(QDir::toNativeSeparators(m_outputFile)));
+	fields << QString("\"result\": \"%1\"").arg(resultName(m_result));
+	fields << QString("\"duration_sec\": %1").arg(QString::number(m_duration));
+	fields << QString("\"bytes_in\": %1").arg(QString::number(m_bytesIn));
+	fields << QString("\"bytes_out\": %1").arg(QString::number(m_bytesOut));
+	fields << QString("\"queue_wait_msec\": %1").arg(QString::number(m_queueWait));
+	fields << QString("\"total_msec\": %1").arg(QString::number(m_totalTime));
+	fields << QString("\"realtime_factor\": %1").arg(QString().sprintf("%.3f", realtimeFactor()));
+	fields << QString("\"stages\": [%1]").arg(stages.join(", "));
+	return QString("{ %1 }").arg(fields.join(", "));
+}
+
+/*
+ * Writes the statistics of all jobs to "<baseName>.csv" and "<baseName>.json"
+ */
+bool JobStatistics::exportBatch(const QList<JobStatistics> &statistics, const QString &baseName)
+{
+	bool success = true;
+
+	QFile csvFile(QString("%1.csv").arg(baseName));
+	if(csvFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		QTextStream stream(&csvFile);
+		stream.setCodec("UTF-8");
+		stream << "source,output,result,duration_sec,bytes_in,bytes_out,queue_wait_msec,decode_msec,analyze_msec,filter_msec,encode_msec,stream_msec,total_msec,realtime_factor\r\n";
+		for(QList<JobStatistics>::ConstIterator iter = statistics.constBegin(); iter != statistics.constEnd(); iter++)
+		{
+			stream << iter->toCsv() << "\r\n";
+		}
+		stream.flush();
+		success = success && (stream.status() == QTextStream::Ok);
+		csvFile.close();
+	}
+	else
+	{
+		qWarning("Failed to write statistics file: %s", MUTILS_UTF8(csvFile.fileName()));
+		success = false;
+	}
+
+	QFile jsonFile(QString("%1.json").arg(baseName));
+	if(jsonFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		QTextStream stream(&jsonFile);
+		stream.setCodec("UTF-8");
+		stream << "{\r\n\t\"application\": " << jsonQuote(QString().sprintf("LameXP v%u.%02u (Build #%u)", lamexp_version_major(), lamexp_version_minor(), lamexp_version_build())) << ",\r\n";
+		stream << "\t\"jobs\":\r\n\t[\r\n";
+		for(int i = 0; i < statistics.count(); i++)
+		{
+			stream << "\t\t" << statistics.at(i).toJson() << ((i + 1 < statistics.count()) ? ",\r\n" : "\r\n");
+		}
+		stream << "\t]\r\n}\r\n";
+		stream.flush();
+		success = success && (stream.status() == QTextStream::Ok);
+		jsonFile.close();
+	}
+	else
+	{
+		qWarning("Failed to write statistics file: %s", MUTILS_UTF8(jsonFile.fileName()));
+		success = false;
+	}
+
+	return success;
+}
+
+////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////
+
+QString JobStatistics::csvQuote(const QString &text)
+{
+	QString quoted(text);
+	return QString("\"%1\"").arg(quoted.replace(QChar('"'), QLatin1String("\"\"")));
+}
+
+QString JobStatistics::jsonQuote(const QString &text)
+{
+	QString quoted;
+	quoted.reserve(text.length() + 2);
+	quoted.append(QChar('"'));
+	for(QString::ConstIterator iter = text.constBegin(); iter != text.constEnd(); iter++)
+	{
+		const ushort c = iter->unicode();
+		switch(c)
+		{
+		case '"':  quoted.append(QLatin1String("\\\"")); break;
+		case '\\': quoted.append(QLatin1String("\\\\")); break;
+		case '\n': quoted.append(QLatin1String("\\n"));  break;
+		case '\r': quoted.append(QLatin1String("\\r"));  break;
+		case '\t': quoted.append(QLatin1String("\\t"));  break;
+		default:
+			if(c < 0x20)
+			{
+				quoted.append(QString().sprintf("\\u%04x", c));
+			}
+			else
+			{
+				quoted.append(*iter);
+			}
+		}
+	}
+	quoted.append(QChar('"'));
+	return quoted;
+}
+
+QString JobStatistics::resultName(const int &result)
+{
+	return QString::fromLatin1((result > 0) ? "success" : ((result < 0) ? "skipped" : "failed"));
+}
@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <QString>
+#include <QList>
+#include <QMetaType>
+
+////////////////////////////////////////////////////////////
+// Job Statistics
+////////////////////////////////////////////////////////////
+
+class JobStatistics
+{
+public:
+	JobStatistics(void);
+
+	enum Stage
+	{
+		Stage_Decode = 0,
+		Stage_Analyze = 1,
+		Stage_Filter = 2,
+		Stage_Encode = 3,
+		Stage_Stream = 4
+	};
+
+	//Setters
+	void setSourceFile(const QString &sourceFile, const quint64 &bytesIn) { m_sourceFile = sourceFile; m_bytesIn = bytesIn; }
+	void setOutputFile(const QString &outputFile, const quint64 &bytesOut) { m_outputFile = outputFile; m_bytesOut = bytesOut; }
+	void setDuration(const unsigned int &duration) { m_duration = duration; }
+	void setResult(const int &result) { m_result = result; }
+	void setTotalTime(const qint64 &msec) { m_totalTime = msec; }
+	void addQueueWait(const qint64 &msec) { m_queueWait += msec; }
+	void addStage(const Stage &stage, const QString &name, const qint64 &msec);
+
+	//Getters
+	const QString &sourceFile(void) const { return m_sourceFile; }
+	const QString &outputFile(void) const { return m_outputFile; }
+	unsigned int duration(void) const { return m_duration; }
+	int result(void) const { return m_result; }
+	qint64 totalTime(void) const { return m_totalTime; }
+	qint64 queueWait(void) const { return m_queueWait; }
+	qint64 stageTime(const Stage &stage) const;
+	double realtimeFactor(void) const;
+
+	//Formatting
+	QString toText(void) const;
+	QString toCsv(void) const;
+	QString toJson(void) const;
+
+	//Export
+	static bool exportBatch(const QList<JobStatistics> &statistics, const QString &baseName);
+
+private:
+	typedef struct
+	{
+		Stage stage;
+		QString name;
+		qint64 msec;
+	}
+	stage_t;
+
+	static QString csvQuote(const QString &text);
+	static QString jsonQuote(const QString &text);
+	static QString resultName(const int &result);
+
+	QString m_sourceFile;
+	QString m_outputFile;
+	quint64 m_bytesIn;
+	quint64 m_bytesOut;
+	unsigned int m_duration;
+	int m_result;
+	qint64 m_totalTime;
+	qint64 m_queueWait;
+	QList<stage_t> m_stages;
+};
+
+Q_DECLARE_METATYPE(JobStatistics)
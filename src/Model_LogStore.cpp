@@ -0,0 +1,175 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Model_LogStore.h"
+
+//MUtils
+#include <MUtils/Global.h>
+
+//Qt
+#include <QFile>
+#include <QDir>
+
+////////////////////////////////////////////////////////////
+// Constants
+////////////////////////////////////////////////////////////
+
+static const int     JOB_BUFFER_LIMIT   = 64 * 1024;                     //per job
+static const quint64 TOTAL_BUFFER_LIMIT = 8ui64 * 1024ui64 * 1024ui64;  //all jobs
+
+////////////////////////////////////////////////////////////
+// Constructor & Destructor
+////////////////////////////////////////////////////////////
+
+LogStore::LogStore(const QString &tempFolder)
+:
+	m_tempFolder(tempFolder),
+	m_spillFile(NULL),
+	m_spillFailed(false),
+	m_bufferSize(0),
+	m_bufferPeak(0),
+	m_spilledBytes(0)
+{
+}
+
+LogStore::~LogStore(void)
+{
+	if(m_spillFile)
+	{
+		m_spillFile->close();
+		m_spillFile->remove();
+		MUTILS_DELETE(m_spillFile);
+	}
+}
+
+////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////
+
+void LogStore::append(const QUuid &jobId, const QString &line)
+{
+	job_log_t &log = m_logs[jobId];
+	appendUtf8(log, line);
+	checkLimits(log);
+}
+
+void LogStore::append(const QUuid &jobId, const QStringList &lines)
+{
+	job_log_t &log = m_logs[jobId];
+	for(QStringList::ConstIterator iter = lines.constBegin(); iter != lines.constEnd(); iter++)
+	{
+		appendUtf8(log, *iter);
+	}
+	checkLimits(log);
+}
+
+QStringList LogStore::read(const QUuid &jobId) const
+{
+	QHash<QUuid, job_log_t>::ConstIterator iter = m_logs.constFind(jobId);
+	if(iter == m_logs.constEnd())
+	{
+		return QStringList();
+	}
+
+	//Collect the spilled chunks first, then the content that is still buffered
+	QByteArray data;
+	for(QVector<chunk_t>::ConstIterator chunk = iter->chunks.constBegin(); chunk != iter->chunks.constEnd(); chunk++)
+	{
+		if(m_spillFile && m_spillFile->seek(chunk->first))
+		{
+			data.append(m_spillFile->read(chunk->second));
+		}
+	}
+	data.append(iter->buffer);
+
+	QStringList lines = QString::fromUtf8(data.constData(), data.size()).split('\n');
+	if((!lines.isEmpty()) && lines.last().isEmpty())
+	{
+		lines.removeLast(); /*every line is terminated*/
+	}
+	return lines;
+}
+
+////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////
+
+void LogStore::appendUtf8(job_log_t &log, const QString &line)
+{
+	const QByteArray utf8 = line.toUtf8();
+	log.buffer.append(utf8).append('\n');
+	m_bufferSize += utf8.size() + 1;
+	m_bufferPeak = qMax(m_bufferPeak, m_bufferSize);
+}
+
+void LogStore::checkLimits(job_log_t &log)
+{
+	if(m_spillFailed)
+	{
+		return; /*keep everything in memory*/
+	}
+
+	if(log.buffer.size() > JOB_BUFFER_LIMIT)
+	{
+		spill(log);
+	}
+
+	if(m_bufferSize > TOTAL_BUFFER_LIMIT)
+	{
+		for(QHash<QUuid, job_log_t>::Iterator iter = m_logs.begin(); iter != m_logs.end(); iter++)
+		{
+			if((!iter->buffer.isEmpty()) && (!spill(iter.value())))
+			{
+				break;
+			}
+		}
+	}
+}
+
+bool LogStore::spill(job_log_t &log)
+{
+	if(!m_spillFile)
+	{
+		m_spillFile = new QFile(QString("%1/%2.log").arg(m_tempFolder, MUtils::next_rand_str()));
+		if(!m_spillFile->open(QIODevice::ReadWrite | QIODevice::Truncate))
+		{
+			qWarning("Failed to create log spill file: %s", MUTILS_UTF8(m_spillFile->fileName()));
+			MUTILS_DELETE(m_spillFile);
+			m_spillFailed = true;
+			return false;
+		}
+	}
+
+	const qint64 offset = m_spillFile->size();
+	if((!m_spillFile->seek(offset)) || (m_spillFile->write(log.buffer) != log.buffer.size()))
+	{
+		qWarning("Failed to write log spill file: %s", MUTILS_UTF8(m_spillFile->fileName()));
+		m_spillFailed = true;
+		return false;
+	}
+
+	log.chunks.append(qMakePair(offset, log.buffer.size()));
+	m_bufferSize -= log.buffer.size();
+	m_spilledBytes += log.buffer.size();
+	log.buffer.clear();
+	return true;
+}
@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QHash>
+#include <QUuid>
+#include <QVector>
+#include <QPair>
+
+class QFile;
+
+////////////////////////////////////////////////////////////
+// Log Store
+////////////////////////////////////////////////////////////
+
+/*
+ * Compact storage for the per-job log files. Lines are kept as an append-only UTF-8 buffer per job. When a job's
+ * buffer or the total amount of buffered data exceeds its limit, the older content is moved to a temporary spill
+ * file, so that memory usage stays bounded for large batches. Logs are converted back to lines only when read.
+ */
+class LogStore
+{
+public:
+	LogStore(const QString &tempFolder);
+	~LogStore(void);
+
+	void append(const QUuid &jobId, const QString &line);
+	void append(const QUuid &jobId, const QStringList &lines);
+	QStringList read(const QUuid &jobId) const;
+
+	quint64 bufferSize(void) const { return m_bufferSize; }
+	quint64 bufferPeak(void) const { return m_bufferPeak; }
+	quint64 spilledBytes(void) const { return m_spilledBytes; }
+
+private:
+	typedef QPair<qint64, int> chunk_t;	//offset and size in the spill file
+
+	typedef struct
+	{
+		QByteArray buffer;
+		QVector<chunk_t> chunks;
+	}
+	job_log_t;
+
+	void appendUtf8(job_log_t &log, const QString &line);
+	void checkLimits(job_log_t &log);
+	bool spill(job_log_t &log);
+
+	const QString m_tempFolder;
+	QHash<QUuid, job_log_t> m_logs;
+	QFile *m_spillFile;
+	bool m_spillFailed;
+
+	quint64 m_bufferSize;
+	quint64 m_bufferPeak;
+	quint64 m_spilledBytes;
+};
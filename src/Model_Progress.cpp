@@ -22,12 +22,16 @@
 
 #include "Model_Progress.h"
 
+#include "Model_LogStore.h"
+
 #include <QUuid>
 
 #define MAX_DISPLAY_ITEMS 64
 
-ProgressModel::ProgressModel(void)
+ProgressModel::ProgressModel(const QString &tempFolder)
 :
+	m_firstVisible(0),
+	m_logStore(new LogStore(tempFolder)),
 	m_iconRunning(":/icons/media_play.png"),
 	m_iconPaused(":/icons/control_pause_blue.png"),
 	m_iconComplete(":/icons/tick.png"),
@@ -53,22 +57,22 @@ int ProgressModel::columnCount(const QModelIndex& /*parent*/) const
 
 int ProgressModel::rowCount(const QModelIndex& /*parent*/) const
 {
-	return m_jobList.count();
+	return m_jobs.count() - m_firstVisible;
 }
 
 QVariant ProgressModel::data(const QModelIndex &index, int role) const
 {
-	if(index.row() >= 0 && index.row() < m_jobList.count())
+	if(const job_t *const job = jobAt(index))
 	{
 		if(role == Qt::DisplayRole)
 		{
 			switch(index.column())
 			{
 			case 0:
-				return m_jobName.value(m_jobList.at(index.row()));
+				return job->name;
 				break;
 			case 1:
-				return m_jobStatus.value(m_jobList.at(index.row()));
+				return job->status;
 				break;
 			default:
 				return QVariant();
@@ -77,8 +81,7 @@ QVariant ProgressModel::data(const QModelIndex &index, int role) const
 		}
 		else if(role == Qt::DecorationRole && index.column() == 0)
 		{
-			const int currentState = m_jobState.value(m_jobList.at(index.row()));
-			return getIcon(static_cast<const JobState>(currentState));
+			return getIcon(static_cast<const JobState>(job->state));
 		}
 		else if(role == Qt::TextAlignmentRole)
 		{
@@ -119,84 +122,82 @@ QVariant ProgressModel::headerData(int section, Qt::Orientation orientation, int
 
 void ProgressModel::addJob(const QUuid &jobId, const QString &jobName, const QString &jobInitialStatus, int jobInitialState)
 {
-	if(m_jobIdentifiers.contains(jobId))
+	if(m_jobIndex.contains(jobId))
 	{
 		return;
 	}
 
-	while(m_jobList.count() >= MAX_DISPLAY_ITEMS)
-	{
-		beginRemoveRows(QModelIndex(), 0, 0);
-		m_jobListHidden.append(m_jobList.takeFirst());
-		m_jobIndexCache.clear();
-		endRemoveRows();
-	}
-
-	int newIndex = m_jobList.count();
-	beginInsertRows(QModelIndex(), newIndex, newIndex);
-
-	m_jobList.append(jobId);
-	m_jobName.insert(jobId, jobName);
-	m_jobStatus.insert(jobId, jobInitialStatus);
-	m_jobState.insert(jobId, jobInitialState);
-	m_jobLogFile.insert(jobId, QStringList());
-	m_jobIdentifiers.insert(jobId);
-	
-	endInsertRows();
+	insertJob(jobId, jobName, jobInitialStatus, jobInitialState);
 }
 
 void ProgressModel::updateJob(const QUuid &jobId, const QString &newStatus, int newState)
 {
-	if(!m_jobIdentifiers.contains(jobId))
+	const int position = m_jobIndex.value(jobId, -1);
+	if(position < 0)
 	{
 		return;
 	}
 	
-	if(!newStatus.isEmpty()) m_jobStatus.insert(jobId, newStatus);
-	if(newState >= 0) m_jobState.insert(jobId, newState);
-
-	const int row = m_jobIndexCache.value(jobId, -1);
+	job_t &job = m_jobs[position];
+	if(!newStatus.isEmpty()) job.status = newStatus;
+	if((newState >= 0) && (newState != job.state))
+	{
+		if(position >= m_firstVisible)
+		{
+			countState(job.state, -1);
+			countState(newState, +1);
+		}
+		job.state = newState;
+	}
 
-	if(row >= 0)
+	if(position >= m_firstVisible)
 	{
+		const int row = position - m_firstVisible;
 		emit dataChanged(index(row, 0), index(row, 1));
 	}
-	else
+}
+
+void ProgressModel::appendToLog(const QUuid &jobId, const QString &line)
+{
+	if(m_jobIndex.contains(jobId))
 	{
-		const int tmp = m_jobList.indexOf(jobId);
-		if(tmp >= 0)
-		{
-			m_jobIndexCache.insert(jobId, tmp);
-			emit dataChanged(index(tmp, 0), index(tmp, 1));
-		}
+		m_logStore->append(jobId, line);
 	}
 }
 
-void ProgressModel::appendToLog(const QUuid &jobId, const QString &line)
+void ProgressModel::appendToLog(const QUuid &jobId, const QStringList &lines)
 {
-	if(m_jobIdentifiers.contains(jobId))
+	if(m_jobIndex.contains(jobId))
 	{
-		m_jobLogFile[jobId].append(line.split('\n'));
+		m_logStore->append(jobId, lines);
 	}
 }
 
-const QStringList &ProgressModel::getLogFile(const QModelIndex &index) const
+QStringList ProgressModel::getLogFile(const QModelIndex &index) const
 {
-	if(index.row() < m_jobList.count())
+	if(const job_t *const job = jobAt(index))
 	{
-		QUuid id = m_jobList.at(index.row());
-		QHash<QUuid,QStringList>::const_iterator iter = m_jobLogFile.constFind(id);
-		if(iter != m_jobLogFile.constEnd()) { return iter.value(); }
+		return m_logStore->read(job->id);
 	}
 
 	return m_emptyList;
 }
 
+quint64 ProgressModel::getLogBufferPeak(void) const
+{
+	return m_logStore->bufferPeak();
+}
+
+quint64 ProgressModel::getLogSpilledBytes(void) const
+{
+	return m_logStore->spilledBytes();
+}
+
 const QUuid &ProgressModel::getJobId(const QModelIndex &index) const
 {
-	if(index.row() < m_jobList.count())
+	if(const job_t *const job = jobAt(index))
 	{
-		return m_jobList.at(index.row());
+		return job->id;
 	}
 
 	return m_emptyUuid;
@@ -204,32 +205,21 @@ const QUuid &ProgressModel::getJobId(const QModelIndex &index) const
 
 const ProgressModel::JobState ProgressModel::getJobState(const QModelIndex &index) const
 {
-	if(index.row() < m_jobList.count())
+	if(const job_t *const job = jobAt(index))
 	{
-		return static_cast<JobState>(m_jobState.value(m_jobList.at(index.row()), -1));
+		return static_cast<JobState>(job->state);
 	}
 
 	return static_cast<JobState>(-1);
 }
 
-void ProgressModel::addSystemMessage(const QString &text, int type)
+int ProgressModel::getJobCount(const JobState state) const
 {
-	const QUuid &jobId = QUuid::createUuid();
-
-	if(m_jobIdentifiers.contains(jobId))
-	{
-		return;
-	}
-
-	while(m_jobList.count() >= MAX_DISPLAY_ITEMS)
-	{
-		beginRemoveRows(QModelIndex(), 0, 0);
-		m_jobListHidden.append(m_jobList.takeFirst());
-		m_jobIndexCache.clear();
-		endRemoveRows();
-	}
+	return m_stateCount.value(state, 0);
+}
 
-	int newIndex = m_jobList.count();
+void ProgressModel::addSystemMessage(const QString &text, int type)
+{
 	JobState jobState = JobState(-1);
 
 	switch(type)
@@ -245,32 +235,76 @@ void ProgressModel::addSystemMessage(const QString &text, int type)
 		break;
 	}
 
-	beginInsertRows(QModelIndex(), newIndex, newIndex);
-
-	m_jobList.append(jobId);
-	m_jobName.insert(jobId, text);
-	m_jobStatus.insert(jobId, QString());
-	m_jobState.insert(jobId, jobState);
-	m_jobLogFile.insert(jobId, QStringList());
-	m_jobIdentifiers.insert(jobId);
-	
-	endInsertRows();
+	insertJob(QUuid::createUuid(), text, QString(), jobState);
 }
 
 void ProgressModel::restoreHiddenItems(void)
 {
-	if(!m_jobListHidden.isEmpty())
+	if(m_firstVisible > 0)
 	{
 		beginResetModel();
-		while(!m_jobListHidden.isEmpty())
+		m_firstVisible = 0;
+		m_stateCount.clear();
+		for(QVector<job_t>::ConstIterator iter = m_jobs.constBegin(); iter != m_jobs.constEnd(); iter++)
 		{
-			m_jobList.prepend(m_jobListHidden.takeLast());
+			countState(iter->state, +1);
 		}
-		m_jobIndexCache.clear();
 		endResetModel();
 	}
 }
 
+/*
+ * Append a new job, hiding the oldest visible items as needed. Positions in m_jobs never change, so the row of
+ * a job is always "position - m_firstVisible" and no index cache needs to be invalidated.
+ */
+void ProgressModel::insertJob(const QUuid &jobId, const QString &jobName, const QString &jobStatus, const int &jobState)
+{
+	while(rowCount() >= MAX_DISPLAY_ITEMS)
+	{
+		beginRemoveRows(QModelIndex(), 0, 0);
+		countState(m_jobs.at(m_firstVisible++).state, -1);
+		endRemoveRows();
+	}
+
+	const int newIndex = rowCount();
+	beginInsertRows(QModelIndex(), newIndex, newIndex);
+
+	job_t job;
+	job.id = jobId;
+	job.name = jobName;
+	job.status = jobStatus;
+	job.state = jobState;
+
+	m_jobIndex.insert(jobId, m_jobs.count());
+	m_jobs.append(job);
+	countState(jobState, +1);
+
+	endInsertRows();
+}
+
+void ProgressModel::countState(const int &state, const int &delta)
+{
+	const int count = m_stateCount.value(state, 0) + delta;
+	if(count > 0)
+	{
+		m_stateCount.insert(state, count);
+	}
+	else
+	{
+		m_stateCount.remove(state);
+	}
+}
+
+const ProgressModel::job_t *ProgressModel::jobAt(const QModelIndex &index) const
+{
+	if((index.row() >= 0) && (index.row() < rowCount()))
+	{
+		return &m_jobs.at(m_firstVisible + index.row());
+	}
+
+	return NULL;
+}
+
 const QIcon &ProgressModel::getIcon(ProgressModel::JobState state) const
 {
 	switch(state)
@@ -27,17 +27,20 @@
 #include <QString>
 #include <QStringList>
 #include <QHash>
-#include <QSet>
+#include <QVector>
 #include <QUuid>
 #include <QIcon>
 #include <QUuid>
+#include <QScopedPointer>
+
+class LogStore;
 
 class ProgressModel : public QAbstractTableModel
 {
 	Q_OBJECT
 
 public:
-	ProgressModel(void);
+	ProgressModel(const QString &tempFolder);
 	~ProgressModel(void);
 
 	//Enums
@@ -66,27 +69,41 @@ public:
 	QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
 
 	//Public functions
-	const QStringList &getLogFile(const QModelIndex &index) const;
+	QStringList getLogFile(const QModelIndex &index) const;
 	const QUuid &getJobId(const QModelIndex &index) const;
 	const JobState getJobState(const QModelIndex &index) const;
+	int getJobCount(const JobState state) const;
 	const QIcon &getIcon(ProgressModel::JobState state) const;
 	void restoreHiddenItems(void);
+	quint64 getLogBufferPeak(void) const;
+	quint64 getLogSpilledBytes(void) const;
 
 public slots:
 	void addJob(const QUuid &jobId, const QString &jobName, const QString &jobInitialStatus = QString("Initializing..."), int jobInitialState = JobRunning);
 	void updateJob(const QUuid &jobId, const QString &newStatus, int newState);
 	void appendToLog(const QUuid &jobId, const QString &line);
+	void appendToLog(const QUuid &jobId, const QStringList &lines);
 	void addSystemMessage(const QString &text, int type = SysMsg_Info);
 
 private:
-	QList<QUuid> m_jobList;
-	QList<QUuid> m_jobListHidden;
-	QHash<QUuid, QString> m_jobName;
-	QHash<QUuid, QString> m_jobStatus;
-	QHash<QUuid, int> m_jobState;
-	QHash<QUuid, QStringList> m_jobLogFile;
-	QHash<QUuid, int> m_jobIndexCache;
-	QSet<QUuid> m_jobIdentifiers;
+	typedef struct
+	{
+		QUuid id;
+		QString name;
+		QString status;
+		int state;
+	}
+	job_t;
+
+	void insertJob(const QUuid &jobId, const QString &jobName, const QString &jobStatus, const int &jobState);
+	void countState(const int &state, const int &delta);
+	const job_t *jobAt(const QModelIndex &index) const;
+
+	QVector<job_t> m_jobs;
+	QHash<QUuid, int> m_jobIndex;
+	QHash<int, int> m_stateCount;
+	int m_firstVisible;
+	QScopedPointer<LogStore> m_logStore;
 
 	const QIcon m_iconRunning;
 	const QIcon m_iconPaused;
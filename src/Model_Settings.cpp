@@ -204,10 +204,12 @@ static QString find_existing_ancestor(const QString &path)
 
 //Setting ID's
 LAMEXP_MAKE_ID(aacEncProfile,                "AdvancedOptions/AACEnc/ForceProfile");
+LAMEXP_MAKE_ID(adaptiveInstancesEnabled,     "AdvancedOptions/AdaptiveInstances/Enabled");
 LAMEXP_MAKE_ID(aftenAudioCodingMode,         "AdvancedOptions/Aften/AudioCodingMode");
 LAMEXP_MAKE_ID(aftenDynamicRangeCompression, "AdvancedOptions/Aften/DynamicRangeCompression");
 LAMEXP_MAKE_ID(aftenExponentSearchSize,      "AdvancedOptions/Aften/ExponentSearchSize");
 LAMEXP_MAKE_ID(aftenFastBitAllocation,       "AdvancedOptions/Aften/FastBitAllocation");
+LAMEXP_MAKE_ID(analysisCacheEnabled,         "AdvancedOptions/AnalysisCache/Enabled");
 LAMEXP_MAKE_ID(antivirNotificationsEnabled,  "Flags/EnableAntivirusNotifications");
 LAMEXP_MAKE_ID(autoUpdateCheckBeta,          "AutoUpdate/CheckForBetaVersions");
 LAMEXP_MAKE_ID(autoUpdateEnabled,            "AutoUpdate/Enabled");
@@ -273,6 +275,7 @@ LAMEXP_MAKE_ID(favoriteOutputFolders,        "OutputDirectory/Favorites");
 LAMEXP_MAKE_ID(forceStereoDownmix,           "AdvancedOptions/StereoDownmix/Force");
 LAMEXP_MAKE_ID(hibernateComputer,            "AdvancedOptions/HibernateComputerOnShutdown");
 LAMEXP_MAKE_ID(interfaceStyle,               "InterfaceStyle");
+LAMEXP_MAKE_ID(jobOrderingEnabled,           "AdvancedOptions/JobOrdering/LongestFirst");
 LAMEXP_MAKE_ID(keepOriginalDataTime,         "AdvancedOptions/FileOperations/KeepOriginalDataTime");
 LAMEXP_MAKE_ID(lameAlgoQuality,              "AdvancedOptions/LAME/AlgorithmQuality");
 LAMEXP_MAKE_ID(lameChannelMode,              "AdvancedOptions/LAME/ChannelMode");
@@ -294,6 +297,7 @@ LAMEXP_MAKE_ID(opusOptimizeFor,              "AdvancedOptions/Opus/OptimizeForSi
 LAMEXP_MAKE_ID(outputDir,                    "OutputDirectory/SelectedPath");
 LAMEXP_MAKE_ID(outputToSourceDir,            "OutputDirectory/OutputToSourceFolder");
 LAMEXP_MAKE_ID(overwriteMode,                "AdvancedOptions/FileOperations/OverwriteMode");
+LAMEXP_MAKE_ID(pipelinedStagesEnabled,       "AdvancedOptions/PipelinedStages/Enabled");
 LAMEXP_MAKE_ID(prependRelativeSourcePath,    "OutputDirectory/PrependRelativeSourcePath");
 LAMEXP_MAKE_ID(renameFiles_regExpEnabled,    "AdvancedOptions/RenameOutputFiles/RegExp/Enabled");
 LAMEXP_MAKE_ID(renameFiles_regExpSearch,     "AdvancedOptions/RenameOutputFiles/RegExp/SearchPattern");
@@ -305,6 +309,10 @@ LAMEXP_MAKE_ID(samplingRate,                 "AdvancedOptions/Common/Resampling"
 LAMEXP_MAKE_ID(shellIntegrationEnabled,      "Flags/EnableShellIntegration");
 LAMEXP_MAKE_ID(slowStartup,                  "Flags/SlowStartupDetected");
 LAMEXP_MAKE_ID(soundsEnabled,                "Flags/EnableSounds");
+LAMEXP_MAKE_ID(spawnBurst,                   "AdvancedOptions/ProcessSpawn/Burst");
+LAMEXP_MAKE_ID(spawnRate,                    "AdvancedOptions/ProcessSpawn/Rate");
+LAMEXP_MAKE_ID(statisticsExportEnabled,      "AdvancedOptions/Statistics/ExportEnabled");
+LAMEXP_MAKE_ID(streamingModeEnabled,         "AdvancedOptions/Streaming/Enabled");
 LAMEXP_MAKE_ID(toneAdjustBass,               "AdvancedOptions/ToneAdjustment/Bass");
 LAMEXP_MAKE_ID(toneAdjustTreble,             "AdvancedOptions/ToneAdjustment/Treble");
 LAMEXP_MAKE_ID(versionNumber,                "VersionNumber");
@@ -620,10 +628,12 @@ QString SettingsModel::initDirectory(const QString &path) const
 ////////////////////////////////////////////////////////////
 
 LAMEXP_MAKE_OPTION_I(aacEncProfile, 0)
+LAMEXP_MAKE_OPTION_B(adaptiveInstancesEnabled, true)
 LAMEXP_MAKE_OPTION_I(aftenAudioCodingMode, 0)
 LAMEXP_MAKE_OPTION_I(aftenDynamicRangeCompression, 5)
 LAMEXP_MAKE_OPTION_I(aftenExponentSearchSize, 8)
 LAMEXP_MAKE_OPTION_B(aftenFastBitAllocation, false)
+LAMEXP_MAKE_OPTION_B(analysisCacheEnabled, true)
 LAMEXP_MAKE_OPTION_B(antivirNotificationsEnabled, true)
 LAMEXP_MAKE_OPTION_B(autoUpdateCheckBeta, false)
 LAMEXP_MAKE_OPTION_B(autoUpdateEnabled, (!lamexp_version_portable()));
@@ -689,6 +699,7 @@ LAMEXP_MAKE_OPTION_S(favoriteOutputFolders, QString())
 LAMEXP_MAKE_OPTION_B(forceStereoDownmix, false)
 LAMEXP_MAKE_OPTION_B(hibernateComputer, false)
 LAMEXP_MAKE_OPTION_I(interfaceStyle, 0)
+LAMEXP_MAKE_OPTION_B(jobOrderingEnabled, true)
 LAMEXP_MAKE_OPTION_B(keepOriginalDataTime, false)
 LAMEXP_MAKE_OPTION_I(lameAlgoQuality, 2)
 LAMEXP_MAKE_OPTION_I(lameChannelMode, 0)
@@ -710,6 +721,7 @@ LAMEXP_MAKE_OPTION_I(opusOptimizeFor, 0)
 LAMEXP_MAKE_OPTION_S(outputDir, defaultDirectory())
 LAMEXP_MAKE_OPTION_B(outputToSourceDir, false)
 LAMEXP_MAKE_OPTION_I(overwriteMode, Overwrite_KeepBoth)
+LAMEXP_MAKE_OPTION_B(pipelinedStagesEnabled, true)
 LAMEXP_MAKE_OPTION_B(prependRelativeSourcePath, false)
 LAMEXP_MAKE_OPTION_B(renameFiles_regExpEnabled, false)
 LAMEXP_MAKE_OPTION_S(renameFiles_regExpSearch, QString())
@@ -721,6 +733,10 @@ LAMEXP_MAKE_OPTION_I(samplingRate, 0)
 LAMEXP_MAKE_OPTION_B(shellIntegrationEnabled, !lamexp_version_portable())
 LAMEXP_MAKE_OPTION_B(slowStartup, false)
 LAMEXP_MAKE_OPTION_B(soundsEnabled, true)
+LAMEXP_MAKE_OPTION_I(spawnBurst, 8)
+LAMEXP_MAKE_OPTION_I(spawnRate, 32)
+LAMEXP_MAKE_OPTION_B(statisticsExportEnabled, false)
+LAMEXP_MAKE_OPTION_B(streamingModeEnabled, false)
 LAMEXP_MAKE_OPTION_I(toneAdjustBass, 0)
 LAMEXP_MAKE_OPTION_I(toneAdjustTreble, 0)
 LAMEXP_MAKE_OPTION_B(writeMetaTags, true)
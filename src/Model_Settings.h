@@ -102,10 +102,12 @@ public:
 
 	//Getters & setters
 	LAMEXP_MAKE_OPTION_I(aacEncProfile)
+	LAMEXP_MAKE_OPTION_B(adaptiveInstancesEnabled)
 	LAMEXP_MAKE_OPTION_I(aftenAudioCodingMode)
 	LAMEXP_MAKE_OPTION_I(aftenDynamicRangeCompression)
 	LAMEXP_MAKE_OPTION_I(aftenExponentSearchSize)
 	LAMEXP_MAKE_OPTION_B(aftenFastBitAllocation)
+	LAMEXP_MAKE_OPTION_B(analysisCacheEnabled)
 	LAMEXP_MAKE_OPTION_B(antivirNotificationsEnabled)
 	LAMEXP_MAKE_OPTION_B(autoUpdateCheckBeta)
 	LAMEXP_MAKE_OPTION_B(autoUpdateEnabled)
@@ -171,6 +173,7 @@ public:
 	LAMEXP_MAKE_OPTION_B(forceStereoDownmix)
 	LAMEXP_MAKE_OPTION_B(hibernateComputer)
 	LAMEXP_MAKE_OPTION_I(interfaceStyle)
+	LAMEXP_MAKE_OPTION_B(jobOrderingEnabled)
 	LAMEXP_MAKE_OPTION_B(keepOriginalDataTime)
 	LAMEXP_MAKE_OPTION_I(lameAlgoQuality)
 	LAMEXP_MAKE_OPTION_I(lameChannelMode)
@@ -192,6 +195,7 @@ public:
 	LAMEXP_MAKE_OPTION_S(outputDir)
 	LAMEXP_MAKE_OPTION_B(outputToSourceDir)
 	LAMEXP_MAKE_OPTION_I(overwriteMode)
+	LAMEXP_MAKE_OPTION_B(pipelinedStagesEnabled)
 	LAMEXP_MAKE_OPTION_B(prependRelativeSourcePath)
 	LAMEXP_MAKE_OPTION_B(renameFiles_regExpEnabled)
 	LAMEXP_MAKE_OPTION_S(renameFiles_regExpSearch)
@@ -203,6 +207,10 @@ public:
 	LAMEXP_MAKE_OPTION_B(shellIntegrationEnabled)
 	LAMEXP_MAKE_OPTION_B(slowStartup)
 	LAMEXP_MAKE_OPTION_B(soundsEnabled)
+	LAMEXP_MAKE_OPTION_I(spawnBurst)
+	LAMEXP_MAKE_OPTION_I(spawnRate)
+	LAMEXP_MAKE_OPTION_B(statisticsExportEnabled)
+	LAMEXP_MAKE_OPTION_B(streamingModeEnabled)
 	LAMEXP_MAKE_OPTION_I(toneAdjustBass)
 	LAMEXP_MAKE_OPTION_I(toneAdjustTreble)
 	LAMEXP_MAKE_OPTION_B(writeMetaTags)
@@ -29,6 +29,7 @@
 #include "Model_CueSheet.h"
 #include "Registry_Decoder.h"
 #include "Decoder_Abstract.h"
+#include "Tool_WaveSlicer.h"
 
 //MUtils
 #include <MUtils/Global.h>
@@ -37,33 +38,67 @@
 //Qt
 #include <QDir>
 #include <QFileInfo>
-#include <QProcess>
 #include <QDate>
 #include <QTime>
 #include <QDebug>
+#include <QHash>
+#include <QSet>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThreadPool>
 
 //CRT
 #include <math.h>
 #include <float.h>
 #include <limits>
+#include <functional>
+
+////////////////////////////////////////////////////////////
+// Helper Classes
+////////////////////////////////////////////////////////////
+
+typedef struct
+{
+	int index;
+	int trackNo;
+	double offset;
+	double length;
+	QString outputFile;
+	AudioFileModel_MetaInfo metaInfo;
+}
+cue_track_t;
+
+class CueSplitterTask : public QRunnable
+{
+public:
+	CueSplitterTask(const std::function<void(void)> &function)
+	:
+		m_function(function)
+	{
+	}
+
+protected:
+	void run(void)
+	{
+		m_function();
+	}
+
+private:
+	const std::function<void(void)> m_function;
+};
 
 ////////////////////////////////////////////////////////////
 // Constructor
 ////////////////////////////////////////////////////////////
 
-CueSplitter::CueSplitter(const QString &outputDir, const QString &baseName, CueSheetModel *model, const QList<AudioFileModel> &inputFilesInfo)
+CueSplitter::CueSplitter(const QString &outputDir, const QString &baseName, CueSheetModel *model, const QList<AudioFileModel> &inputFilesInfo, const bool virtualTracks)
 :
 	m_model(model),
 	m_outputDir(outputDir),
 	m_baseName(baseName),
-	m_soxBin(lamexp_tools_lookup("sox.exe"))
+	m_virtualTracks(virtualTracks),
+	m_nextResult(0)
 {
-	if(m_soxBin.isEmpty())
-	{
-		qFatal("Invalid path to SoX binary. Tool not initialized properly.");
-	}
-
-	m_decompressedFiles.clear();
 	m_tempFiles.clear();
 
 	qDebug("\n[CueSplitter]");
@@ -97,137 +132,130 @@ void CueSplitter::run()
 	m_bAborted = false;
 	m_nTracksSuccess = 0;
 	m_nTracksSkipped = 0;
-	m_decompressedFiles.clear();
-	m_activeFile.clear();
+	m_nextResult = 0;
+	m_results.clear();
+	m_progress.fetchAndStoreOrdered(0);
 	
-	if(!QDir(m_outputDir).exists())
+	if((!m_virtualTracks) && (!QDir(m_outputDir).exists()))
 	{
 		qWarning("Output directory \"%s\" does not exist!", MUTILS_UTF8(m_outputDir));
 		return;
 	}
-	
-	QStringList inputFileList = m_inputFilesInfo.keys();
-	int nInputFiles = inputFileList.count();
-	
-	emit progressMaxChanged(nInputFiles);
-	emit progressValChanged(0);
-
-	//Decompress all input files
-	for(int i = 0; i < nInputFiles; i++)
-	{
-		const AudioFileModel_TechInfo &inputFileInfo = m_inputFilesInfo[inputFileList.at(i)].techInfo();
-		if(inputFileInfo.containerType().compare("Wave", Qt::CaseInsensitive) || inputFileInfo.audioType().compare("PCM", Qt::CaseInsensitive))
-		{
-			AbstractDecoder *decoder = DecoderRegistry::lookup(inputFileInfo.containerType(), inputFileInfo.containerProfile(), inputFileInfo.audioType(), inputFileInfo.audioProfile(), inputFileInfo.audioVersion());
-			if(decoder)
-			{
-				m_activeFile = shortName(QFileInfo(inputFileList.at(i)).fileName());
-				
-				emit fileSelected(m_activeFile);
-				emit progressValChanged(i+1);
-				
-				QString tempFile = QString("%1/~%2.wav").arg(m_outputDir, MUtils::next_rand_str());
-				connect(decoder, SIGNAL(statusUpdated(int)), this, SLOT(handleUpdate(int)), Qt::DirectConnection);
-				
-				if(decoder->decode(inputFileList.at(i), tempFile, m_abortFlag))
-				{
-					m_decompressedFiles.insert(inputFileList.at(i), tempFile);
-					m_tempFiles.append(tempFile);
-				}
-				else
-				{
-					qWarning("Failed to decompress file: <%s>", inputFileList.at(i).toLatin1().constData());
-					MUtils::remove_file(tempFile);
-				}
-				
-				m_activeFile.clear();
-				MUTILS_DELETE(decoder);
-			}
-			else
-			{
-				qWarning("Unsupported input file: <%s>", inputFileList.at(i).toLatin1().constData());
-			}
-		}
-		else
-		{
-			m_decompressedFiles.insert(inputFileList.at(i), inputFileList.at(i));
-		}
-
-		if(MUTILS_BOOLIFY(m_abortFlag))
-		{
-			m_bAborted = true;
-			qWarning("The user has requested to abort the process!");
-			return;
-		}
-	}
-
-	int nFiles = m_model->getFileCount();
-	int nTracksTotal = 0, nTracksComplete = 0;
-
-	for(int i = 0; i < nFiles; i++)
-	{
-		nTracksTotal += m_model->getTrackCount(i);
-	}
-
-	emit progressMaxChanged(10 * nTracksTotal);
-	emit progressValChanged(0);
 
 	const AudioFileModel_MetaInfo *albumInfo = m_model->getAlbumInfo();
 
-	//Now split all files
+	//Collect all tracks first, so the output file names are reserved before any file gets written
+	QStringList inputFiles;
+	QHash<QString, QList<cue_track_t>> tracks;
+	QSet<QString> reservedNames;
+	int nTracksTotal = 0;
+
+	const int nFiles = m_model->getFileCount();
 	for(int i = 0; i < nFiles; i++)
 	{
 		int nTracks = m_model->getTrackCount(i);
 		QString trackFile = m_model->getFileName(i);
 
-		//Process all tracks
 		for(int j = 0; j < nTracks; j++)
 		{
 			const AudioFileModel_MetaInfo *trackInfo = m_model->getTrackInfo(i, j);
-			const int trackNo = trackInfo->position();
-			double trackOffset = std::numeric_limits<double>::quiet_NaN();
-			double trackLength = std::numeric_limits<double>::quiet_NaN();
-			m_model->getTrackIndex(i, j, &trackOffset, &trackLength);
+			cue_track_t track = { nTracksTotal, trackInfo->position(), std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), QString(), *trackInfo };
+			m_model->getTrackIndex(i, j, &track.offset, &track.length);
 			
-			if((trackNo < 0) || _isnan(trackOffset) || _isnan(trackLength))
+			if((track.trackNo < 0) || _isnan(track.offset) || _isnan(track.length))
 			{
 				qWarning("Failed to fetch information for track #%d of file #%d!", j, i);
 				continue;
 			}
 			
-			//Setup meta info
-			AudioFileModel_MetaInfo trackMetaInfo(*trackInfo);
-			
 			//Apply album meta data on files
-			if(trackMetaInfo.title().trimmed().isEmpty())
+			if(track.metaInfo.title().trimmed().isEmpty())
 			{
-				trackMetaInfo.setTitle(QString().sprintf("Track %02d", trackNo));
+				track.metaInfo.setTitle(QString().sprintf("Track %02d", track.trackNo));
 			}
-			trackMetaInfo.update(*albumInfo, false);
+			track.metaInfo.update(*albumInfo, false);
 
-			//Generate output file name
-			QString trackTitle = trackMetaInfo.title().isEmpty() ? QString().sprintf("Track %02d", trackNo) : trackMetaInfo.title();
-			QString outputFile = QString("%1/[%2] %3 - %4.wav").arg(m_outputDir, QString().sprintf("%02d", trackNo), MUtils::clean_file_name(m_baseName, true), MUtils::clean_file_name(trackTitle, true));
-			for(int n = 2; QFileInfo(outputFile).exists(); n++)
+			//Generate output file name, virtual tracks refer to a range of the input file and nothing is written
+			if(!m_virtualTracks)
 			{
-				outputFile = QString("%1/[%2] %3 - %4 (%5).wav").arg(m_outputDir, QString().sprintf("%02d", trackNo), MUtils::clean_file_name(m_baseName, true), MUtils::clean_file_name(trackTitle, true), QString::number(n));
+				QString trackTitle = track.metaInfo.title().isEmpty() ? QString().sprintf("Track %02d", track.trackNo) : track.metaInfo.title();
+				track.outputFile = QString("%1/[%2] %3 - %4.wav").arg(m_outputDir, QString().sprintf("%02d", track.trackNo), MUtils::clean_file_name(m_baseName, true), MUtils::clean_file_name(trackTitle, true));
+				for(int n = 2; QFileInfo(track.outputFile).exists() || reservedNames.contains(track.outputFile.toLower()); n++)
+				{
+					track.outputFile = QString("%1/[%2] %3 - %4 (%5).wav").arg(m_outputDir, QString().sprintf("%02d", track.trackNo), MUtils::clean_file_name(m_baseName, true), MUtils::clean_file_name(trackTitle, true), QString::number(n));
+				}
+				reservedNames.insert(track.outputFile.toLower());
 			}
 
-			//Call split function
-			emit fileSelected(shortName(QFileInfo(outputFile).fileName()));
-			splitFile(outputFile, trackNo, trackFile, trackOffset, trackLength, trackMetaInfo, nTracksComplete);
-			emit progressValChanged(nTracksComplete += 10);
-
-			if(MUTILS_BOOLIFY(m_abortFlag))
+			if(!tracks.contains(trackFile))
 			{
-				m_bAborted = true;
-				qWarning("The user has requested to abort the process!");
-				return;
+				inputFiles << trackFile;
 			}
+			tracks[trackFile] << track;
+			nTracksTotal++;
 		}
 	}
 
-	emit progressValChanged(10 * nTracksTotal);
+	//Every track accounts for 10 steps, every input file that needs to be decompressed for another 10 steps
+	int nDecompress = 0;
+	for(QStringList::ConstIterator iter = inputFiles.constBegin(); iter != inputFiles.constEnd(); iter++)
+	{
+		if(needsDecompression(*iter))
+		{
+			nDecompress++;
+		}
+	}
+
+	emit progressMaxChanged(10 * (nTracksTotal + nDecompress));
+	emit progressValChanged(0);
+
+	//Create the thread pool
+	QScopedPointer<QThreadPool> pool(new QThreadPool());
+	const int idealThreadCount = QThread::idealThreadCount();
+	if(idealThreadCount > 0)
+	{
+		pool->setMaxThreadCount(qBound(2, idealThreadCount, 8));
+	}
+
+	//Each input file is decompressed by a separate task, which then starts splitting the tracks of that file right away
+	QThreadPool *const poolPtr = pool.data();
+	for(QStringList::ConstIterator iter = inputFiles.constBegin(); iter != inputFiles.constEnd(); iter++)
+	{
+		const QString inputFile = (*iter);
+		const QList<cue_track_t> fileTracks = tracks.value(inputFile);
+		pool->start(new CueSplitterTask([this, poolPtr, inputFile, fileTracks]()
+		{
+			QString decompressedInput;
+			const bool bReady = decompressFile(inputFile, decompressedInput);
+			for(QList<cue_track_t>::ConstIterator track = fileTracks.constBegin(); track != fileTracks.constEnd(); track++)
+			{
+				if(!bReady)
+				{
+					qWarning("Unknown or unsupported input file, skipping track #%d!", track->trackNo);
+					trackFinished(track->index, NULL);
+					addProgress(10);
+					continue;
+				}
+				const cue_track_t current = (*track);
+				poolPtr->start(new CueSplitterTask([this, inputFile, decompressedInput, current]()
+				{
+					splitFile(current.outputFile, current.trackNo, inputFile, decompressedInput, current.offset, current.length, current.metaInfo, current.index);
+				}),
+				1); /*splitting takes precedence over the decompression of the next file*/
+			}
+		}));
+	}
+
+	pool->waitForDone();
+
+	if(MUTILS_BOOLIFY(m_abortFlag))
+	{
+		m_bAborted = true;
+		qWarning("The user has requested to abort the process!");
+		return;
+	}
+
+	emit progressValChanged(10 * (nTracksTotal + nDecompress));
 	MUtils::OS::sleep_ms(333);
 
 	qDebug("All files were split.\n");
@@ -235,198 +263,189 @@ void CueSplitter::run()
 }
 
 ////////////////////////////////////////////////////////////
-// Slots
+// Privtae Functions
 ////////////////////////////////////////////////////////////
 
-void CueSplitter::handleUpdate(int /*progress*/)
+bool CueSplitter::needsDecompression(const QString &file) const
 {
-	//QString("%1 [%2]").arg(m_activeFile, QString::number(progress)))
+	QMap<QString,AudioFileModel>::ConstIterator iter = m_inputFilesInfo.constFind(file);
+	if((iter == m_inputFilesInfo.constEnd()) || m_virtualTracks)
+	{
+		return false;
+	}
+
+	const AudioFileModel_TechInfo &inputFileInfo = iter->techInfo();
+	return inputFileInfo.containerType().compare("Wave", Qt::CaseInsensitive) || inputFileInfo.audioType().compare("PCM", Qt::CaseInsensitive);
 }
 
-////////////////////////////////////////////////////////////
-// Privtae Functions
-////////////////////////////////////////////////////////////
+bool CueSplitter::decompressFile(const QString &file, QString &decompressedInput)
+{
+	if((!m_inputFilesInfo.contains(file)) || MUTILS_BOOLIFY(m_abortFlag))
+	{
+		return false;
+	}
+
+	if(!needsDecompression(file))
+	{
+		decompressedInput = file;
+		return true;
+	}
+
+	const AudioFileModel_TechInfo &inputFileInfo = m_inputFilesInfo.constFind(file)->techInfo();
+	AbstractDecoder *decoder = DecoderRegistry::lookup(inputFileInfo.containerType(), inputFileInfo.containerProfile(), inputFileInfo.audioType(), inputFileInfo.audioProfile(), inputFileInfo.audioVersion());
+	if(!decoder)
+	{
+		qWarning("Unsupported input file: <%s>", file.toLatin1().constData());
+		addProgress(10);
+		return false;
+	}
+
+	emit fileSelected(shortName(QFileInfo(file).fileName()));
+
+	//Each decoder adds its own steps to the shared progress, so the total is aggregated across all parallel tasks
+	int reported = 0;
+	CueSplitterProgress decoderProgress([this, &reported](const int progress)
+	{
+		const int steps = qBound(0, progress / 10, 10);
+		if(steps > reported)
+		{
+			addProgress(steps - reported);
+			reported = steps;
+		}
+	});
+	connect(decoder, SIGNAL(statusUpdated(int)), &decoderProgress, SLOT(update(int)), Qt::DirectConnection);
+
+	bool bSuccess = false;
+	const QString tempFile = QString("%1/~%2.wav").arg(m_outputDir, MUtils::next_rand_str());
+	if(decoder->decode(file, tempFile, m_abortFlag))
+	{
+		QMutexLocker lock(&m_mutex);
+		m_tempFiles.append(tempFile);
+		decompressedInput = tempFile;
+		bSuccess = true;
+	}
+	else
+	{
+		qWarning("Failed to decompress file: <%s>", file.toLatin1().constData());
+		MUtils::remove_file(tempFile);
+	}
+
+	MUTILS_DELETE(decoder);
+	addProgress(10 - reported);
+	return bSuccess;
+}
 
-void CueSplitter::splitFile(const QString &output, const int trackNo, const QString &file, const double offset, const double length, const AudioFileModel_MetaInfo &metaInfo, const int baseProgress)
+void CueSplitter::splitFile(const QString &output, const int trackNo, const QString &file, const QString &decompressedInput, const double offset, const double length, const AudioFileModel_MetaInfo &metaInfo, const int index)
 {
+	if(MUTILS_BOOLIFY(m_abortFlag))
+	{
+		trackFinished(index, NULL);
+		addProgress(10);
+		return;
+	}
+
 	qDebug("[Track %02d]", trackNo);
 	qDebug("File: <%s>", MUTILS_UTF8(file));
+	qDebug("Input: <%s>", MUTILS_UTF8(decompressedInput));
 	qDebug("Offset: <%f> <%s>", offset, indexToString(offset).toLatin1().constData());
 	qDebug("Length: <%f> <%s>", length, indexToString(length).toLatin1().constData());
 	qDebug("Artist: <%s>", MUTILS_UTF8(metaInfo.artist()));
 	qDebug("Title: <%s>", MUTILS_UTF8(metaInfo.title()));
 	qDebug("Album: <%s>", MUTILS_UTF8(metaInfo.album()));
+
+	emit fileSelected(shortName(m_virtualTracks ? QString("[%1] %2").arg(QString().sprintf("%02d", trackNo), metaInfo.title()) : QFileInfo(output).fileName()));
 	
-	int prevProgress = baseProgress;
+	AudioFileModel outFileInfo(m_virtualTracks ? file : output);
+	outFileInfo.setMetaInfo(metaInfo);
 
-	if(!m_decompressedFiles.contains(file))
+	//Cue sheet indices are multiples of a CD frame, so the range can be converted exactly
+	const qint64 frameOffset = (_finite(offset) && (offset > 0.0)) ? static_cast<qint64>(floor((offset * WaveSlicer::FRAMES_PER_SECOND) + 0.5)) : 0i64;
+	const qint64 frameLength = (_finite(offset) && _finite(length)) ? static_cast<qint64>(floor((length * WaveSlicer::FRAMES_PER_SECOND) + 0.5)) : (-1i64);
+
+	//Virtual tracks of a compressed image keep the format of the image, it will be decoded by the encoding job
+	const AudioFileModel_TechInfo &inputInfo = m_inputFilesInfo.constFind(file)->techInfo();
+	if(m_virtualTracks && (inputInfo.containerType().compare("Wave", Qt::CaseInsensitive) || inputInfo.audioType().compare("PCM", Qt::CaseInsensitive)))
 	{
-		qWarning("Unknown or unsupported input file, skipping!");
-		m_nTracksSkipped++;
+		const unsigned int remaining = (inputInfo.duration() > static_cast<unsigned int>(frameOffset / WaveSlicer::FRAMES_PER_SECOND)) ? (inputInfo.duration() - static_cast<unsigned int>(frameOffset / WaveSlicer::FRAMES_PER_SECOND)) : 0U;
+		outFileInfo.setTechInfo(inputInfo);
+		outFileInfo.techInfo().setDuration((frameLength >= 0) ? static_cast<unsigned int>((frameLength + (WaveSlicer::FRAMES_PER_SECOND / 2)) / WaveSlicer::FRAMES_PER_SECOND) : remaining);
+		outFileInfo.setSourceRange(frameOffset, frameLength);
+		trackFinished(index, &outFileInfo);
+		addProgress(10);
 		return;
 	}
 
-	QString baseName = shortName(QFileInfo(output).fileName());
-	QString decompressedInput = m_decompressedFiles[file];
-	qDebug("Input: <%s>", MUTILS_UTF8(decompressedInput));
-	
-	AudioFileModel outFileInfo(output);
-	outFileInfo.setMetaInfo(metaInfo);
-	
-	AudioFileModel_TechInfo &outFileTechInfo = outFileInfo.techInfo();
-	outFileTechInfo.setContainerType("Wave");
-	outFileTechInfo.setAudioType("PCM");
-	outFileTechInfo.setDuration(static_cast<unsigned int>(abs(length)));
-
-	QStringList args;
-	args << "-S" << "-V3";
-	args << "--guard" << "--temp" << ".";
-	args << QDir::toNativeSeparators(decompressedInput);
-	args << QDir::toNativeSeparators(output);
-	
-	//Add trim parameters, if needed
-	if(_finite(offset))
+	WaveSlicer slicer(decompressedInput);
+	if(!slicer.setRange(frameOffset, frameLength, &outFileInfo.techInfo()))
 	{
-		args << "trim";
-		args << indexToString(offset);
-		
-		if(_finite(length))
-		{
-			args << indexToString(length);
-		}
+		qWarning("Failed to determine the range of the track, skipping!");
+		trackFinished(index, NULL);
+		addProgress(10);
+		return;
 	}
 
-	QRegExp rxProgress("In:(\\d+)(\\.\\d+)*%", Qt::CaseInsensitive);
-	QRegExp rxChannels("Channels\\s*:\\s*(\\d+)", Qt::CaseInsensitive);
-	QRegExp rxSamplerate("Sample Rate\\s*:\\s*(\\d+)", Qt::CaseInsensitive);
-	QRegExp rxPrecision("Precision\\s*:\\s*(\\d+)-bit", Qt::CaseInsensitive);
-	QRegExp rxDuration("Duration\\s*:\\s*(\\d\\d):(\\d\\d):(\\d\\d).(\\d\\d)", Qt::CaseInsensitive);
-
-	QProcess process;
-	MUtils::init_process(process, m_outputDir);
-
-	qDebug("SoX args: \"%s\"", MUTILS_UTF8(args.join(QLatin1String("\", \""))));
-	process.start(m_soxBin, args);
-		
-	if(!process.waitForStarted())
+	if(m_virtualTracks)
 	{
-		qWarning("SoX process failed to create!");
-		qWarning("Error message: \"%s\"\n", process.errorString().toLatin1().constData());
-		process.kill();
-		process.waitForFinished(-1);
-		m_nTracksSkipped++;
+		outFileInfo.setSourceRange(frameOffset, frameLength);
+		trackFinished(index, &outFileInfo);
+		addProgress(10);
 		return;
 	}
 
-	while(process.state() != QProcess::NotRunning)
+	int reported = 0;
+	const bool success = slicer.extract(output, m_abortFlag, [this, &reported](const int progress)
 	{
-		if(MUTILS_BOOLIFY(m_abortFlag))
+		const int steps = qBound(0, progress / 10, 10);
+		if(steps > reported)
 		{
-			process.kill();
-			qWarning("Process was aborted on user request!");
-			break;
+			addProgress(steps - reported);
+			reported = steps;
 		}
-		process.waitForReadyRead(m_processTimeoutInterval);
-		if(!process.bytesAvailable() && process.state() == QProcess::Running)
-		{
-			process.kill();
-			qWarning("SoX process timed out <-- killing!");
-			break;
-		}
-		while(process.bytesAvailable() > 0)
-		{
-			QByteArray line = process.readLine();
-			if (line.size() > 0)
-			{
-				QString text = QString::fromUtf8(line.constData()).simplified();
-				if (!text.isEmpty())
-				{
-					if (rxProgress.lastIndexIn(text) >= 0)
-					{
-						int progress;
-						if (MUtils::regexp_parse_int32(rxProgress, progress))
-						{
-							const int newProgress = baseProgress + qRound(static_cast<double>(qBound(0, progress, 100)) / 10.0);
-							if (newProgress > prevProgress)
-							{
-								emit progressValChanged(newProgress);
-								prevProgress = newProgress;
-							}
-						}
-					}
-					else if (rxChannels.lastIndexIn(text) >= 0)
-					{
-						unsigned int channels;
-						if (MUtils::regexp_parse_uint32(rxChannels, channels))
-						{
-							outFileInfo.techInfo().setAudioChannels(channels);
-						}
-					}
-					else if (rxSamplerate.lastIndexIn(text) >= 0)
-					{
-						unsigned int samplerate;
-						if (MUtils::regexp_parse_uint32(rxSamplerate, samplerate))
-						{
-							outFileInfo.techInfo().setAudioSamplerate(samplerate);
-						}
-					}
-					else if (rxPrecision.lastIndexIn(text) >= 0)
-					{
-						unsigned int precision;
-						if (MUtils::regexp_parse_uint32(rxPrecision, precision))
-						{
-							outFileInfo.techInfo().setAudioBitdepth(precision);
-						}
-					}
-					else if (rxDuration.lastIndexIn(text) >= 0)
-					{
-						unsigned int duration[3U];
-						if (MUtils::regexp_parse_uint32(rxDuration, duration, 3U))
-						{
-							unsigned int intputLen = (duration[0U] * 3600) + (duration[1U] * 60) + duration[2U];
-							if (length == std::numeric_limits<double>::infinity())
-							{
-								qDebug("Duration updated from SoX info!");
-								int durationSecs = intputLen - static_cast<int>(floor(offset + 0.5));
-								if (durationSecs < 0)
-								{
-									qWarning("Track is out of bounds: Track offset exceeds input file duration!");
-								}
-								outFileInfo.techInfo().setDuration(qMax(0, durationSecs));
-							}
-							else
-							{
-								unsigned int trackEnd = static_cast<unsigned int>(floor(offset + 0.5)) + static_cast<unsigned int>(floor(length + 0.5));
-								if (trackEnd > intputLen) qWarning("Track is out of bounds: End of track exceeds input file duration!");
-							}
-						}
-					}
-					else
-					{
-						qDebug("SoX line: %s", MUTILS_UTF8(text));
-					}
-				}
-			}
-		}
-	}
+	});
+	addProgress(10 - reported);
 
-	process.waitForFinished();
-	if(process.state() != QProcess::NotRunning)
+	if(!success)
 	{
-		process.kill();
-		process.waitForFinished(-1);
+		qWarning("Splitting has failed !!!");
+		trackFinished(index, NULL);
+		return;
 	}
 
-	qDebug("SoX exit code: %d", process.exitCode());
-	if(process.exitCode() != EXIT_SUCCESS || QFileInfo(output).size() == 0)
+	trackFinished(index, &outFileInfo);
+}
+
+void CueSplitter::trackFinished(const int index, const AudioFileModel *const file)
+{
+	QMutexLocker lock(&m_mutex);
+
+	if(file)
 	{
-		qWarning("Splitting has failed !!!");
+		m_results.insert(index, *file);
+		m_nTracksSuccess++;
+	}
+	else
+	{
+		m_results.insert(index, AudioFileModel());
 		m_nTracksSkipped++;
-		return;
 	}
 
-	emit fileSplit(outFileInfo);
-	m_nTracksSuccess++;
+	//Tracks are passed on in the order of the Cue Sheet, regardless of which one was completed first
+	while(m_results.contains(m_nextResult))
+	{
+		const AudioFileModel result = m_results.take(m_nextResult++);
+		if(!result.filePath().isEmpty())
+		{
+			emit fileSplit(result);
+		}
+	}
+}
+
+void CueSplitter::addProgress(const int steps)
+{
+	if(steps > 0)
+	{
+		emit progressValChanged(static_cast<unsigned int>(m_progress.fetchAndAddOrdered(steps) + steps));
+	}
 }
 
 QString CueSplitter::indexToString(const double index) const
@@ -25,6 +25,8 @@
 #include <QThread>
 #include <QStringList>
 #include <QMap>
+#include <QMutex>
+#include <functional>
 
 class AudioFileModel;
 class AudioFileModel_MetaInfo;
@@ -42,7 +44,7 @@ class CueSplitter: public QThread
 	Q_OBJECT
 
 public:
-	CueSplitter(const QString &outputDir, const QString &baseName, CueSheetModel *model, const QList<AudioFileModel> &inputFilesInfo);
+	CueSplitter(const QString &outputDir, const QString &baseName, CueSheetModel *model, const QList<AudioFileModel> &inputFilesInfo, const bool virtualTracks = false);
 	~CueSplitter(void);
 
 	void run();
@@ -57,33 +59,54 @@ signals:
 	void progressValChanged(unsigned int);
 	void progressMaxChanged(unsigned int);
 
-private slots:
-	void handleUpdate(int progress);
-
 public slots:
 	void abortProcess(void) { m_abortFlag.ref(); }
 
 private:
-	void splitFile(const QString &output, const int trackNo, const QString &file, const double offset, const double length, const AudioFileModel_MetaInfo &metaInfo, const int baseProgress);
+	bool needsDecompression(const QString &file) const;
+	bool decompressFile(const QString &file, QString &decompressedInput);
+	void splitFile(const QString &output, const int trackNo, const QString &file, const QString &decompressedInput, const double offset, const double length, const AudioFileModel_MetaInfo &metaInfo, const int index);
+	void trackFinished(const int index, const AudioFileModel *const file);
+	void addProgress(const int steps);
 	QString indexToString(const double index) const;
 	QString shortName(const QString &longName) const;
 	
-	const QString m_soxBin;
 	const QString m_outputDir;
 	const QString m_baseName;
+	const bool m_virtualTracks;
 	unsigned int m_nTracksSuccess;
 	unsigned int m_nTracksSkipped;
-	
-	static const int m_processTimeoutInterval = 180000;
 
 	bool m_bAborted;
 	bool m_bSuccess;
 	
 	QAtomicInt m_abortFlag;
+	QAtomicInt m_progress;
 
 	CueSheetModel *m_model;
 	QMap<QString,AudioFileModel> m_inputFilesInfo;
-	QMap<QString,QString> m_decompressedFiles;
 	QStringList m_tempFiles;
-	QString m_activeFile;
+
+	QMutex m_mutex;
+	QMap<int,AudioFileModel> m_results;
+	int m_nextResult;
+};
+
+////////////////////////////////////////////////////////////
+// Decoder Progress
+////////////////////////////////////////////////////////////
+
+//Receives the progress of one decoder, the decoders of several files are running in parallel
+class CueSplitterProgress : public QObject
+{
+	Q_OBJECT
+
+public:
+	CueSplitterProgress(const std::function<void(const int progress)> &callback) : m_callback(callback) {}
+
+public slots:
+	void update(int progress) { m_callback(progress); }
+
+private:
+	const std::function<void(const int progress)> m_callback;
 };
@@ -33,8 +33,17 @@
 
 //Qt
 #include <QDir>
+#include <QElapsedTimer>
+
+//Windows includes
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
 
 #define MIN_DISKSPACE 104857600ui64 //100 MB
+#define PROBE_CHUNK   65536UL        //64 KB, multiple of any sector size
+#define PROBE_CHUNKS  64UL           //4 MB per write probe
+#define PROBE_CYCLES  5              //write probe on every 5th cycle
 
 ////////////////////////////////////////////////////////////
 // Constructor & Destructor
@@ -42,7 +51,8 @@
 
 DiskObserverThread::DiskObserverThread(const QString &path)
 :
-	m_path(makeRootDir(path))
+	m_path(makeRootDir(path)),
+	m_tempFolder(path)
 {
 }
 
@@ -80,9 +90,18 @@ void DiskObserverThread::observe(void)
 {
 	quint64 minimumSpace = MIN_DISKSPACE;
 	quint64 previousSpace = quint64(-1);
+	int cycle = 0;
 
 	forever
 	{
+		if((cycle++ % PROBE_CYCLES) == 0)
+		{
+			const double throughput = probeThroughput();
+			if(throughput > 0.0)
+			{
+				emit throughputChanged(throughput);
+			}
+		}
 		quint64 freeSpace = 0ui64;
 		if(MUtils::OS::free_diskspace(m_path, freeSpace))
 		{
@@ -102,6 +121,50 @@ void DiskObserverThread::observe(void)
 	}
 }
 
+/*
+ * Measures the write throughput that is currently available on the temp drive by timing a small,
+ * unbuffered write-through file. The result drops when the running jobs saturate the drive.
+ */
+double DiskObserverThread::probeThroughput(void)
+{
+	const QString probeFile = QString("%1/~%2.tmp").arg(m_tempFolder, MUtils::next_rand_str());
+	const HANDLE hProbe = CreateFileW(MUTILS_WCHR(QDir::toNativeSeparators(probeFile)), GENERIC_WRITE, 0, NULL, CREATE_NEW, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+	if(hProbe == INVALID_HANDLE_VALUE)
+	{
+		return -1.0;
+	}
+
+	//Unbuffered I/O requires a sector-aligned buffer, VirtualAlloc() returns page-aligned memory
+	void *const buffer = VirtualAlloc(NULL, PROBE_CHUNK, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+	if(!buffer)
+	{
+		CloseHandle(hProbe);
+		return -1.0;
+	}
+
+	bool success = true;
+	QElapsedTimer timer;
+	timer.start();
+
+	for(DWORD i = 0; success && (i < PROBE_CHUNKS); i++)
+	{
+		DWORD bytesWritten = 0;
+		success = WriteFile(hProbe, buffer, PROBE_CHUNK, &bytesWritten, NULL) && (bytesWritten == PROBE_CHUNK);
+	}
+
+	const qint64 elapsed = timer.nsecsElapsed();
+
+	VirtualFree(buffer, 0, MEM_RELEASE);
+	CloseHandle(hProbe); /*deletes the file*/
+
+	if((!success) || (elapsed <= 0))
+	{
+		return -1.0;
+	}
+
+	return static_cast<double>(PROBE_CHUNK * PROBE_CHUNKS) / (static_cast<double>(elapsed) / 1000000000.0);
+}
+
 QString DiskObserverThread::makeRootDir(const QString &baseDir)
 {
 	QDir dir(baseDir);
@@ -39,13 +39,17 @@ protected:
 	void run(void);
 	void observe(void);
 
+	double probeThroughput(void);
+
 	static QString makeRootDir(const QString &baseDir);
 
 signals:
 	void messageLogged(const QString &text, int type);
 	void freeSpaceChanged(const quint64);
+	void throughputChanged(const double);
 
 private:
 	QSemaphore m_semaphore;
 	const QString m_path;
+	const QString m_tempFolder;
 };
@@ -27,6 +27,7 @@
 #include "LockedFile.h"
 #include "Model_AudioFile.h"
 #include "Thread_FileAnalyzer_Task.h"
+#include "Thread_FileAnalyzer_Cache.h"
 #include "PlaylistImporter.h"
 
 //MUtils
@@ -47,6 +48,15 @@
 #include <QTimer>
 #include <QQueue>
 
+//Batch size limits
+static const int    MAX_BATCH_SIZE       = 16;           //maximum number of files per MediaInfo invocation
+static const int    MAX_BATCH_CMD_LENGTH = 24576;        //stay well below the command-line length limit
+static const qint64 MAX_BATCH_FILE_SIZE  = 67108864i64;  //larger files are always analyzed individually
+
+//Delivery of the results
+static const int    MAX_RESULT_BATCH     = 256;          //maximum number of files per "filesAnalyzed" signal
+static const int    RESULT_INTERVAL      = 100;          //pending results are delivered at least this often (in milliseconds)
+
 //Insert into QStringList *without* duplicates
 static inline void SAFE_APPEND_STRING(QStringList &list, const QString &str)
 {
@@ -60,17 +70,21 @@ static inline void SAFE_APPEND_STRING(QStringList &list, const QString &str)
 // Constructor
 ////////////////////////////////////////////////////////////
 
-FileAnalyzer::FileAnalyzer(const QStringList &inputFiles)
+FileAnalyzer::FileAnalyzer(const QStringList &inputFiles, const bool &useCache, const bool &useProbe)
 :
 	m_tasksCounterNext(0),
 	m_tasksCounterDone(0),
-	m_inputFiles(inputFiles)
+	m_inputFiles(inputFiles),
+	m_cache(useCache ? AnalysisCache::instance() : NULL),
+	m_useProbe(useProbe)
 {
 	m_filesAccepted = 0;
 	m_filesRejected = 0;
 	m_filesDenied = 0;
 	m_filesDummyCDDA = 0;
 	m_filesCueSheet = 0;
+	m_cacheHits = 0;
+	m_cacheMisses = 0;
 
 	moveToThread(this); /*makes sure queued slots are executed in the proper thread context*/
 	m_timer.reset(new QElapsedTimer());
@@ -108,6 +122,8 @@ void FileAnalyzer::run()
 	m_filesDenied = 0;
 	m_filesDummyCDDA = 0;
 	m_filesCueSheet = 0;
+	m_cacheHits = 0;
+	m_cacheMisses = 0;
 
 	m_timer->invalidate();
 
@@ -144,11 +160,27 @@ void FileAnalyzer::run()
 	//Start first N threads
 	QTimer::singleShot(0, this, SLOT(initializeTasks()));
 
+	//Deliver the results in batches
+	QTimer resultTimer;
+	connect(&resultTimer, SIGNAL(timeout()), this, SLOT(flushResults()));
+	resultTimer.start(RESULT_INTERVAL);
+
 	//Start event processing
 	this->exec();
+	resultTimer.stop();
 
 	//Wait for pending tasks to complete
 	m_pool->waitForDone();
+	flushResults();
+
+	//Write back the analysis cache
+	if(m_cache)
+	{
+		AnalysisCache::statistics_t stats;
+		m_cache->flush(&stats);
+		m_cacheHits = stats.hits;
+		m_cacheMisses = stats.misses + stats.stale;
+	}
 
 	//Was opertaion aborted?
 	if(MUTILS_BOOLIFY(m_bAborted))
@@ -167,8 +199,9 @@ void FileAnalyzer::run()
 		QList<unsigned int> keys = m_completedFiles.keys(); qSort(keys);
 		while(!keys.isEmpty())
 		{
-			emit fileAnalyzed(m_completedFiles.take(keys.takeFirst()));
+			queueResult(m_completedFiles.take(keys.takeFirst()));
 		}
+		flushResults();
 	}
 
 	qDebug("All files added.\n");
@@ -184,7 +217,7 @@ bool FileAnalyzer::analyzeNextFile(void)
 {
 	if(!(m_inputFiles.isEmpty() || MUTILS_BOOLIFY(m_bAborted)))
 	{
-		const unsigned int taskId = m_tasksCounterNext++;
+		const unsigned int taskId = m_tasksCounterNext;
 		const QString currentFile = QDir::fromNativeSeparators(m_inputFiles.takeFirst());
 
 		if((!m_timer->isValid()) || (m_timer->elapsed() >= 333))
@@ -192,8 +225,33 @@ bool FileAnalyzer::analyzeNextFile(void)
 			emit fileSelected(QFileInfo(currentFile).fileName());
 			m_timer->restart();
 		}
-	
-		AnalyzeTask *task = new AnalyzeTask(taskId, currentFile, m_bAborted);
+
+		//Group small files from the same directory into a single batch, but keep all threads busy
+		QStringList batchFiles(currentFile);
+		const int maxBatchSize = qBound(1, (m_inputFiles.count() + 1) / qMax(1, m_pool->maxThreadCount()), MAX_BATCH_SIZE);
+		if(maxBatchSize > 1)
+		{
+			const QFileInfo currentInfo(currentFile);
+			int cmdLength = currentFile.length();
+			if(currentInfo.size() <= MAX_BATCH_FILE_SIZE)
+			{
+				while((batchFiles.count() < maxBatchSize) && (!m_inputFiles.isEmpty()))
+				{
+					const QString nextFile = QDir::fromNativeSeparators(m_inputFiles.first());
+					const QFileInfo nextInfo(nextFile);
+					if((nextInfo.absolutePath().compare(currentInfo.absolutePath(), Qt::CaseInsensitive) != 0) || (nextInfo.size() > MAX_BATCH_FILE_SIZE) || ((cmdLength += nextFile.length() + 3) > MAX_BATCH_CMD_LENGTH))
+					{
+						break;
+					}
+					batchFiles << nextFile;
+					m_inputFiles.removeFirst();
+				}
+			}
+		}
+
+		m_tasksCounterNext += batchFiles.count();
+
+		AnalyzeTask *task = new AnalyzeTask(taskId, batchFiles, m_bAborted, m_cache, m_useProbe);
 		connect(task, SIGNAL(fileAnalyzed(const unsigned int, const int, AudioFileModel)), this, SLOT(taskFileAnalyzed(unsigned int, const int, AudioFileModel)), Qt::QueuedConnection);
 		connect(task, SIGNAL(taskCompleted(const unsigned int)), this, SLOT(taskThreadFinish(const unsigned int)), Qt::QueuedConnection);
 		m_runningTaskIds.insert(taskId); m_pool->start(task);
@@ -259,6 +317,15 @@ void FileAnalyzer::handlePlaylistFiles(void)
 // Slot Functions
 ////////////////////////////////////////////////////////////
 
+void FileAnalyzer::queueResult(const AudioFileModel &file)
+{
+	m_pendingResults << file;
+	if(m_pendingResults.count() >= MAX_RESULT_BATCH)
+	{
+		flushResults();
+	}
+}
+
 void FileAnalyzer::initializeTasks(void)
 {
 	for(int i = 0; i < m_pool->maxThreadCount(); i++)
@@ -270,6 +337,7 @@ void FileAnalyzer::initializeTasks(void)
 void FileAnalyzer::taskFileAnalyzed(const unsigned int taskId, const int fileType, const AudioFileModel &file)
 {
 	m_completedTaskIds.insert(taskId);
+	emit progressValChanged(++m_completedCounter);
 
 	switch(fileType)
 	{
@@ -277,7 +345,7 @@ void FileAnalyzer::taskFileAnalyzed(const unsigned int taskId, const int fileTyp
 		m_filesAccepted++;
 		if(m_tasksCounterDone == taskId)
 		{
-			emit fileAnalyzed(file);
+			queueResult(file);
 			m_tasksCounterDone++;
 		}
 		else
@@ -306,17 +374,25 @@ void FileAnalyzer::taskFileAnalyzed(const unsigned int taskId, const int fileTyp
 	{
 		if(m_completedFiles.contains(m_tasksCounterDone))
 		{
-			emit fileAnalyzed(m_completedFiles.take(m_tasksCounterDone));
+			queueResult(m_completedFiles.take(m_tasksCounterDone));
 		}
 		m_completedTaskIds.remove(m_tasksCounterDone);
 		m_tasksCounterDone++;
 	}
 }
 
+void FileAnalyzer::flushResults(void)
+{
+	if(!m_pendingResults.isEmpty())
+	{
+		emit filesAnalyzed(m_pendingResults);
+		m_pendingResults.clear();
+	}
+}
+
 void FileAnalyzer::taskThreadFinish(const unsigned int taskId)
 {
 	m_runningTaskIds.remove(taskId);
-	emit progressValChanged(++m_completedCounter);
 
 	if(!analyzeNextFile())
 	{
@@ -356,6 +432,16 @@ unsigned int FileAnalyzer::filesCueSheet(void)
 	return m_filesCueSheet;
 }
 
+unsigned int FileAnalyzer::cacheHits(void)
+{
+	return m_cacheHits;
+}
+
+unsigned int FileAnalyzer::cacheMisses(void)
+{
+	return m_cacheMisses;
+}
+
 ////////////////////////////////////////////////////////////
 // EVENTS
 ////////////////////////////////////////////////////////////
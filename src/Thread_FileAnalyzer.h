@@ -36,6 +36,7 @@ class QFileInfo;
 class LockedFile;
 class QThreadPool;
 class QElapsedTimer;
+class AnalysisCache;
 
 ////////////////////////////////////////////////////////////
 // Splash Thread
@@ -46,7 +47,7 @@ class FileAnalyzer: public QThread
 	Q_OBJECT
 
 public:
-	FileAnalyzer(const QStringList &inputFiles);
+	FileAnalyzer(const QStringList &inputFiles, const bool &useCache = false, const bool &useProbe = true);
 	~FileAnalyzer(void);
 	void run();
 	bool getSuccess(void) { return (!isRunning()) && (!m_bAborted) && MUTILS_BOOLIFY(m_bSuccess); }
@@ -56,10 +57,12 @@ public:
 	unsigned int filesDenied(void);
 	unsigned int filesDummyCDDA(void);
 	unsigned int filesCueSheet(void);
+	unsigned int cacheHits(void);
+	unsigned int cacheMisses(void);
 
 signals:
 	void fileSelected(const QString &fileName);
-	void fileAnalyzed(const AudioFileModel &file);
+	void filesAnalyzed(const QList<AudioFileModel> &files);
 	void progressValChanged(unsigned int);
 	void progressMaxChanged(unsigned int);
 
@@ -70,10 +73,12 @@ private slots:
 	void initializeTasks(void);
 	void taskFileAnalyzed(const unsigned int taskId, const int fileType, const AudioFileModel &file);
 	void taskThreadFinish(const unsigned int);
+	void flushResults(void);
 
 private:
 	bool analyzeNextFile(void);
 	void handlePlaylistFiles(void);
+	void queueResult(const AudioFileModel &file);
 
 	QScopedPointer<QThreadPool> m_pool;
 	QScopedPointer<QElapsedTimer> m_timer;
@@ -87,12 +92,17 @@ private:
 	unsigned int m_filesDenied;
 	unsigned int m_filesDummyCDDA;
 	unsigned int m_filesCueSheet;
+	unsigned int m_cacheHits;
+	unsigned int m_cacheMisses;
 
 	QStringList m_inputFiles;
+	AnalysisCache *const m_cache;
+	const bool m_useProbe;
 
 	QSet<unsigned int> m_completedTaskIds;
 	QSet<unsigned int> m_runningTaskIds;
 	QHash<unsigned int, AudioFileModel> m_completedFiles;
+	QList<AudioFileModel> m_pendingResults;
 
 	static const char *g_tags_gen[];
 	static const char *g_tags_aud[];
@@ -0,0 +1,428 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+#include "Thread_FileAnalyzer_Cache.h"
+
+//Internal
+#include "Global.h"
+#include "Model_AudioFile.h"
+
+//MUtils
+#include <MUtils/Global.h>
+
+//Qt
+#include <QApplication>
+#include <QDesktopServices>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+#include <QElapsedTimer>
+#include <QVector>
+
+//CRT
+#include <algorithm>
+
+////////////////////////////////////////////////////////////
+// Constants
+////////////////////////////////////////////////////////////
+
+static const char *const CACHE_MAGIC   = "LameXP_AnalysisCache";
+static const quint32     CACHE_VERSION = 2U;
+
+static const int     MAX_ENTRIES = 131072;           //maximum number of entries kept in the cache
+static const quint32 MAX_AGE     = 180U * 86400U;    //entries that have not been used for 180 days are evicted
+static const quint32 TOUCH_AGE   = 86400U;           //the time of last use is written back at most once per day
+
+////////////////////////////////////////////////////////////
+// Static Objects
+////////////////////////////////////////////////////////////
+
+QMutex AnalysisCache::s_instanceMutex;
+QScopedPointer<AnalysisCache> AnalysisCache::s_instance;
+
+////////////////////////////////////////////////////////////
+// Constructor & Destructor
+////////////////////////////////////////////////////////////
+
+AnalysisCache::AnalysisCache(const QString &cacheFile)
+:
+	m_cacheFile(cacheFile),
+	m_dirty(false),
+	m_statsHits(0U),
+	m_statsMisses(0U),
+	m_statsStale(0U),
+	m_statsInserted(0U)
+{
+	load();
+}
+
+AnalysisCache::~AnalysisCache(void)
+{
+	flush();
+}
+
+AnalysisCache *AnalysisCache::instance(void)
+{
+	QMutexLocker lock(&s_instanceMutex);
+
+	if(s_instance.isNull())
+	{
+		QString cachePath;
+		if(!lamexp_version_portable())
+		{
+			const QString dataPath = QDesktopServices::storageLocation(QDesktopServices::DataLocation);
+			if((!dataPath.isEmpty()) && QDir().mkpath(dataPath))
+			{
+				cachePath = QString("%1/analysis.cache").arg(QDir(dataPath).canonicalPath());
+			}
+		}
+		else
+		{
+			const QFileInfo appPath(QApplication::applicationFilePath());
+			cachePath = QString("%1/%2.cache").arg(appPath.absolutePath(), appPath.completeBaseName());
+		}
+
+		if(cachePath.isEmpty())
+		{
+			qWarning("AnalysisCache: Failed to determine cache location!");
+			return NULL;
+		}
+
+		s_instance.reset(new AnalysisCache(cachePath));
+	}
+
+	return s_instance.data();
+}
+
+////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////
+
+bool AnalysisCache::lookup(const QString &filePath, AudioFileModel &audioFile)
+{
+	QString key;
+	qint64 fileSize, fileTime;
+
+	if(!makeKey(filePath, key, fileSize, fileTime))
+	{
+		return false;
+	}
+
+	QByteArray data;
+	{
+		QMutexLocker lock(&m_mutex);
+		QHash<QString, cache_entry_t>::Iterator iter = m_entries.find(key);
+		if(iter == m_entries.end())
+		{
+			m_statsMisses++;
+			return false;
+		}
+		if((iter->fileSize != fileSize) || (iter->fileTime != fileTime))
+		{
+			m_statsStale++;
+			m_entries.erase(iter);
+			m_dirty = true;
+			return false;
+		}
+		const quint32 now = QDateTime::currentDateTime().toTime_t();
+		if((now > iter->lastUsed) && ((now - iter->lastUsed) > TOUCH_AGE))
+		{
+			iter->lastUsed = now;
+			m_dirty = true;
+		}
+		data = iter->data;
+		m_statsHits++;
+	}
+
+	return deserialize(data, audioFile);
+}
+
+void AnalysisCache::insert(const QString &filePath, const AudioFileModel &audioFile)
+{
+	QString key;
+	qint64 fileSize, fileTime;
+
+	if(!makeKey(filePath, key, fileSize, fileTime))
+	{
+		return;
+	}
+
+	cache_entry_t entry;
+	entry.fileSize = fileSize;
+	entry.fileTime = fileTime;
+	entry.lastUsed = QDateTime::currentDateTime().toTime_t();
+	entry.data = serialize(audioFile);
+
+	QMutexLocker lock(&m_mutex);
+	m_entries.insert(key, entry);
+	m_statsInserted++;
+	m_dirty = true;
+}
+
+void AnalysisCache::flush(statistics_t *const stats)
+{
+	QMutexLocker lock(&m_mutex);
+
+	if(stats)
+	{
+		stats->hits     = m_statsHits;
+		stats->misses   = m_statsMisses;
+		stats->stale    = m_statsStale;
+		stats->inserted = m_statsInserted;
+	}
+
+	//Statistics that are returned to the caller will be reported by the caller
+	const quint32 lookups = m_statsHits + m_statsMisses + m_statsStale;
+	if((!stats) && (lookups > 0U))
+	{
+		qDebug("AnalysisCache: %u hit(s), %u miss(es), %u stale, %u inserted (hit rate: %.1f%%)", m_statsHits, m_statsMisses, m_statsStale, m_statsInserted, (100.0 * double(m_statsHits)) / double(lookups));
+	}
+	m_statsHits = m_statsMisses = m_statsStale = m_statsInserted = 0U;
+
+	if(m_dirty)
+	{
+		compact();
+		if(save())
+		{
+			m_dirty = false;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////
+
+void AnalysisCache::load(void)
+{
+	QElapsedTimer timer;
+	timer.start();
+
+	QFile file(m_cacheFile);
+	if(!file.open(QIODevice::ReadOnly))
+	{
+		qDebug("AnalysisCache: No existing cache file found.");
+		return;
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_4_8);
+
+	QByteArray magic;
+	quint32 version, toolVersion, count;
+	stream >> magic >> version >> toolVersion >> count;
+
+	if((stream.status() != QDataStream::Ok) || (magic != CACHE_MAGIC) || (version != CACHE_VERSION))
+	{
+		qWarning("AnalysisCache: Cache file is invalid or outdated, discarding!");
+		return;
+	}
+
+	if(toolVersion != lamexp_tools_version("mediainfo.exe"))
+	{
+		qWarning("AnalysisCache: MediaInfo version has changed, discarding cache!");
+		return;
+	}
+
+	for(quint32 i = 0; i < count; i++)
+	{
+		QString key;
+		cache_entry_t entry;
+		stream >> key >> entry.fileSize >> entry.fileTime >> entry.lastUsed >> entry.data;
+		if(stream.status() != QDataStream::Ok)
+		{
+			qWarning("AnalysisCache: Cache file is truncated, discarding!");
+			m_entries.clear();
+			return;
+		}
+		m_entries.insert(key, entry);
+	}
+
+	qDebug("AnalysisCache: Loaded %d entries in %lld msec.", m_entries.count(), timer.elapsed());
+}
+
+bool AnalysisCache::save(void)
+{
+	const QString tempFile = QString("%1.tmp").arg(m_cacheFile);
+
+	QFile file(tempFile);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		qWarning("AnalysisCache: Failed to open cache file for writing!");
+		return false;
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_4_8);
+	stream << QByteArray(CACHE_MAGIC) << CACHE_VERSION << lamexp_tools_version("mediainfo.exe") << quint32(m_entries.count());
+
+	for(QHash<QString, cache_entry_t>::ConstIterator iter = m_entries.constBegin(); iter != m_entries.constEnd(); iter++)
+	{
+		stream << iter.key() << iter->fileSize << iter->fileTime << iter->lastUsed << iter->data;
+	}
+
+	file.close();
+	if((stream.status() != QDataStream::Ok) || (file.error() != QFile::NoError))
+	{
+		qWarning("AnalysisCache: Failed to write cache file!");
+		QFile::remove(tempFile);
+		return false;
+	}
+
+	//Replace the previous cache file
+	if(QFileInfo(m_cacheFile).exists() && (!QFile::remove(m_cacheFile)))
+	{
+		qWarning("AnalysisCache: Failed to remove previous cache file!");
+		QFile::remove(tempFile);
+		return false;
+	}
+	if(!QFile::rename(tempFile, m_cacheFile))
+	{
+		qWarning("AnalysisCache: Failed to rename cache file!");
+		return false;
+	}
+
+	qDebug("AnalysisCache: Saved %d entries.", m_entries.count());
+	return true;
+}
+
+void AnalysisCache::compact(void)
+{
+	const quint32 now = QDateTime::currentDateTime().toTime_t();
+	const int countBefore = m_entries.count();
+
+	//Evict entries that have not been used for a long time
+	for(QHash<QString, cache_entry_t>::Iterator iter = m_entries.begin(); iter != m_entries.end();)
+	{
+		if((now > iter->lastUsed) && ((now - iter->lastUsed) > MAX_AGE))
+		{
+			iter = m_entries.erase(iter);
+			continue;
+		}
+		iter++;
+	}
+
+	//Evict least recently used entries, if the cache is still too large
+	if(m_entries.count() > MAX_ENTRIES)
+	{
+		//Many entries may share the same time of last use, so exactly "excess" entries are selected by (time, key)
+		QVector<QPair<quint32, QString>> timestamps;
+		timestamps.reserve(m_entries.count());
+		for(QHash<QString, cache_entry_t>::ConstIterator iter = m_entries.constBegin(); iter != m_entries.constEnd(); iter++)
+		{
+			timestamps << qMakePair(iter->lastUsed, iter.key());
+		}
+		const int excess = m_entries.count() - ((MAX_ENTRIES * 7) / 8);
+		std::nth_element(timestamps.begin(), timestamps.begin() + excess, timestamps.end());
+		for(int i = 0; i < excess; i++)
+		{
+			m_entries.remove(timestamps.at(i).second);
+		}
+	}
+
+	if(m_entries.count() != countBefore)
+	{
+		qDebug("AnalysisCache: Compacted cache, %d entries evicted.", countBefore - m_entries.count());
+	}
+}
+
+bool AnalysisCache::makeKey(const QString &filePath, QString &key, qint64 &fileSize, qint64 &fileTime)
+{
+	const QFileInfo fileInfo(filePath);
+	const QString canonicalPath = fileInfo.canonicalFilePath();
+
+	if(canonicalPath.isEmpty() || (!fileInfo.isFile()))
+	{
+		return false;
+	}
+
+	key = canonicalPath.toLower(); /*file system is case-insensitive*/
+	fileSize = fileInfo.size();
+	fileTime = fileInfo.lastModified().toMSecsSinceEpoch();
+	return true;
+}
+
+QByteArray AnalysisCache::serialize(const AudioFileModel &audioFile)
+{
+	QByteArray data;
+	QDataStream stream(&data, QIODevice::WriteOnly);
+	stream.setVersion(QDataStream::Qt_4_8);
+
+	const AudioFileModel_MetaInfo &metaInfo = audioFile.metaInfo();
+	stream << metaInfo.title() << metaInfo.artist() << metaInfo.album() << metaInfo.genre() << metaInfo.comment();
+	stream << quint32(metaInfo.year()) << quint32(metaInfo.position()) << metaInfo.coverEmbedded();
+
+	const AudioFileModel_TechInfo &techInfo = audioFile.techInfo();
+	stream << techInfo.containerType() << techInfo.containerProfile() << techInfo.audioType() << techInfo.audioProfile() << techInfo.audioVersion() << techInfo.audioEncodeLib();
+	stream << quint32(techInfo.audioSamplerate()) << quint32(techInfo.audioChannels()) << quint32(techInfo.audioBitdepth()) << quint32(techInfo.audioBitrate()) << quint32(techInfo.audioBitrateMode()) << quint32(techInfo.duration());
+
+	return data;
+}
+
+bool AnalysisCache::deserialize(const QByteArray &data, AudioFileModel &audioFile)
+{
+	QDataStream stream(data);
+	stream.setVersion(QDataStream::Qt_4_8);
+
+	QString str[11];
+	quint32 val[8];
+	bool coverEmbedded;
+
+	stream >> str[0] >> str[1] >> str[2] >> str[3] >> str[4];
+	stream >> val[0] >> val[1] >> coverEmbedded;
+	stream >> str[5] >> str[6] >> str[7] >> str[8] >> str[9] >> str[10];
+	stream >> val[2] >> val[3] >> val[4] >> val[5] >> val[6] >> val[7];
+
+	if(stream.status() != QDataStream::Ok)
+	{
+		qWarning("AnalysisCache: Failed to deserialize cache entry!");
+		return false;
+	}
+
+	AudioFileModel_MetaInfo &metaInfo = audioFile.metaInfo();
+	metaInfo.setTitle(str[0]);
+	metaInfo.setArtist(str[1]);
+	metaInfo.setAlbum(str[2]);
+	metaInfo.setGenre(str[3]);
+	metaInfo.setComment(str[4]);
+	metaInfo.setYear(val[0]);
+	metaInfo.setPosition(val[1]);
+	metaInfo.setCoverEmbedded(coverEmbedded);
+
+	AudioFileModel_TechInfo &techInfo = audioFile.techInfo();
+	techInfo.setContainerType(str[5]);
+	techInfo.setContainerProfile(str[6]);
+	techInfo.setAudioType(str[7]);
+	techInfo.setAudioProfile(str[8]);
+	techInfo.setAudioVersion(str[9]);
+	techInfo.setAudioEncodeLib(str[10]);
+	techInfo.setAudioSamplerate(val[2]);
+	techInfo.setAudioChannels(val[3]);
+	techInfo.setAudioBitdepth(val[4]);
+	techInfo.setAudioBitrate(val[5]);
+	techInfo.setAudioBitrateMode(val[6]);
+	techInfo.setDuration(val[7]);
+
+	return true;
+}
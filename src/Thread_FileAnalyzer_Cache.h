@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <QString>
+#include <QHash>
+#include <QMutex>
+#include <QScopedPointer>
+
+class AudioFileModel;
+
+////////////////////////////////////////////////////////////
+// Analysis Cache
+////////////////////////////////////////////////////////////
+
+class AnalysisCache
+{
+public:
+	~AnalysisCache(void);
+
+	typedef struct
+	{
+		quint32 hits;
+		quint32 misses;
+		quint32 stale;
+		quint32 inserted;
+	}
+	statistics_t;
+
+	static AnalysisCache *instance(void);
+
+	bool lookup(const QString &filePath, AudioFileModel &audioFile);
+	void insert(const QString &filePath, const AudioFileModel &audioFile);
+
+	//Write back the cache, returns (and resets) the statistics that have been collected since the last flush
+	void flush(statistics_t *const stats = NULL);
+
+private:
+	AnalysisCache(const QString &cacheFile);
+
+	typedef struct
+	{
+		qint64 fileSize;
+		qint64 fileTime;
+		quint32 lastUsed;
+		QByteArray data;
+	}
+	cache_entry_t;
+
+	void load(void);
+	bool save(void);
+	void compact(void);
+
+	static bool makeKey(const QString &filePath, QString &key, qint64 &fileSize, qint64 &fileTime);
+	static QByteArray serialize(const AudioFileModel &audioFile);
+	static bool deserialize(const QByteArray &data, AudioFileModel &audioFile);
+
+	const QString m_cacheFile;
+	QHash<QString, cache_entry_t> m_entries;
+	QMutex m_mutex;
+	bool m_dirty;
+
+	quint32 m_statsHits;
+	quint32 m_statsMisses;
+	quint32 m_statsStale;
+	quint32 m_statsInserted;
+
+	static QMutex s_instanceMutex;
+	static QScopedPointer<AnalysisCache> s_instance;
+};
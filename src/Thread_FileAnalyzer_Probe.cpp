@@ -0,0 +1,941 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+#include "Thread_FileAnalyzer_Probe.h"
+
+//Internal
+#include "Global.h"
+#include "Genres.h"
+#include "Model_AudioFile.h"
+
+//MUtils
+#include <MUtils/Global.h>
+
+//Qt
+#include <QFile>
+#include <QFileInfo>
+#include <QRegExp>
+#include <QTextCodec>
+
+//CRT
+#include <string.h>
+
+////////////////////////////////////////////////////////////
+// Constants
+////////////////////////////////////////////////////////////
+
+static const int MAX_CHUNKS      = 64;        //maximum number of RIFF chunks or FLAC blocks to examine
+static const int MAX_BLOCK_SIZE  = 1048576;   //maximum size of tag blocks that will be parsed
+static const int MAX_SCAN_SIZE   = 8192;      //maximum number of bytes to read when looking for the first MPEG frame
+static const int OGG_TAIL_SIZE   = 65536;     //number of bytes to read from the end of an Ogg file
+
+static const quint32 MPEG_BITRATES[2][3][16] =
+{
+	{
+		{ 0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448, 0 },
+		{ 0, 32, 48, 56,  64,  80,  96, 112, 128, 160, 192, 224, 256, 320, 384, 0 },
+		{ 0, 32, 40, 48,  56,  64,  80,  96, 112, 128, 160, 192, 224, 256, 320, 0 }
+	},
+	{
+		{ 0, 32, 48, 56,  64,  80,  96, 112, 128, 144, 160, 176, 192, 224, 256, 0 },
+		{ 0,  8, 16, 24,  32,  40,  48,  56,  64,  80,  96, 112, 128, 144, 160, 0 },
+		{ 0,  8, 16, 24,  32,  40,  48,  56,  64,  80,  96, 112, 128, 144, 160, 0 }
+	}
+};
+
+static const quint32 MPEG_SAMPLERATES[3][3] =
+{
+	{ 44100, 48000, 32000 },
+	{ 22050, 24000, 16000 },
+	{ 11025, 12000,  8000 }
+};
+
+static const char *const MPEG_VERSIONS[3] = { "Version 1", "Version 2", "Version 2.5" };
+static const char *const MPEG_LAYERS[3]   = { "Layer 1", "Layer 2", "Layer 3" };
+
+////////////////////////////////////////////////////////////
+// Helper Functions
+////////////////////////////////////////////////////////////
+
+#define BYTE_AT(PTR, IDX) (static_cast<quint32>(reinterpret_cast<const uchar*>((PTR))[(IDX)]))
+
+static inline quint32 RD_LE16(const char *const p) { return BYTE_AT(p, 0) | (BYTE_AT(p, 1) << 8); }
+static inline quint32 RD_LE32(const char *const p) { return BYTE_AT(p, 0) | (BYTE_AT(p, 1) << 8) | (BYTE_AT(p, 2) << 16) | (BYTE_AT(p, 3) << 24); }
+static inline quint32 RD_BE16(const char *const p) { return (BYTE_AT(p, 0) << 8) | BYTE_AT(p, 1); }
+static inline quint32 RD_BE32(const char *const p) { return (BYTE_AT(p, 0) << 24) | (BYTE_AT(p, 1) << 16) | (BYTE_AT(p, 2) << 8) | BYTE_AT(p, 3); }
+static inline quint32 RD_SYNCSAFE32(const char *const p) { return (BYTE_AT(p, 0) << 21) | (BYTE_AT(p, 1) << 14) | (BYTE_AT(p, 2) << 7) | BYTE_AT(p, 3); }
+static inline qint64  RD_LE64(const char *const p) { return static_cast<qint64>(quint64(RD_LE32(p)) | (quint64(RD_LE32(p + 4)) << 32)); }
+
+typedef struct
+{
+	quint32 version; //0 = MPEG-1, 1 = MPEG-2, 2 = MPEG-2.5
+	quint32 layer;
+	quint32 bitrate;
+	quint32 sampleRate;
+	quint32 samplesPerFrame;
+	quint32 frameSize;
+	quint32 channels;
+}
+mpeg_header_t;
+
+static bool parseMpegHeader(const quint32 header, mpeg_header_t &info)
+{
+	if((header & 0xFFE00000) != 0xFFE00000)
+	{
+		return false;
+	}
+
+	const quint32 versionBits = (header >> 19) & 0x3, layerBits = (header >> 17) & 0x3;
+	const quint32 bitrateIdx = (header >> 12) & 0xF, sampleRateIdx = (header >> 10) & 0x3;
+
+	if((versionBits == 1) || (layerBits == 0) || (bitrateIdx == 0) || (bitrateIdx == 15) || (sampleRateIdx == 3))
+	{
+		return false; /*reserved values or free format*/
+	}
+
+	info.version = (versionBits == 3) ? 0 : ((versionBits == 2) ? 1 : 2);
+	info.layer = 4 - layerBits;
+	info.bitrate = MPEG_BITRATES[(info.version > 0) ? 1 : 0][info.layer - 1][bitrateIdx];
+	info.sampleRate = MPEG_SAMPLERATES[info.version][sampleRateIdx];
+	info.samplesPerFrame = (info.layer == 1) ? 384 : (((info.layer == 3) && (info.version > 0)) ? 576 : 1152);
+	info.channels = (((header >> 6) & 0x3) == 0x3) ? 1 : 2;
+
+	const quint32 padding = (header >> 9) & 0x1;
+	info.frameSize = (info.layer == 1) ? (((12000U * info.bitrate) / info.sampleRate) + padding) * 4U : (((info.samplesPerFrame / 8U) * 1000U * info.bitrate) / info.sampleRate) + padding;
+
+	return true;
+}
+
+static QString decodeAnsi(const char *const data, const int len)
+{
+	const int textLen = static_cast<int>(qstrnlen(data, len));
+	QTextCodec::ConverterState state;
+	const QString text = QTextCodec::codecForName("UTF-8")->toUnicode(data, textLen, &state);
+	return (state.invalidChars > 0) ? QString::fromLatin1(data, textLen) : text;
+}
+
+static int findID3Terminator(const char *const data, const int len, const quint32 encoding)
+{
+	if((encoding == 1) || (encoding == 2))
+	{
+		for(int i = 0; i + 1 < len; i += 2)
+		{
+			if((data[i] == 0) && (data[i + 1] == 0)) return i;
+		}
+		return len;
+	}
+	return static_cast<int>(qstrnlen(data, len));
+}
+
+static QString decodeID3Text(const char *data, int len, const quint32 encoding)
+{
+	len = findID3Terminator(data, len, encoding);
+	switch(encoding)
+	{
+	case 0:
+		return QString::fromLatin1(data, len);
+	case 1:
+	case 2:
+		{
+			bool bigEndian = (encoding == 2);
+			if((encoding == 1) && (len >= 2))
+			{
+				if((BYTE_AT(data, 0) == 0xFE) && (BYTE_AT(data, 1) == 0xFF)) { bigEndian = true;  data += 2; len -= 2; }
+				else if((BYTE_AT(data, 0) == 0xFF) && (BYTE_AT(data, 1) == 0xFE)) { bigEndian = false; data += 2; len -= 2; }
+			}
+			QString text;
+			text.reserve(len / 2);
+			for(int i = 0; i + 1 < len; i += 2)
+			{
+				text.append(QChar(static_cast<ushort>(bigEndian ? RD_BE16(data + i) : RD_LE16(data + i))));
+			}
+			return text;
+		}
+	case 3:
+		return QString::fromUtf8(data, len);
+	default:
+		return QString();
+	}
+}
+
+static int genreCount(void)
+{
+	static int count = -1;
+	if(count < 0)
+	{
+		int i = 0;
+		while(g_lamexp_generes[i]) i++;
+		count = i;
+	}
+	return count;
+}
+
+////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////
+
+bool HeaderProbe::probe(const QString &filePath, AudioFileModel &audioFile)
+{
+	QFile file(filePath);
+	if(!file.open(QIODevice::ReadOnly))
+	{
+		return false;
+	}
+
+	const QByteArray magic = file.read(12);
+	if(magic.size() < 12)
+	{
+		return false;
+	}
+
+	AudioFileModel_MetaInfo metaInfo;
+	AudioFileModel_TechInfo techInfo;
+	bool success = false;
+
+	if(magic.startsWith("RIFF") && (magic.mid(8, 4) == "WAVE"))
+	{
+		success = probeWave(file, metaInfo, techInfo);
+	}
+	else if(magic.startsWith("OggS"))
+	{
+		success = probeOgg(file, metaInfo, techInfo);
+	}
+	else
+	{
+		qint64 offset = 0;
+		if(magic.startsWith("ID3"))
+		{
+			const quint8 version = static_cast<quint8>(magic.at(3)), flags = static_cast<quint8>(magic.at(5));
+			if((version < 3) || (version > 4) || (flags & 0xC0) || ((RD_BE32(magic.constData() + 6) & 0x80808080) != 0))
+			{
+				return false; /*unsupported version, unsynchronisation or extended header*/
+			}
+			const quint32 tagSize = RD_SYNCSAFE32(magic.constData() + 6);
+			if((!file.seek(10)) || (tagSize > quint32(file.size())))
+			{
+				return false;
+			}
+			const QByteArray tagData = file.read(tagSize);
+			if((tagData.size() != int(tagSize)) || (!parseID3v2(tagData, version, metaInfo)))
+			{
+				return false;
+			}
+			offset = 10 + tagSize + ((flags & 0x10) ? 10 : 0);
+		}
+
+		char signature[4];
+		if((!file.seek(offset)) || (file.read(signature, 4) != 4))
+		{
+			return false;
+		}
+
+		if(memcmp(signature, "fLaC", 4) == 0)
+		{
+			success = probeFLAC(file, offset, metaInfo, techInfo);
+		}
+		else
+		{
+			const QString suffix = QFileInfo(filePath).suffix().toLower();
+			if((offset > 0) || (suffix == QLatin1String("mp3")) || (suffix == QLatin1String("mp2")) || (suffix == QLatin1String("mp1")) || (suffix == QLatin1String("mpa")))
+			{
+				success = probeMPEG(file, offset, metaInfo, techInfo);
+			}
+		}
+	}
+
+	if(success)
+	{
+		audioFile.setMetaInfo(metaInfo);
+		audioFile.setTechInfo(techInfo);
+	}
+
+	return success;
+}
+
+////////////////////////////////////////////////////////////
+// Format Parsers
+////////////////////////////////////////////////////////////
+
+bool HeaderProbe::probeWave(QFile &file, AudioFileModel_MetaInfo &metaInfo, AudioFileModel_TechInfo &techInfo)
+{
+	const qint64 fileSize = file.size();
+	quint32 formatTag = 0, channels = 0, sampleRate = 0, blockAlign = 0, bitsPerSample = 0;
+	qint64 dataSize = -1, pos = 12;
+	bool haveFormat = false;
+
+	for(int i = 0; (i < MAX_CHUNKS) && (pos + 8 <= fileSize); i++)
+	{
+		char header[8];
+		if((!file.seek(pos)) || (file.read(header, 8) != 8))
+		{
+			break;
+		}
+
+		const quint32 chunkSize = RD_LE32(header + 4);
+		if(memcmp(header, "fmt ", 4) == 0)
+		{
+			const QByteArray format = file.read(qMin(chunkSize, 40U));
+			if((chunkSize < 16) || (format.size() < 16))
+			{
+				return false;
+			}
+			formatTag = RD_LE16(format.constData());
+			channels = RD_LE16(format.constData() + 2);
+			sampleRate = RD_LE32(format.constData() + 4);
+			blockAlign = RD_LE16(format.constData() + 12);
+			bitsPerSample = RD_LE16(format.constData() + 14);
+			if(formatTag == 0xFFFE)
+			{
+				if(format.size() < 26) return false;
+				formatTag = RD_LE16(format.constData() + 24); /*first two bytes of the sub-format GUID*/
+			}
+			haveFormat = true;
+		}
+		else if(memcmp(header, "data", 4) == 0)
+		{
+			if((chunkSize == 0) || (chunkSize == 0xFFFFFFFF) || (pos + 8 + qint64(chunkSize) > fileSize))
+			{
+				return false; /*streamed or truncated file, let MediaInfo decide*/
+			}
+			dataSize = chunkSize;
+		}
+		else if((memcmp(header, "LIST", 4) == 0) && (chunkSize > 4) && (chunkSize <= quint32(MAX_BLOCK_SIZE)))
+		{
+			const QByteArray list = file.read(chunkSize);
+			if(list.startsWith("INFO"))
+			{
+				parseRiffInfo(list.mid(4), metaInfo);
+			}
+		}
+
+		pos += 8 + qint64(chunkSize) + (chunkSize & 1);
+	}
+
+	if((!haveFormat) || (dataSize < 0) || (channels == 0) || (sampleRate == 0) || (blockAlign == 0) || (bitsPerSample == 0))
+	{
+		return false;
+	}
+	if(!((formatTag == 1) || ((formatTag == 3) && (bitsPerSample == 32))))
+	{
+		return false; /*compressed or unusual format*/
+	}
+
+	techInfo.setContainerType(QLatin1String("Wave"));
+	techInfo.setAudioType(QLatin1String("PCM"));
+	if(formatTag == 3)
+	{
+		techInfo.setAudioProfile(QLatin1String("Float"));
+	}
+	techInfo.setAudioChannels(channels);
+	techInfo.setAudioSamplerate(sampleRate);
+	techInfo.setAudioBitdepth(bitsPerSample);
+	techInfo.setAudioBitrate(static_cast<unsigned int>(((quint64(sampleRate) * channels * bitsPerSample) + 500U) / 1000U));
+	techInfo.setAudioBitrateMode(AudioFileModel::BitrateModeConstant);
+	techInfo.setDuration(qRound(double(dataSize) / double(blockAlign) / double(sampleRate)));
+
+	return true;
+}
+
+bool HeaderProbe::probeFLAC(QFile &file, const qint64 offset, AudioFileModel_MetaInfo &metaInfo, AudioFileModel_TechInfo &techInfo)
+{
+	const qint64 fileSize = file.size();
+	quint32 sampleRate = 0, channels = 0, bitsPerSample = 0;
+	quint64 totalSamples = 0;
+	qint64 pos = offset + 4;
+	bool haveStreamInfo = false, lastBlock = false;
+	QString vendor;
+
+	for(int i = 0; (i < MAX_CHUNKS) && (!lastBlock); i++)
+	{
+		char header[4];
+		if((!file.seek(pos)) || (file.read(header, 4) != 4))
+		{
+			return false;
+		}
+
+		lastBlock = ((BYTE_AT(header, 0) & 0x80) != 0);
+		const quint32 blockType = BYTE_AT(header, 0) & 0x7F;
+		const quint32 blockSize = (BYTE_AT(header, 1) << 16) | (BYTE_AT(header, 2) << 8) | BYTE_AT(header, 3);
+
+		switch(blockType)
+		{
+		case 0: /*STREAMINFO*/
+			{
+				const QByteArray info = file.read(34);
+				if((blockSize < 34) || (info.size() < 34))
+				{
+					return false;
+				}
+				const char *const data = info.constData();
+				sampleRate = (BYTE_AT(data, 10) << 12) | (BYTE_AT(data, 11) << 4) | (BYTE_AT(data, 12) >> 4);
+				channels = ((BYTE_AT(data, 12) >> 1) & 0x7) + 1;
+				bitsPerSample = (((BYTE_AT(data, 12) & 0x1) << 4) | (BYTE_AT(data, 13) >> 4)) + 1;
+				totalSamples = (quint64(BYTE_AT(data, 13) & 0xF) << 32) | RD_BE32(data + 14);
+				haveStreamInfo = true;
+			}
+			break;
+		case 4: /*VORBIS_COMMENT*/
+			if(blockSize > quint32(MAX_BLOCK_SIZE))
+			{
+				return false;
+			}
+			if(!parseVorbisComment(file.read(blockSize), metaInfo, vendor))
+			{
+				return false;
+			}
+			break;
+		case 6: /*PICTURE, will be extracted on demand*/
+			metaInfo.setCoverEmbedded(true);
+			break;
+		case 127:
+			return false;
+		}
+
+		pos += 4 + qint64(blockSize);
+		if(pos > fileSize)
+		{
+			return false;
+		}
+	}
+
+	if((!haveStreamInfo) || (!lastBlock) || (sampleRate == 0) || (totalSamples == 0))
+	{
+		return false;
+	}
+
+	const double duration = double(totalSamples) / double(sampleRate);
+
+	techInfo.setContainerType(QLatin1String("FLAC"));
+	techInfo.setAudioType(QLatin1String("FLAC"));
+	techInfo.setAudioChannels(channels);
+	techInfo.setAudioSamplerate(sampleRate);
+	techInfo.setAudioBitdepth(bitsPerSample);
+	techInfo.setAudioBitrate(qRound(double(fileSize - pos) * 8.0 / duration / 1000.0));
+	techInfo.setAudioBitrateMode(AudioFileModel::BitrateModeVariable);
+	techInfo.setAudioEncodeLib(vendor.simplified());
+	techInfo.setDuration(qRound(duration));
+
+	return true;
+}
+
+bool HeaderProbe::probeMPEG(QFile &file, const qint64 offset, AudioFileModel_MetaInfo &metaInfo, AudioFileModel_TechInfo &techInfo)
+{
+	const qint64 fileSize = file.size();
+	if(!file.seek(offset))
+	{
+		return false;
+	}
+
+	//Locate the first frame, only zero padding is allowed before it
+	const QByteArray buffer = file.read(MAX_SCAN_SIZE);
+	int start = 0;
+	while((start < buffer.size()) && (buffer.at(start) == 0))
+	{
+		start++;
+	}
+	if(start + 4 > buffer.size())
+	{
+		return false;
+	}
+
+	mpeg_header_t info, next;
+	if(!parseMpegHeader(RD_BE32(buffer.constData() + start), info))
+	{
+		return false;
+	}
+
+	//Make sure the next frame header is consistent
+	const qint64 framePos = offset + start;
+	char header[4];
+	if((!file.seek(framePos + info.frameSize)) || (file.read(header, 4) != 4) || (!parseMpegHeader(RD_BE32(header), next)))
+	{
+		return false;
+	}
+	if((next.version != info.version) || (next.layer != info.layer) || (next.sampleRate != info.sampleRate))
+	{
+		return false;
+	}
+
+	//Check for an ID3v1 tag
+	qint64 audioBytes = fileSize - framePos;
+	if(fileSize >= 128)
+	{
+		file.seek(fileSize - 128);
+		if(file.read(3) == "TAG")
+		{
+			audioBytes -= 128;
+			parseID3v1(file, metaInfo);
+		}
+	}
+
+	//Look for a Xing/Info or VBRI header in the first frame
+	if(!file.seek(framePos))
+	{
+		return false;
+	}
+	const QByteArray frame = file.read(qMin(info.frameSize, 2048U));
+	quint32 frameCount = 0;
+	bool isVBR = false;
+	QString encodeLib;
+
+	if(info.layer == 3)
+	{
+		const int xingPos = 4 + ((info.version == 0) ? ((info.channels == 1) ? 17 : 32) : ((info.channels == 1) ? 9 : 17));
+		const QByteArray tag = frame.mid(xingPos, 4);
+		if(((tag == "Xing") || (tag == "Info")) && (frame.size() >= xingPos + 8))
+		{
+			const quint32 flags = RD_BE32(frame.constData() + xingPos + 4);
+			int lamePos = xingPos + 8;
+			if((flags & 0x1) && (frame.size() >= lamePos + 4))
+			{
+				frameCount = RD_BE32(frame.constData() + lamePos);
+			}
+			lamePos += ((flags & 0x1) ? 4 : 0) + ((flags & 0x2) ? 4 : 0) + ((flags & 0x4) ? 100 : 0) + ((flags & 0x8) ? 4 : 0);
+			if(frame.mid(lamePos, 4) == "LAME")
+			{
+				encodeLib = QString::fromLatin1(frame.mid(lamePos, 9).constData()).simplified();
+			}
+			isVBR = (tag == "Xing");
+			audioBytes -= info.frameSize;
+		}
+		else if((frame.mid(36, 4) == "VBRI") && (frame.size() >= 36 + 18))
+		{
+			frameCount = RD_BE32(frame.constData() + 36 + 14);
+			isVBR = true;
+			audioBytes -= info.frameSize;
+		}
+	}
+
+	if(isVBR && (frameCount == 0))
+	{
+		return false; /*can not determine duration without decoding the whole file*/
+	}
+
+	const double duration = (frameCount > 0) ? (double(frameCount) * double(info.samplesPerFrame) / double(info.sampleRate)) : (double(audioBytes) * 8.0 / (double(info.bitrate) * 1000.0));
+	if(duration <= 0.0)
+	{
+		return false;
+	}
+
+	techInfo.setContainerType(QLatin1String("MPEG Audio"));
+	techInfo.setAudioType(QLatin1String("MPEG Audio"));
+	techInfo.setAudioVersion(QLatin1String(MPEG_VERSIONS[info.version]));
+	techInfo.setAudioProfile(QLatin1String(MPEG_LAYERS[info.layer - 1]));
+	techInfo.setAudioChannels(info.channels);
+	techInfo.setAudioSamplerate(info.sampleRate);
+	techInfo.setAudioBitrate(isVBR ? qRound(double(audioBytes) * 8.0 / duration / 1000.0) : info.bitrate);
+	techInfo.setAudioBitrateMode(isVBR ? AudioFileModel::BitrateModeVariable : AudioFileModel::BitrateModeConstant);
+	techInfo.setAudioEncodeLib(encodeLib);
+	techInfo.setDuration(qRound(duration));
+
+	return true;
+}
+
+bool HeaderProbe::probeOgg(QFile &file, AudioFileModel_MetaInfo &metaInfo, AudioFileModel_TechInfo &techInfo)
+{
+	QList<QByteArray> packets;
+	quint32 serial = 0;
+	qint64 granule = 0;
+
+	if((!readOggPackets(file, packets, 2, serial)) || (!readOggGranule(file, serial, granule)))
+	{
+		return false;
+	}
+
+	const QByteArray &header = packets.at(0), &comment = packets.at(1);
+	quint32 channels = 0, sampleRate = 0;
+	QString vendor;
+
+	if(header.startsWith("\x01vorbis") && (header.size() >= 30))
+	{
+		channels = BYTE_AT(header.constData(), 11);
+		sampleRate = RD_LE32(header.constData() + 12);
+		if((!comment.startsWith("\x03vorbis")) || (!parseVorbisComment(comment.mid(7), metaInfo, vendor)))
+		{
+			return false;
+		}
+		techInfo.setAudioType(QLatin1String("Vorbis"));
+	}
+	else if(header.startsWith("OpusHead") && (header.size() >= 19))
+	{
+		channels = BYTE_AT(header.constData(), 9);
+		sampleRate = 48000; /*Opus always decodes at 48 kHz*/
+		granule -= RD_LE16(header.constData() + 10);
+		if((!comment.startsWith("OpusTags")) || (!parseVorbisComment(comment.mid(8), metaInfo, vendor)))
+		{
+			return false;
+		}
+		techInfo.setAudioType(QLatin1String("Opus"));
+	}
+	else
+	{
+		return false; /*FLAC in Ogg or some other codec*/
+	}
+
+	if((channels == 0) || (sampleRate == 0) || (granule <= 0))
+	{
+		return false;
+	}
+
+	const double duration = double(granule) / double(sampleRate);
+
+	techInfo.setContainerType(QLatin1String("Ogg"));
+	techInfo.setAudioChannels(channels);
+	techInfo.setAudioSamplerate(sampleRate);
+	techInfo.setAudioBitrate(qRound(double(file.size()) * 8.0 / duration / 1000.0));
+	techInfo.setAudioBitrateMode(AudioFileModel::BitrateModeVariable);
+	techInfo.setAudioEncodeLib(vendor.simplified());
+	techInfo.setDuration(qRound(duration));
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+// Tag Parsers
+////////////////////////////////////////////////////////////
+
+bool HeaderProbe::parseID3v2(const QByteArray &data, const quint8 version, AudioFileModel_MetaInfo &metaInfo)
+{
+	const int size = data.size();
+	int pos = 0;
+
+	while(pos + 10 <= size)
+	{
+		const char *const frame = data.constData() + pos;
+		if(frame[0] == 0)
+		{
+			break; /*padding*/
+		}
+
+		const QByteArray frameId(frame, 4);
+		const quint32 frameSize = (version >= 4) ? RD_SYNCSAFE32(frame + 4) : RD_BE32(frame + 4);
+		const quint32 frameFlags = RD_BE16(frame + 8);
+
+		pos += 10;
+		if(frameSize > quint32(size - pos))
+		{
+			return false;
+		}
+		if(frameId == "APIC")
+		{
+			metaInfo.setCoverEmbedded(true); /*will be extracted on demand*/
+		}
+
+		const bool unsupported = (((version >= 4) ? (frameFlags & 0x000F) : (frameFlags & 0x00C0)) != 0); /*compression, encryption etc.*/
+		if((!unsupported) && (frameSize > 1))
+		{
+			const quint32 encoding = BYTE_AT(frame, 10);
+			const char *const text = frame + 11;
+			const int textLen = frameSize - 1;
+
+			if     (frameId == "TIT2") setTag(metaInfo, QLatin1String("TITLE"),       decodeID3Text(text, textLen, encoding));
+			else if(frameId == "TPE1") setTag(metaInfo, QLatin1String("ARTIST"),      decodeID3Text(text, textLen, encoding));
+			else if(frameId == "TALB") setTag(metaInfo, QLatin1String("ALBUM"),       decodeID3Text(text, textLen, encoding));
+			else if(frameId == "TCON") setTag(metaInfo, QLatin1String("GENRE"),       decodeID3Text(text, textLen, encoding));
+			else if(frameId == "TYER") setTag(metaInfo, QLatin1String("DATE"),        decodeID3Text(text, textLen, encoding));
+			else if(frameId == "TDRC") setTag(metaInfo, QLatin1String("DATE"),        decodeID3Text(text, textLen, encoding));
+			else if(frameId == "TRCK") setTag(metaInfo, QLatin1String("TRACKNUMBER"), decodeID3Text(text, textLen, encoding));
+			else if((frameId == "COMM") && (textLen > 3))
+			{
+				const int descLen = findID3Terminator(text + 3, textLen - 3, encoding);
+				const int skip = 3 + descLen + (((encoding == 1) || (encoding == 2)) ? 2 : 1);
+				if(skip < textLen)
+				{
+					setTag(metaInfo, QLatin1String("COMMENT"), decodeID3Text(text + skip, textLen - skip, encoding));
+				}
+			}
+		}
+
+		pos += frameSize;
+	}
+
+	return true;
+}
+
+void HeaderProbe::parseID3v1(QFile &file, AudioFileModel_MetaInfo &metaInfo)
+{
+	if(!file.seek(file.size() - 128))
+	{
+		return;
+	}
+
+	const QByteArray tag = file.read(128);
+	if((tag.size() != 128) || (!tag.startsWith("TAG")))
+	{
+		return;
+	}
+
+	const char *const data = tag.constData();
+	setTag(metaInfo, QLatin1String("TITLE"),   decodeAnsi(data +  3, 30));
+	setTag(metaInfo, QLatin1String("ARTIST"),  decodeAnsi(data + 33, 30));
+	setTag(metaInfo, QLatin1String("ALBUM"),   decodeAnsi(data + 63, 30));
+	setTag(metaInfo, QLatin1String("DATE"),    decodeAnsi(data + 93,  4));
+	setTag(metaInfo, QLatin1String("COMMENT"), decodeAnsi(data + 97, 30));
+
+	if((data[125] == 0) && (data[126] != 0))
+	{
+		setTag(metaInfo, QLatin1String("TRACKNUMBER"), QString::number(BYTE_AT(data, 126)));
+	}
+	if(int(BYTE_AT(data, 127)) < genreCount())
+	{
+		setTag(metaInfo, QLatin1String("GENRE"), QString::fromLatin1(g_lamexp_generes[BYTE_AT(data, 127)]));
+	}
+}
+
+void HeaderProbe::parseRiffInfo(const QByteArray &data, AudioFileModel_MetaInfo &metaInfo)
+{
+	const int size = data.size();
+	int pos = 0;
+
+	while(pos + 8 <= size)
+	{
+		const char *const chunk = data.constData() + pos;
+		const quint32 chunkSize = RD_LE32(chunk + 4);
+		pos += 8;
+		if(chunkSize > quint32(size - pos))
+		{
+			break;
+		}
+
+		const QByteArray chunkId(chunk, 4);
+		const QString value = decodeAnsi(chunk + 8, chunkSize);
+
+		if     (chunkId == "INAM") setTag(metaInfo, QLatin1String("TITLE"),       value);
+		else if(chunkId == "IART") setTag(metaInfo, QLatin1String("ARTIST"),      value);
+		else if(chunkId == "IPRD") setTag(metaInfo, QLatin1String("ALBUM"),       value);
+		else if(chunkId == "IGNR") setTag(metaInfo, QLatin1String("GENRE"),       value);
+		else if(chunkId == "ICMT") setTag(metaInfo, QLatin1String("COMMENT"),     value);
+		else if(chunkId == "ICRD") setTag(metaInfo, QLatin1String("DATE"),        value);
+		else if(chunkId == "ITRK") setTag(metaInfo, QLatin1String("TRACKNUMBER"), value);
+
+		pos += chunkSize + (chunkSize & 1);
+	}
+}
+
+bool HeaderProbe::parseVorbisComment(const QByteArray &data, AudioFileModel_MetaInfo &metaInfo, QString &vendor)
+{
+	const char *const ptr = data.constData();
+	const quint32 size = data.size();
+
+	if(size < 8)
+	{
+		return false;
+	}
+
+	const quint32 vendorLen = RD_LE32(ptr);
+	if(vendorLen > size - 8)
+	{
+		return false;
+	}
+	vendor = QString::fromUtf8(ptr + 4, vendorLen);
+
+	const quint32 count = RD_LE32(ptr + 4 + vendorLen);
+	quint32 pos = 8 + vendorLen;
+
+	for(quint32 i = 0; i < count; i++)
+	{
+		if(pos + 4 > size)
+		{
+			return false;
+		}
+		const quint32 len = RD_LE32(ptr + pos);
+		pos += 4;
+		if(len > size - pos)
+		{
+			return false;
+		}
+
+		const QString entry = QString::fromUtf8(ptr + pos, len);
+		pos += len;
+
+		const int separator = entry.indexOf(QLatin1Char('='));
+		if(separator > 0)
+		{
+			const QString key = entry.left(separator).toUpper();
+			if((key == QLatin1String("METADATA_BLOCK_PICTURE")) || (key == QLatin1String("COVERART")))
+			{
+				metaInfo.setCoverEmbedded(true); /*will be extracted on demand*/
+				continue;
+			}
+			setTag(metaInfo, key, entry.mid(separator + 1));
+		}
+	}
+
+	return true;
+}
+
+void HeaderProbe::setTag(AudioFileModel_MetaInfo &metaInfo, const QString &key, const QString &value)
+{
+	const QString text = value.simplified();
+	if(text.isEmpty())
+	{
+		return;
+	}
+
+	if(key == QLatin1String("TITLE"))
+	{
+		if(metaInfo.title().isEmpty()) metaInfo.setTitle(text);
+	}
+	else if(key == QLatin1String("ARTIST"))
+	{
+		if(metaInfo.artist().isEmpty()) metaInfo.setArtist(text);
+	}
+	else if(key == QLatin1String("ALBUM"))
+	{
+		if(metaInfo.album().isEmpty()) metaInfo.setAlbum(text);
+	}
+	else if(key == QLatin1String("GENRE"))
+	{
+		if(metaInfo.genre().isEmpty())
+		{
+			QRegExp genreIdx("^\\(?(\\d+)\\)?$");
+			if(genreIdx.indexIn(text) >= 0)
+			{
+				const int idx = genreIdx.cap(1).toInt();
+				if((idx >= 0) && (idx < genreCount())) metaInfo.setGenre(QString::fromLatin1(g_lamexp_generes[idx]));
+			}
+			else
+			{
+				metaInfo.setGenre(text);
+			}
+		}
+	}
+	else if((key == QLatin1String("COMMENT")) || (key == QLatin1String("DESCRIPTION")))
+	{
+		if(metaInfo.comment().isEmpty()) metaInfo.setComment(text);
+	}
+	else if((key == QLatin1String("DATE")) || (key == QLatin1String("YEAR")))
+	{
+		QRegExp year("^(\\d{4})");
+		if((metaInfo.year() == 0) && (year.indexIn(text) >= 0)) metaInfo.setYear(year.cap(1).toUInt());
+	}
+	else if(key == QLatin1String("TRACKNUMBER"))
+	{
+		QRegExp position("^(\\d+)");
+		if((metaInfo.position() == 0) && (position.indexIn(text) >= 0)) metaInfo.setPosition(position.cap(1).toUInt());
+	}
+}
+
+////////////////////////////////////////////////////////////
+// Ogg Helpers
+////////////////////////////////////////////////////////////
+
+bool HeaderProbe::readOggPackets(QFile &file, QList<QByteArray> &packets, const int count, quint32 &serial)
+{
+	QByteArray current;
+	qint64 pos = 0;
+
+	while(packets.count() < count)
+	{
+		char header[27];
+		if((!file.seek(pos)) || (file.read(header, 27) != 27) || (memcmp(header, "OggS", 4) != 0) || (header[4] != 0))
+		{
+			return false;
+		}
+
+		const quint32 pageSerial = RD_LE32(header + 14);
+		if(pos == 0)
+		{
+			if(!(header[5] & 0x02)) return false; /*first page must be BOS*/
+			serial = pageSerial;
+		}
+		else if(pageSerial != serial)
+		{
+			return false; /*multiplexed streams*/
+		}
+
+		const int segments = BYTE_AT(header, 26);
+		const QByteArray lacing = file.read(segments);
+		if(lacing.size() != segments)
+		{
+			return false;
+		}
+
+		int pageSize = 0;
+		for(int i = 0; i < segments; i++)
+		{
+			pageSize += BYTE_AT(lacing.constData(), i);
+		}
+
+		const QByteArray page = file.read(pageSize);
+		if(page.size() != pageSize)
+		{
+			return false;
+		}
+
+		int offset = 0;
+		for(int i = 0; (i < segments) && (packets.count() < count); i++)
+		{
+			const int len = BYTE_AT(lacing.constData(), i);
+			current.append(page.constData() + offset, len);
+			offset += len;
+			if(current.size() > MAX_BLOCK_SIZE)
+			{
+				return false; /*oversized header packet*/
+			}
+			if(len < 255)
+			{
+				packets << current;
+				current.clear();
+			}
+		}
+
+		pos += 27 + segments + pageSize;
+	}
+
+	return true;
+}
+
+bool HeaderProbe::readOggGranule(QFile &file, const quint32 serial, qint64 &granule)
+{
+	const qint64 tailSize = qMin(file.size(), qint64(OGG_TAIL_SIZE));
+	if(!file.seek(file.size() - tailSize))
+	{
+		return false;
+	}
+
+	const QByteArray tail = file.read(tailSize);
+	int idx = tail.lastIndexOf("OggS");
+
+	while(idx >= 0)
+	{
+		if(idx + 27 <= tail.size())
+		{
+			const char *const page = tail.constData() + idx;
+			if((page[4] == 0) && (RD_LE32(page + 14) == serial))
+			{
+				const qint64 value = RD_LE64(page + 6);
+				if(value >= 0)
+				{
+					granule = value;
+					return true;
+				}
+			}
+		}
+		if(idx < 1)
+		{
+			break;
+		}
+		idx = tail.lastIndexOf("OggS", idx - 1);
+	}
+
+	return false; /*chained stream or truncated file*/
+}
@@ -0,0 +1,66 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <QList>
+#include <QByteArray>
+
+class AudioFileModel;
+class AudioFileModel_MetaInfo;
+class AudioFileModel_TechInfo;
+class QFile;
+class QString;
+
+////////////////////////////////////////////////////////////
+// Header Probe
+////////////////////////////////////////////////////////////
+
+/*
+ * Reads the format information and the basic tags of the most common file
+ * types (Wave, FLAC, MPEG Audio, Ogg Vorbis, Ogg Opus) directly from the file
+ * headers, so that MediaInfo only needs to be invoked for all other files.
+ * Embedded cover art is only flagged, it will be extracted on demand.
+ * If a file cannot be handled unambiguously, the probe fails and the given
+ * AudioFileModel is left unmodified.
+ */
+class HeaderProbe
+{
+public:
+	static bool probe(const QString &filePath, AudioFileModel &audioFile);
+
+private:
+	HeaderProbe(void) {}
+	~HeaderProbe(void) {}
+
+	static bool probeWave(QFile &file, AudioFileModel_MetaInfo &metaInfo, AudioFileModel_TechInfo &techInfo);
+	static bool probeFLAC(QFile &file, const qint64 offset, AudioFileModel_MetaInfo &metaInfo, AudioFileModel_TechInfo &techInfo);
+	static bool probeMPEG(QFile &file, const qint64 offset, AudioFileModel_MetaInfo &metaInfo, AudioFileModel_TechInfo &techInfo);
+	static bool probeOgg(QFile &file, AudioFileModel_MetaInfo &metaInfo, AudioFileModel_TechInfo &techInfo);
+
+	static bool parseID3v2(const QByteArray &data, const quint8 version, AudioFileModel_MetaInfo &metaInfo);
+	static void parseID3v1(QFile &file, AudioFileModel_MetaInfo &metaInfo);
+	static void parseRiffInfo(const QByteArray &data, AudioFileModel_MetaInfo &metaInfo);
+	static bool parseVorbisComment(const QByteArray &data, AudioFileModel_MetaInfo &metaInfo, QString &vendor);
+	static bool readOggPackets(QFile &file, QList<QByteArray> &packets, const int count, quint32 &serial);
+	static bool readOggGranule(QFile &file, const quint32 serial, qint64 &granule);
+	static void setTag(AudioFileModel_MetaInfo &metaInfo, const QString &key, const QString &value);
+};
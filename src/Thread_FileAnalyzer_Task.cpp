@@ -27,6 +27,8 @@
 #include "LockedFile.h"
 #include "Model_AudioFile.h"
 #include "MimeTypes.h"
+#include "Thread_FileAnalyzer_Cache.h"
+#include "Thread_FileAnalyzer_Probe.h"
 
 //MUtils
 #include <MUtils/Global.h>
@@ -41,7 +43,6 @@
 #include <QDate>
 #include <QTime>
 #include <QDebug>
-#include <QImage>
 #include <QReadLocker>
 #include <QWriteLocker>
 #include <QThread>
@@ -49,6 +50,8 @@
 #include <QXmlInputSource>
 #include <QXmlStreamReader>
 #include <QStack>
+#include <QHash>
+#include <QTemporaryFile>
 
 //CRT
 #include <math.h>
@@ -112,11 +115,46 @@ static MUtils::Lazy<const QMap<QPair<AnalyzeTask::MI_trackType_t, QString>, Anal
 	ADD_PROPTERY_MAPPING_1(aud, bitrate);
 	ADD_PROPTERY_MAPPING_1(aud, bitrate_mode);
 	ADD_PROPTERY_MAPPING_1(aud, encoded_library);
-	ADD_PROPTERY_MAPPING_2(gen, cover_mime, cover_mime);
-	ADD_PROPTERY_MAPPING_2(gen, cover_data, cover_data);
+	ADD_PROPTERY_MAPPING_1(gen, cover);
 	return builder;
 });
 
+static MUtils::Lazy<const QMap<QString, QString>> s_informNames([]
+{
+	QMap<QString, QString> *const builder = new QMap<QString, QString>();
+	static const char *const INFORM_NAMES[] =
+	{
+		"Format", "Format_Profile", "Format_Version", "Format_AdditionalFeatures", "Duration", "Title", "Track", "Artist", "Performer", "Album", "Genre",
+		"Released_Date", "Recorded_Date", "Track/Position", "Comment", "Channel(s)", "SamplingRate", "BitDepth", "BitRate", "BitRate_Mode", "Encoded_Library", "Cover", NULL
+	};
+	for (size_t i = 0U; INFORM_NAMES[i]; ++i)
+	{
+		QString key = QString::fromLatin1(INFORM_NAMES[i]).toLower();
+		builder->insert(key.replace(QRegExp("[^a-z0-9_]"), QLatin1String("_")), QString::fromLatin1(INFORM_NAMES[i]));
+	}
+	return builder;
+});
+
+static MUtils::Lazy<const QByteArray> s_informTemplate([]
+{
+	//Build a MediaInfo "Inform" template that contains exactly the properties from the index
+	QString general(QLatin1String("General;#FILE#%CompleteName%\\r\\n")), audio(QLatin1String("Audio;#AUDIO#\\r\\n"));
+	const QList<QPair<AnalyzeTask::MI_trackType_t, QString>> keys = s_mediaInfoIdx->keys();
+	for (QList<QPair<AnalyzeTask::MI_trackType_t, QString>>::ConstIterator iter = keys.constBegin(); iter != keys.constEnd(); ++iter)
+	{
+		const QString name = s_informNames->value(iter->second);
+		if (name.isEmpty())
+		{
+			qWarning("No template name for property \"%s\"!", MUTILS_UTF8(iter->second));
+			continue;
+		}
+		QString &section = (iter->first == AnalyzeTask::trackType_gen) ? general : audio;
+		section += QString("#%1#%2=%%3%\\r\\n").arg((iter->first == AnalyzeTask::trackType_gen) ? QLatin1String("G") : QLatin1String("A"), iter->second, name);
+	}
+
+	return new QByteArray(QString("%1\r\n%2\r\n").arg(general, audio).toUtf8());
+});
+
 static MUtils::Lazy<const QMap<QString, AnalyzeTask::MI_propertyId_t>> s_avisynthIdx([]
 {
 	QMap<QString, AnalyzeTask::MI_propertyId_t> *const builder = new QMap<QString, AnalyzeTask::MI_propertyId_t>();
@@ -149,17 +187,18 @@ static MUtils::Lazy<const QMap<QString, AnalyzeTask::MI_trackType_t>> s_trackTyp
 // Constructor
 ////////////////////////////////////////////////////////////
 
-AnalyzeTask::AnalyzeTask(const int taskId, const QString &inputFile, QAtomicInt &abortFlag)
+AnalyzeTask::AnalyzeTask(const int taskId, const QStringList &inputFiles, QAtomicInt &abortFlag, AnalysisCache *const cache, const bool useProbe)
 :
 	m_taskId(taskId),
-	m_inputFile(inputFile),
+	m_inputFiles(inputFiles),
+	m_cache(cache),
+	m_useProbe(useProbe),
 	m_mediaInfoBin(lamexp_tools_lookup("mediainfo.exe")),
 	m_mediaInfoVer(lamexp_tools_version("mediainfo.exe")),
 	m_avs2wavBin(lamexp_tools_lookup("avs2wav.exe")),
 	m_abortFlag(abortFlag),
 	m_mediaInfoIdx(*s_mediaInfoIdx),
 	m_avisynthIdx(*s_avisynthIdx),
-	m_mimeTypes(*s_mimeTypes),
 	m_trackTypes(*s_trackTypes)
 {
 	if(m_mediaInfoBin.isEmpty() || m_avs2wavBin.isEmpty())
@@ -197,12 +236,16 @@ void AnalyzeTask::run()
 
 void AnalyzeTask::run_ex(void)
 {
-	int fileType = fileTypeNormal;
-	QString currentFile = QDir::fromNativeSeparators(m_inputFile);
-	qDebug("Analyzing: %s", MUTILS_UTF8(currentFile));
-	
-	AudioFileModel fileInfo(currentFile);
-	analyzeFile(currentFile, fileInfo, &fileType);
+	QList<AudioFileModel> fileInfos;
+	for(QStringList::ConstIterator iter = m_inputFiles.constBegin(); iter != m_inputFiles.constEnd(); iter++)
+	{
+		const QString currentFile = QDir::fromNativeSeparators(*iter);
+		qDebug("Analyzing: %s", MUTILS_UTF8(currentFile));
+		fileInfos << AudioFileModel(currentFile);
+	}
+
+	QVector<int> fileTypes(fileInfos.count(), fileTypeNormal);
+	analyzeFiles(fileInfos, fileTypes);
 
 	if(MUTILS_BOOLIFY(m_abortFlag))
 	{
@@ -210,88 +253,170 @@ void AnalyzeTask::run_ex(void)
 		return;
 	}
 
-	switch(fileType)
+	//Each file of the batch has its own task id, starting at m_taskId
+	for(int i = 0; i < fileInfos.count(); i++)
 	{
-	case fileTypeDenied:
-		qWarning("Cannot access file for reading, skipping!");
-		break;
-	case fileTypeCDDA:
-		qWarning("Dummy CDDA file detected, skipping!");
-		break;
-	default:
-		if(fileInfo.metaInfo().title().isEmpty() || fileInfo.techInfo().containerType().isEmpty() || fileInfo.techInfo().audioType().isEmpty())
+		AudioFileModel &fileInfo = fileInfos[i];
+		const QString &currentFile = fileInfo.filePath();
+		int fileType = fileTypes[i];
+
+		switch(fileType)
 		{
-			fileType = fileTypeUnknown;
-			if(!QFileInfo(currentFile).suffix().compare("cue", Qt::CaseInsensitive))
-			{
-				qWarning("Cue Sheet file detected, skipping!");
-				fileType = fileTypeCueSheet;
-			}
-			else if(!QFileInfo(currentFile).suffix().compare("avs", Qt::CaseInsensitive))
+		case fileTypeDenied:
+			qWarning("Cannot access file for reading, skipping!");
+			break;
+		case fileTypeCDDA:
+			qWarning("Dummy CDDA file detected, skipping!");
+			break;
+		default:
+			if(fileInfo.metaInfo().title().isEmpty() || fileInfo.techInfo().containerType().isEmpty() || fileInfo.techInfo().audioType().isEmpty())
 			{
-				qDebug("Found a potential Avisynth script, investigating...");
-				if(analyzeAvisynthFile(currentFile, fileInfo))
+				fileType = fileTypeUnknown;
+				if(!QFileInfo(currentFile).suffix().compare("cue", Qt::CaseInsensitive))
+				{
+					qWarning("Cue Sheet file detected, skipping!");
+					fileType = fileTypeCueSheet;
+				}
+				else if(!QFileInfo(currentFile).suffix().compare("avs", Qt::CaseInsensitive))
 				{
-					fileType = fileTypeNormal;
+					qDebug("Found a potential Avisynth script, investigating...");
+					if(analyzeAvisynthFile(currentFile, fileInfo))
+					{
+						fileType = fileTypeNormal;
+					}
+					else
+					{
+						qDebug("Rejected Avisynth file: %s", MUTILS_UTF8(fileInfo.filePath()));
+					}
 				}
 				else
 				{
-					qDebug("Rejected Avisynth file: %s", MUTILS_UTF8(fileInfo.filePath()));
+					qDebug("Rejected file of unknown type: %s", MUTILS_UTF8(fileInfo.filePath()));
 				}
 			}
-			else
-			{
-				qDebug("Rejected file of unknown type: %s", MUTILS_UTF8(fileInfo.filePath()));
-			}
+			break;
 		}
-		break;
-	}
 
-	//Emit the file now!
-	emit fileAnalyzed(m_taskId, fileType, fileInfo);
+		//Emit the file now!
+		emit fileAnalyzed(m_taskId + i, fileType, fileInfo);
+	}
 }
 
 ////////////////////////////////////////////////////////////
 // Privtae Functions
 ////////////////////////////////////////////////////////////
 
-const AudioFileModel& AnalyzeTask::analyzeFile(const QString &filePath, AudioFileModel &audioFile, int *const type)
+void AnalyzeTask::analyzeFiles(QList<AudioFileModel> &audioFiles, QVector<int> &fileTypes)
 {
-	*type = fileTypeNormal;
-	QFile readTest(filePath);
+	QList<AudioFileModel*> pendingFiles;
 
-	if (!readTest.open(QIODevice::ReadOnly))
+	for(int i = 0; i < audioFiles.count(); i++)
 	{
-		*type = fileTypeDenied;
-		return audioFile;
+		const QString &filePath = audioFiles[i].filePath();
+		QFile readTest(filePath);
+
+		if (!readTest.open(QIODevice::ReadOnly))
+		{
+			fileTypes[i] = fileTypeDenied;
+			continue;
+		}
+
+		if (checkFile_CDDA(readTest))
+		{
+			fileTypes[i] = fileTypeCDDA;
+			continue;
+		}
+
+		readTest.close();
+
+		//Try to retrieve the result from the cache first
+		if(m_cache && m_cache->lookup(filePath, audioFiles[i]))
+		{
+			qDebug("Analysis result retrieved from cache: %s", MUTILS_UTF8(filePath));
+			continue;
+		}
+
+		//Try to read the file headers directly, this handles the most common file types
+		if(m_useProbe && HeaderProbe::probe(filePath, audioFiles[i]))
+		{
+			qDebug("Analysis result retrieved from file header: %s", MUTILS_UTF8(filePath));
+			finalizeMediaInfo(audioFiles[i]);
+			continue;
+		}
+
+		pendingFiles << &audioFiles[i];
 	}
 
-	if (checkFile_CDDA(readTest))
+	if(pendingFiles.isEmpty() || MUTILS_BOOLIFY(m_abortFlag))
 	{
-		*type = fileTypeCDDA;
-		return audioFile;
+		return;
 	}
 
-	readTest.close();
-	return analyzeMediaFile(filePath, audioFile);
+	//Analyze all remaining files with a single MediaInfo invocation
+	analyzeMediaFiles(pendingFiles);
+
+	//Store result in the cache (cover art is not extracted during the analysis, so it can be cached as well)
+	if(m_cache && (!MUTILS_BOOLIFY(m_abortFlag)))
+	{
+		for(QList<AudioFileModel*>::ConstIterator iter = pendingFiles.constBegin(); iter != pendingFiles.constEnd(); iter++)
+		{
+			const AudioFileModel_TechInfo &techInfo = (*iter)->techInfo();
+			if((!techInfo.containerType().isEmpty()) && (!techInfo.audioType().isEmpty()) && (!(*iter)->metaInfo().title().isEmpty()))
+			{
+				m_cache->insert((*iter)->filePath(), *(*iter));
+			}
+		}
+	}
 }
 
-const AudioFileModel& AnalyzeTask::analyzeMediaFile(const QString &filePath, AudioFileModel &audioFile)
+void AnalyzeTask::analyzeMediaFiles(const QList<AudioFileModel*> &audioFiles)
 {
-	//bool skipNext = false;
-	QPair<quint32, quint32> id_val(UINT_MAX, UINT_MAX);
-	QByteArray coverData;
+	QStringList files;
+	for(QList<AudioFileModel*>::ConstIterator iter = audioFiles.constBegin(); iter != audioFiles.constEnd(); iter++)
+	{
+		files << QDir::toNativeSeparators((*iter)->filePath());
+	}
 
-	QStringList params;
-	params << L1S("--Language=raw") << L1S("--Output=XML") << L1S("--Full") << L1S("--Cover_Data=base64");
-	params << QDir::toNativeSeparators(filePath);
+	QByteArray data;
 
+	//Request only the required properties, using our custom template (the file is removed when the batch is done)
+	QTemporaryFile informTemplate(QString("%1/XXXXXX.txt").arg(MUtils::temp_folder()));
+	if(informTemplate.open() && (informTemplate.write(*s_informTemplate) == s_informTemplate->size()))
+	{
+		informTemplate.close();
+		if(!runMediaInfo(QStringList() << L1S("--Language=raw") << QString("--Inform=file://%1").arg(QDir::toNativeSeparators(informTemplate.fileName())) << files, audioFiles.count(), data))
+		{
+			return;
+		}
+		if(parseInform(data, audioFiles) || MUTILS_BOOLIFY(m_abortFlag))
+		{
+			return;
+		}
+		qWarning("MediaInfo template output not recognized, falling back to XML output!");
+	}
+	else
+	{
+		qWarning("Failed to create MediaInfo template file, falling back to XML output!");
+	}
+
+	//Retrieve the full XML output
+	if(runMediaInfo(QStringList() << L1S("--Language=raw") << L1S("--Output=XML") << L1S("--Full") << files, audioFiles.count(), data))
+	{
+		parseMediaInfo(data, audioFiles);
+	}
+}
+
+bool AnalyzeTask::runMediaInfo(const QStringList &params, const int fileCount, QByteArray &data)
+{
 	QProcess process;
 	MUtils::init_process(process, QFileInfo(m_mediaInfoBin).absolutePath());
 	process.start(m_mediaInfoBin, params);
 
-	QByteArray data;
-	data.reserve(16384);
+	data.clear();
+	data.reserve(16384 * fileCount);
+
+	//Larger batches may take longer until MediaInfo generates any output
+	const int timeout = 30000 + (5000 * (fileCount - 1));
 
 	if(!process.waitForStarted())
 	{
@@ -299,7 +424,7 @@ const AudioFileModel& AnalyzeTask::analyzeMediaFile(const QString &filePath, Aud
 		qWarning("Error message: \"%s\"\n", process.errorString().toLatin1().constData());
 		process.kill();
 		process.waitForFinished(-1);
-		return audioFile;
+		return false;
 	}
 
 	while(process.state() != QProcess::NotRunning)
@@ -311,7 +436,7 @@ const AudioFileModel& AnalyzeTask::analyzeMediaFile(const QString &filePath, Aud
 			break;
 		}
 		
-		if(!process.waitForReadyRead())
+		if(!process.waitForReadyRead(timeout))
 		{
 			if(process.state() == QProcess::Running)
 			{
@@ -328,7 +453,7 @@ const AudioFileModel& AnalyzeTask::analyzeMediaFile(const QString &filePath, Aud
 			if (dataNext.isEmpty()) {
 				break; /*no more input data*/
 			}
-			data += dataNext.trimmed();
+			data += dataNext;
 		}
 	}
 
@@ -345,20 +470,124 @@ const AudioFileModel& AnalyzeTask::analyzeMediaFile(const QString &filePath, Aud
 		if (dataNext.isEmpty()) {
 			break; /*no more input data*/
 		}
-		data += dataNext.trimmed();
+		data += dataNext;
 	}
 
+	data = data.trimmed();
+
 #if MUTILS_DEBUG
 	qDebug("-----BEGIN MEDIAINFO-----\n%s\n-----END MEDIAINFO-----", data.constData());
 #endif //MUTILS_DEBUG
 
-	return parseMediaInfo(data, audioFile);
+	return (!data.isEmpty()) && (!MUTILS_BOOLIFY(m_abortFlag));
 }
 
-const AudioFileModel& AnalyzeTask::parseMediaInfo(const QByteArray &data, AudioFileModel &audioFile)
+bool AnalyzeTask::parseInform(const QByteArray &data, const QList<AudioFileModel*> &audioFiles)
+{
+	const QList<QByteArray> lines = data.split('\n');
+	int currentIndex = -1, audioTracks = 0;
+	bool recognized = false;
+
+	for(QList<QByteArray>::ConstIterator iter = lines.constBegin(); iter != lines.constEnd(); iter++)
+	{
+		const QString line = QString::fromUtf8(iter->constData(), iter->size()).trimmed();
+		if(line.startsWith(QLatin1String("#FILE#")))
+		{
+			currentIndex = mapFileRef(line.mid(6), audioFiles, currentIndex);
+			audioTracks = 0;
+			recognized = true;
+			continue;
+		}
+		if((currentIndex < 0) || (currentIndex >= audioFiles.count()))
+		{
+			continue;
+		}
+		if(line == QLatin1String("#AUDIO#"))
+		{
+			if(audioTracks++ > 0) qWarning("Skipping non-primary 'Audio' track!");
+			continue;
+		}
+
+		MI_trackType_t trackType = trackType_non;
+		if(line.startsWith(QLatin1String("#G#")))
+		{
+			trackType = trackType_gen;
+		}
+		else if(line.startsWith(QLatin1String("#A#")) && (audioTracks == 1))
+		{
+			trackType = trackType_aud;
+		}
+
+		const int separator = line.indexOf(QLatin1Char('='));
+		if((trackType == trackType_non) || (separator < 3))
+		{
+			continue;
+		}
+
+		const QString value = line.mid(separator + 1).simplified();
+		const MI_propertyId_t idx = m_mediaInfoIdx.value(qMakePair(trackType, line.mid(3, separator - 3)), MI_propertyId_t(-1));
+		if((idx != MI_propertyId_t(-1)) && (!value.isEmpty()))
+		{
+			if(idx == propertyId_duration)
+			{
+				SET_OPTIONAL(double, parseFloat(value, _tmp), audioFiles[currentIndex]->techInfo().setDuration(qRound(_tmp / 1000.0))); /*milliseconds*/
+				continue;
+			}
+			parseProperty(value, idx, *audioFiles[currentIndex]);
+		}
+	}
+
+	if(recognized)
+	{
+		for (QList<AudioFileModel*>::ConstIterator iter = audioFiles.constBegin(); iter != audioFiles.constEnd(); iter++)
+		{
+			finalizeMediaInfo(*(*iter));
+		}
+	}
+
+	return recognized;
+}
+
+int AnalyzeTask::mapFileRef(const QString &ref, const QList<AudioFileModel*> &audioFiles, const int currentIndex)
+{
+	const QString key = makeFileKey(ref);
+	for(int i = 0; i < audioFiles.count(); i++)
+	{
+		if(makeFileKey(audioFiles[i]->filePath()) == key)
+		{
+			return i;
+		}
+	}
+
+	//Unknown reference, this is a secondary file (e.g. a reference file) of the current file, if that is still incomplete
+	if(currentIndex < 0)
+	{
+		return (audioFiles.count() == 1) ? 0 : -1;
+	}
+	const bool currentIncomplete = audioFiles[currentIndex]->techInfo().containerType().isEmpty() || audioFiles[currentIndex]->techInfo().audioType().isEmpty();
+	return currentIncomplete ? currentIndex : -1;
+}
+
+/*
+ * Paths are compared case-insensitive and with uniform separators, but otherwise exactly as they were passed
+ */
+QString AnalyzeTask::makeFileKey(const QString &filePath)
+{
+	return QDir::fromNativeSeparators(filePath.trimmed()).toLower();
+}
+
+void AnalyzeTask::parseMediaInfo(const QByteArray &data, const QList<AudioFileModel*> &audioFiles)
 {
 	QXmlStreamReader xmlStream(data);
-	bool firstMediaFile = true;
+
+	//Map the "ref" attribute of each <Media> element back to the corresponding file
+	QHash<QString, int> fileIndex;
+	for(int i = 0; i < audioFiles.count(); i++)
+	{
+		fileIndex.insert(makeFileKey(audioFiles[i]->filePath()), i);
+	}
+	QVector<bool> fileParsed(audioFiles.count(), false);
+	int currentIndex = -1;
 
 	if (findNextElement(QLatin1String("MediaInfo"), xmlStream))
 	{
@@ -366,7 +595,7 @@ const AudioFileModel& AnalyzeTask::parseMediaInfo(const QByteArray &data, AudioF
 		if (versionXml.isEmpty() || (!checkVersionStr(versionXml, 2U, 0U)))
 		{
 			qWarning("Invalid file format version property: \"%s\"", MUTILS_UTF8(versionXml));
-			return audioFile;
+			return;
 		}
 		if (findNextElement(QLatin1String("CreatingLibrary"), xmlStream))
 		{
@@ -375,7 +604,7 @@ const AudioFileModel& AnalyzeTask::parseMediaInfo(const QByteArray &data, AudioF
 			if (!STRICMP(identifier, QLatin1String("MediaInfoLib")))
 			{
 				qWarning("Invalid library identiofier property: \"%s\"", MUTILS_UTF8(identifier));
-				return audioFile;
+				return;
 			}
 			if (!versionLib.isEmpty())
 			{
@@ -385,21 +614,29 @@ const AudioFileModel& AnalyzeTask::parseMediaInfo(const QByteArray &data, AudioF
 					if (!checkVersionStr(versionLib, mediaInfoVer / 100U, mediaInfoVer % 100U))
 					{
 						qWarning("Invalid library version property: \"%s\"", MUTILS_UTF8(versionLib));
-						return audioFile;
+						return;
 					}
 				}
 			}
 			else
 			{
 				qWarning("Library version property not found!");
-				return audioFile;
+				return;
 			}
 			while (findNextElement(QLatin1String("Media"), xmlStream))
 			{
-				if (firstMediaFile || audioFile.techInfo().containerType().isEmpty() || audioFile.techInfo().audioType().isEmpty())
+				const QString ref = findAttribute(QLatin1String("ref"), xmlStream.attributes());
+				int index = ref.isEmpty() ? -1 : fileIndex.value(makeFileKey(ref), -1);
+				if (index < 0)
 				{
-					firstMediaFile = false;
-					parseFileInfo(xmlStream, audioFile);
+					//Unknown reference, this can only be a secondary file of the current file (never the next one)
+					index = (audioFiles.count() == 1) ? 0 : currentIndex;
+				}
+				if ((index >= 0) && (index < audioFiles.count()) && ((!fileParsed[index]) || audioFiles[index]->techInfo().containerType().isEmpty() || audioFiles[index]->techInfo().audioType().isEmpty()))
+				{
+					fileParsed[index] = true;
+					currentIndex = index;
+					parseFileInfo(xmlStream, *audioFiles[index]);
 				}
 				else
 				{
@@ -410,6 +647,14 @@ const AudioFileModel& AnalyzeTask::parseMediaInfo(const QByteArray &data, AudioF
 		}
 	}
 
+	for (QList<AudioFileModel*>::ConstIterator iter = audioFiles.constBegin(); iter != audioFiles.constEnd(); iter++)
+	{
+		finalizeMediaInfo(*(*iter));
+	}
+}
+
+void AnalyzeTask::finalizeMediaInfo(AudioFileModel &audioFile)
+{
 	if (!(audioFile.techInfo().containerType().isEmpty() || audioFile.techInfo().audioType().isEmpty()))
 	{
 		if (audioFile.metaInfo().title().isEmpty())
@@ -434,10 +679,8 @@ const AudioFileModel& AnalyzeTask::parseMediaInfo(const QByteArray &data, AudioF
 	}
 	else
 	{
-		qWarning("Audio file format could *not* be recognized!");
+		qWarning("Audio file format could *not* be recognized: %s", MUTILS_UTF8(audioFile.filePath()));
 	}
-
-	return audioFile;
 }
 
 void AnalyzeTask::parseFileInfo(QXmlStreamReader &xmlStream, AudioFileModel &audioFile)
@@ -470,7 +713,6 @@ void AnalyzeTask::parseFileInfo(QXmlStreamReader &xmlStream, AudioFileModel &aud
 
 void AnalyzeTask::parseTrackInfo(QXmlStreamReader &xmlStream, const MI_trackType_t trackType, AudioFileModel &audioFile)
 {
-	QString coverMimeType;
 	while (xmlStream.readNextStartElement())
 	{
 		const MI_propertyId_t idx = m_mediaInfoIdx.value(qMakePair(trackType, xmlStream.name().toString().simplified().toLower()), MI_propertyId_t(-1));
@@ -480,7 +722,7 @@ void AnalyzeTask::parseTrackInfo(QXmlStreamReader &xmlStream, const MI_trackType
 			const QString value = xmlStream.readElementText(QXmlStreamReader::SkipChildElements).simplified();
 			if (!value.isEmpty())
 			{
-				parseProperty(encoding.isEmpty() ? value : decodeStr(value, encoding), idx, audioFile, coverMimeType);
+				parseProperty(encoding.isEmpty() ? value : decodeStr(value, encoding), idx, audioFile);
 			}
 		}
 		else
@@ -490,7 +732,7 @@ void AnalyzeTask::parseTrackInfo(QXmlStreamReader &xmlStream, const MI_trackType
 	}
 }
 
-void AnalyzeTask::parseProperty(const QString &value, const MI_propertyId_t propertyIdx, AudioFileModel &audioFile, QString &coverMimeType)
+void AnalyzeTask::parseProperty(const QString &value, const MI_propertyId_t propertyIdx, AudioFileModel &audioFile)
 {
 #if MUTILS_DEBUG
 	qDebug("Property #%d = \"%s\"", propertyIdx, MUTILS_UTF8(value.left(24)));
@@ -516,8 +758,7 @@ void AnalyzeTask::parseProperty(const QString &value, const MI_propertyId_t prop
 		case propertyId_bitrate:           SET_OPTIONAL(quint32, parseUnsigned(value, _tmp), audioFile.techInfo().setAudioBitrate(DIV_RND(_tmp, 1000U))); return;
 		case propertyId_bitrate_mode:      SET_OPTIONAL(quint32, parseRCMode(value, _tmp), audioFile.techInfo().setAudioBitrateMode(_tmp));               return;
 		case propertyId_encoded_library:   audioFile.techInfo().setAudioEncodeLib(cleanAsciiStr(value));                                                  return;
-		case propertyId_cover_mime:        coverMimeType = value;                                                                                         return;
-		case propertyId_cover_data:        retrieveCover(audioFile, coverMimeType, value);                                                                return;
+		case propertyId_cover:             if (STRICMP(value, QLatin1String("Yes"))) audioFile.metaInfo().setCoverEmbedded(true);                         return;
 		default: MUTILS_THROW_FMT("Invalid property ID: %d", propertyIdx);
 	}
 }
@@ -534,27 +775,82 @@ bool AnalyzeTask::checkFile_CDDA(QFile &file)
 	return ((i >= 0) && (j >= 0) && (k >= 0) && (k > j) && (j > i));
 }
 
-void AnalyzeTask::retrieveCover(AudioFileModel &audioFile, const QString &coverType, const QString &coverData)
+bool AnalyzeTask::storeCover(AudioFileModel_MetaInfo &metaInfo, const QString &coverType, const QString &coverData)
 {
 	const QByteArray content = QByteArray::fromBase64(coverData.toLatin1());
-	const QString type = m_mimeTypes.value(coverType.toLower());
+	QString type = s_mimeTypes->value(coverType.toLower());
 	qDebug("Retrieving cover! (mime=\"%s\", type=\"%s\", len=%d)", MUTILS_L1STR(coverType), MUTILS_L1STR(type), content.size());
-	if(!QImage::fromData(content, type.isEmpty() ? NULL : MUTILS_L1STR(type.toUpper())).isNull())
+
+	//Check the file signature only, decoding the whole image is not required here
+	if(content.startsWith("\xFF\xD8\xFF"))
 	{
-		QFile coverFile(QString("%1/%2.%3").arg(MUtils::temp_folder(), MUtils::next_rand_str(), type.isEmpty() ? QLatin1String("jpg") : type));
-		if(coverFile.open(QIODevice::WriteOnly))
-		{
-			coverFile.write(content);
-			coverFile.close();
-			audioFile.metaInfo().setCover(coverFile.fileName(), true);
-		}
+		if(type.isEmpty()) type = QLatin1String("jpg");
+	}
+	else if(content.startsWith("\x89PNG"))
+	{
+		if(type.isEmpty()) type = QLatin1String("png");
+	}
+	else if(content.startsWith("GIF8"))
+	{
+		if(type.isEmpty()) type = QLatin1String("gif");
 	}
 	else
 	{
 		qWarning("Image data seems to be invalid! [Header:%s]", content.left(32).toHex().constData());
+		return false;
 	}
+
+	//Identical images (e.g. all tracks of an album) will share the same artwork file
+	return metaInfo.setCoverData(content, type);
 }
 
+bool AnalyzeTask::retrieveEmbeddedCover(const QString &filePath, AudioFileModel_MetaInfo &metaInfo)
+{
+	if((!metaInfo.coverEmbedded()) || (!metaInfo.cover().isEmpty()))
+	{
+		return (!metaInfo.cover().isEmpty());
+	}
+
+	metaInfo.setCoverEmbedded(false); /*try only once*/
+
+	const QString mediaInfoBin = lamexp_tools_lookup("mediainfo.exe");
+	if(mediaInfoBin.isEmpty())
+	{
+		return false;
+	}
+
+	QProcess process;
+	MUtils::init_process(process, QFileInfo(mediaInfoBin).absolutePath());
+	process.start(mediaInfoBin, QStringList() << L1S("--Language=raw") << L1S("--Cover_Data=base64") << L1S("--Inform=General;%Cover_Mime%|%Cover_Data%") << QDir::toNativeSeparators(filePath));
+
+	if(!process.waitForStarted())
+	{
+		qWarning("MediaInfo process failed to create!");
+		qWarning("Error message: \"%s\"\n", process.errorString().toLatin1().constData());
+		process.kill();
+		process.waitForFinished(-1);
+		return false;
+	}
+
+	if(!process.waitForFinished(30000))
+	{
+		qWarning("MediaInfo time out. Killing the process now!");
+		process.kill();
+		process.waitForFinished(-1);
+		return false;
+	}
+
+	//Multiple images are separated by " / ", use the first one
+	const QString output = QString::fromUtf8(process.readAll().constData()).trimmed();
+	const int separator = output.indexOf(QLatin1Char('|'));
+	if(separator < 0)
+	{
+		qWarning("Failed to retrieve embedded cover art: %s", MUTILS_UTF8(filePath));
+		return false;
+	}
+
+	return storeCover(metaInfo, output.left(separator).section(QLatin1String(" / "), 0, 0).trimmed(), output.mid(separator + 1).section(QLatin1String(" / "), 0, 0).trimmed());
+}
 
 bool AnalyzeTask::analyzeAvisynthFile(const QString &filePath, AudioFileModel &info)
 {
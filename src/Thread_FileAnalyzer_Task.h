@@ -29,8 +29,11 @@
 #include <QMutex>
 #include <QSemaphore>
 #include <QPair>
+#include <QVector>
 
 class AudioFileModel;
+class AudioFileModel_MetaInfo;
+class AnalysisCache;
 class QFile;
 class QXmlStreamReader;
 class QXmlStreamAttributes;
@@ -44,7 +47,7 @@ class AnalyzeTask: public QObject, public QRunnable
 	Q_OBJECT
 
 public:
-	AnalyzeTask(const int taskId, const QString &inputFile, QAtomicInt &abortFlag);
+	AnalyzeTask(const int taskId, const QStringList &inputFiles, QAtomicInt &abortFlag, AnalysisCache *const cache = NULL, const bool useProbe = true);
 	~AnalyzeTask(void);
 	
 	typedef enum
@@ -86,11 +89,13 @@ public:
 		propertyId_bitrate,
 		propertyId_bitrate_mode,
 		propertyId_encoded_library,
-		propertyId_cover_mime,
-		propertyId_cover_data
+		propertyId_cover
 	}
 	MI_propertyId_t;
 
+	//Extract embedded cover art on demand (not done during the analysis)
+	static bool retrieveEmbeddedCover(const QString &filePath, AudioFileModel_MetaInfo &metaInfo);
+
 signals:
 	void fileAnalyzed(const unsigned int taskId, const int fileType, const AudioFileModel &file);
 	void taskCompleted(const unsigned int taskId);
@@ -100,16 +105,21 @@ protected:
 	void run_ex(void);
 
 private:
-	const AudioFileModel& analyzeFile(const QString &filePath, AudioFileModel &audioFile, int *const type);
-	const AudioFileModel& analyzeMediaFile(const QString &filePath, AudioFileModel &audioFile);
-	const AudioFileModel& parseMediaInfo(const QByteArray &data, AudioFileModel &audioFile);
+	void analyzeFiles(QList<AudioFileModel> &audioFiles, QVector<int> &fileTypes);
+	void analyzeMediaFiles(const QList<AudioFileModel*> &audioFiles);
+	bool runMediaInfo(const QStringList &params, const int fileCount, QByteArray &data);
+	bool parseInform(const QByteArray &data, const QList<AudioFileModel*> &audioFiles);
+	void parseMediaInfo(const QByteArray &data, const QList<AudioFileModel*> &audioFiles);
+	void finalizeMediaInfo(AudioFileModel &audioFile);
 	void parseFileInfo(QXmlStreamReader &xmlStream, AudioFileModel &audioFile);
 	void parseTrackInfo(QXmlStreamReader &xmlStream, const MI_trackType_t trackType, AudioFileModel &audioFile);
-	void parseProperty(const QString &value, const MI_propertyId_t propertyIdx, AudioFileModel &audioFile, QString &coverMimeType);
-	void retrieveCover(AudioFileModel &audioFile, const QString &coverType, const QString &coverData);
+	void parseProperty(const QString &value, const MI_propertyId_t propertyIdx, AudioFileModel &audioFile);
 	bool checkFile_CDDA(QFile &file);
 	bool analyzeAvisynthFile(const QString &filePath, AudioFileModel &info);
 
+	static int mapFileRef(const QString &ref, const QList<AudioFileModel*> &audioFiles, const int currentIndex);
+	static QString makeFileKey(const QString &filePath);
+	static bool storeCover(AudioFileModel_MetaInfo &metaInfo, const QString &coverType, const QString &coverData);
 	static QString decodeStr(const QString &str, const QString &encoding);
 	static bool parseUnsigned(const QString &str, quint32 &value);
 	static bool parseFloat(const QString &str, double &value);
@@ -122,14 +132,16 @@ private:
 
 	const QMap<QPair<MI_trackType_t, QString>, MI_propertyId_t> &m_mediaInfoIdx;
 	const QMap<QString, MI_propertyId_t> &m_avisynthIdx;
-	const QMap<QString, QString> &m_mimeTypes;
 	const QMap<QString, MI_trackType_t> &m_trackTypes;
 
 	const unsigned int m_taskId;
 	const QString m_mediaInfoBin;
 	const quint32 m_mediaInfoVer;
 	const QString m_avs2wavBin;
-	const QString m_inputFile;
+	const QStringList m_inputFiles;
+
+	AnalysisCache *const m_cache;
+	const bool m_useProbe;
 
 	QAtomicInt &m_abortFlag;
 };
@@ -27,6 +27,7 @@
 #include "Tools.h"
 #include "LockedFile.h"
 #include "FileHash.h"
+#include "ToolCache.h"
 #include "Tool_Abstract.h"
 
 //MUtils
@@ -192,9 +193,10 @@ QAtomicInt BaseTask::s_exception(0);
 class ExtractorTask : public BaseTask
 {
 public:
-	ExtractorTask(QResource *const toolResource, const QDir &appDir, const QString &toolName, const QByteArray &toolHash, const unsigned int toolVersion, const QString &toolTag)
+	ExtractorTask(QResource *const toolResource, const QDir &appDir, const QString &toolsPath, const QString &toolName, const QByteArray &toolHash, const unsigned int toolVersion, const QString &toolTag)
 	:
 		m_appDir(appDir),
+		m_toolsPath(toolsPath),
 		m_tempPath(MUtils::temp_folder()),
 		m_toolName(toolName),
 		m_toolHash(toolHash),
@@ -266,6 +268,35 @@ protected:
 			}
 		}
 
+		//Try to re-use the tool from the persistent tools folder, or extract it there
+		if(lockedFile.isNull() && (!m_toolsPath.isEmpty()))
+		{
+			const QString persistentTool = QString("%1/%2").arg(m_toolsPath, toolShrtName);
+			if(QFileInfo(persistentTool).isFile())
+			{
+				try
+				{
+					lockedFile.reset(new LockedFile(persistentTool, m_toolHash));
+				}
+				catch(std::runtime_error&)
+				{
+					lockedFile.reset();
+				}
+			}
+			if(lockedFile.isNull())
+			{
+				qDebug("Extracting file: %s -> %s [persistent]", m_toolName.toLatin1().constData(), toolShrtName.toLatin1().constData());
+				try
+				{
+					lockedFile.reset(new LockedFile(m_toolResource.data(), persistentTool, m_toolHash, false));
+				}
+				catch(std::runtime_error&)
+				{
+					lockedFile.reset();
+				}
+			}
+		}
+
 		//If still not initialized, extract tool now!
 		if(lockedFile.isNull())
 		{
@@ -281,6 +312,7 @@ private:
 	static QAtomicInt         s_custom;
 	QScopedPointer<QResource> m_toolResource;
 	const QDir                m_appDir;
+	const QString             m_toolsPath;
 	const QString             m_tempPath;
 	const QString             m_toolName;
 	const QByteArray          m_toolHash;
@@ -429,6 +461,10 @@ double InitializationThread::doInit(const size_t threadCount)
 
 	QDir appDir = QDir(QCoreApplication::applicationDirPath()).canonicalPath();
 
+	//Load the manifest of previously verified tools
+	ToolCache *const toolCache = ToolCache::instance();
+	const QString toolsPath = toolCache ? toolCache->toolsFolder() : QString();
+
 	QScopedPointer<QThreadPool> pool(new QThreadPool());
 	pool->setMaxThreadCount((threadCount > 0) ? threadCount : qBound(2U, cores2threads(m_cpuFeatures.count), 16U));
 	ExtractorTask::clearFlags();
@@ -462,7 +498,7 @@ double InitializationThread::doInit(const size_t threadCount)
 			
 		if(cpuType & cpuSupport)
 		{
-			pool->start(new ExtractorTask(resource.take(), appDir, toolName, toolHash, version, versInfo));
+			pool->start(new ExtractorTask(resource.take(), appDir, toolsPath, toolName, toolHash, version, versInfo));
 			continue;
 		}
 	}
@@ -476,6 +512,12 @@ double InitializationThread::doInit(const size_t threadCount)
 	//Wait for extrator threads to finish
 	pool->waitForDone();
 
+	//Store the updated manifest
+	if(toolCache)
+	{
+		toolCache->flush();
+	}
+
 	//Performance measure
 	const double delayExtract = double(timeExtractStart.elapsed()) / 1000.0;
 	timeExtractStart.invalidate();
@@ -514,7 +556,10 @@ double InitializationThread::doInit(const size_t threadCount)
 	}
 
 	//Register all translations
+	QElapsedTimer timePhase;
+	timePhase.start();
 	initTranslations();
+	const double delayTranslations = double(timePhase.restart()) / 1000.0;
 
 	//Look for AAC encoders
 	InitAacEncTask::clearFlags();
@@ -537,6 +582,10 @@ double InitializationThread::doInit(const size_t threadCount)
 		return -1.0;
 	}
 
+	//Performance summary
+	const double delayAacEnc = double(timePhase.elapsed()) / 1000.0;
+	qDebug("Initialization timing: extract=%.3f, translations=%.3f, aacenc=%.3f [sec]\n", delayExtract, delayTranslations, delayAacEnc);
+
 	m_bSuccess = true;
 	delay();
 
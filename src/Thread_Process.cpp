@@ -31,7 +31,12 @@
 #include "Filter_Abstract.h"
 #include "Filter_Downmix.h"
 #include "Filter_Resample.h"
+#include "Filter_SoxChain.h"
 #include "Tool_WaveProperties.h"
+#include "Tool_PipeSource.h"
+#include "Tool_WaveSlicer.h"
+#include "Thread_FileAnalyzer_Task.h"
+#include "Thread_Process_Stages.h"
 #include "Registry_Decoder.h"
 #include "Model_Settings.h"
 
@@ -48,6 +53,8 @@
 #include <QMutexLocker>
 #include <QDate>
 #include <QThreadPool>
+#include <QHash>
+#include <QSharedPointer>
 
 //CRT
 #include <limits.h>
@@ -58,6 +65,39 @@
 #define IS_WAVE(X) ((X.containerType().compare("Wave", Qt::CaseInsensitive) == 0) && (X.audioType().compare("PCM", Qt::CaseInsensitive) == 0))
 #define STRDEF(STR,DEF) ((!STR.isEmpty()) ? STR : DEF)
 
+////////////////////////////////////////////////////////////
+// Source Images
+////////////////////////////////////////////////////////////
+
+//Compressed Cue Sheet images are decoded only once, all tracks are sliced from the same Wave file
+typedef struct
+{
+	QMutex mutex;
+	QString decodedFile;
+}
+source_image_t;
+
+static QMutex g_sourceImagesMutex;
+static QHash<QString, QSharedPointer<source_image_t>> g_sourceImages;
+
+/*
+ * Returns the entry of the given image, the global lock is only held for the lookup. The decoding is guarded by
+ * the entry's own mutex, so tracks of the same image wait for each other, but unrelated images are not blocked.
+ */
+static QSharedPointer<source_image_t> lookupSourceImage(const QString &imageFile)
+{
+	QMutexLocker lock(&g_sourceImagesMutex);
+	const QString key = QFileInfo(imageFile).absoluteFilePath().toLower();
+
+	QSharedPointer<source_image_t> &entry = g_sourceImages[key];
+	if(entry.isNull())
+	{
+		entry = QSharedPointer<source_image_t>(new source_image_t);
+	}
+
+	return entry;
+}
+
 ////////////////////////////////////////////////////////////
 // Constructor
 ////////////////////////////////////////////////////////////
@@ -73,8 +113,13 @@ ProcessThread::ProcessThread(const AudioFileModel &audioFile, const QString &out
 	m_renamePattern("<BaseName>"),
 	m_overwriteMode(OverwriteMode_KeepBoth),
 	m_keepDateTime(false),
+	m_streamingMode(false),
+	m_largeFile(false),
 	m_initialized(-1),
-	m_propDetect(new WaveProperties())
+	m_propDetect(new WaveProperties()),
+	m_stages(NULL),
+	m_mailbox(NULL),
+	m_queueWait(0)
 {
 	connect(m_encoder, SIGNAL(statusUpdated(int)), this, SLOT(handleUpdate(int)), Qt::DirectConnection);
 	connect(m_encoder, SIGNAL(messageLogged(QString)), this, SLOT(handleMessage(QString)), Qt::DirectConnection);
@@ -109,11 +154,16 @@ ProcessThread::~ProcessThread(void)
 
 bool ProcessThread::init(void)
 {
+	if(!m_mailbox)
+	{
+		MUTILS_THROW("Mailbox not set yet!");
+	}
+
 	if(m_initialized.testAndSetOrdered((-1), 0))
 	{
 		//Initialize job status
 		qDebug("Process thread %s has started.", m_jobId.toString().toLatin1().constData());
-		emit processStateInitialized(m_jobId, QFileInfo(m_audioFile.filePath()).fileName(), tr("Starting..."), ProgressModel::JobRunning);
+		m_mailbox->postInitialized(m_audioFile.hasSourceRange() ? sourceBaseName() : QFileInfo(m_audioFile.filePath()).fileName(), tr("Starting..."), ProgressModel::JobRunning);
 
 		//Initialize log
 		handleMessage(QString().sprintf("LameXP v%u.%02u (Build #%u), compiled on %s at %s", lamexp_version_major(), lamexp_version_minor(), lamexp_version_build(), MUTILS_UTF8(MUtils::Version::app_build_date().toString(Qt::ISODate)), MUTILS_UTF8(MUtils::Version::app_build_time().toString(Qt::ISODate))));
@@ -146,16 +196,17 @@ bool ProcessThread::start(QThreadPool *const pool)
 		case 1:
 			//File name generated successfully :-)
 			bSuccess = true;
+			m_queueTimer.start();
 			pool->start(this);
 			break;
 		case -1:
 			//File name already exists -> skipping!
-			emit processStateChanged(m_jobId, tr("Skipped."), ProgressModel::JobSkipped);
+			m_mailbox->postState(tr("Skipped."), ProgressModel::JobSkipped);
 			emit processStateFinished(m_jobId, m_outFileName, -1);
 			break;
 		default:
 			//File name could not be generated
-			emit processStateChanged(m_jobId, tr("Not found!"), ProgressModel::JobFailed);
+			m_mailbox->postState(tr("Not found!"), ProgressModel::JobFailed);
 			emit processStateFinished(m_jobId, m_outFileName, 0);
 			break;
 		}
@@ -202,25 +253,105 @@ void ProcessThread::processFile()
 
 	QString sourceFile = m_audioFile.filePath();
 
+	//Start statistics
+	QElapsedTimer totalTimer, stageTimer;
+	totalTimer.start();
+	m_queueWait = m_queueTimer.isValid() ? m_queueTimer.elapsed() : 0;
+	m_statistics.setSourceFile(sourceFile, static_cast<quint64>(QFileInfo(sourceFile).size()));
+	m_statistics.setDuration(m_audioFile.techInfo().duration());
+
+	//Extract embedded cover art now, if it has not been extracted yet
+	if(m_audioFile.metaInfo().coverEmbedded())
+	{
+		AnalyzeTask::retrieveEmbeddedCover(sourceFile, m_audioFile.metaInfo());
+	}
+
+	//Intermediate files that exceed the RIFF size limit will be written in Wave64 format, if the next consumer can read it
+	m_largeFile = WaveProperties::exceedsRiffLimit(IS_WAVE(m_audioFile.techInfo()) ? static_cast<quint64>(QFileInfo(sourceFile).size()) : WaveProperties::expectedSize(m_audioFile.techInfo()));
+
+	//-----------------------------------------------------
+	// Streaming mode (decode, filter and encode at once)
+	//-----------------------------------------------------
+
+	//Tracks of a Cue Sheet are always streamed, if possible, because otherwise the track must be extracted first
+	bool bStreamed = false;
+	if(m_streamingMode || m_audioFile.hasSourceRange())
+	{
+		bStreamed = processStreaming(bSuccess);
+	}
+
+	//-----------------------------------------------------
+	// Extract track from source file (Cue Sheet)
+	//-----------------------------------------------------
+
+	if((!bStreamed) && m_audioFile.hasSourceRange())
+	{
+		m_currentStep = DecodingStep;
+		AbstractDecoder *decoder = NULL;
+
+		//A compressed image has to be decoded before the track can be sliced from it
+		const AudioFileModel_TechInfo &imageInfo = m_audioFile.techInfo();
+		if(!IS_WAVE(imageInfo))
+		{
+			decoder = DecoderRegistry::lookup(imageInfo.containerType(), imageInfo.containerProfile(), imageInfo.audioType(), imageInfo.audioProfile(), imageInfo.audioVersion());
+			if(!decoder)
+			{
+				handleMessage(QString("%1\n%2\n\n%3\t%4\n%5\t%6").arg(tr("The format of this file is NOT supported:"), m_audioFile.filePath(), tr("Container Format:"), m_audioFile.containerInfo(), tr("Audio Format:"), m_audioFile.audioCompressInfo()));
+				m_mailbox->postState(tr("Unsupported!"), ProgressModel::JobFailed);
+				emit processStateFinished(m_jobId, m_outFileName, 0);
+				return;
+			}
+		}
+
+		//Wait for other tracks of the same image *before* taking a decode slot, so waiting tracks don't occupy the stage
+		notifyWaiting(ProcessStages::Stage_Decode);
+		const QSharedPointer<source_image_t> sourceImage = decoder ? lookupSourceImage(sourceFile) : QSharedPointer<source_image_t>();
+		QMutexLocker imageLock(sourceImage.isNull() ? NULL : &sourceImage->mutex);
+		const ProcessStageLocker stageLock(m_stages, ProcessStages::Stage_Decode, m_aborted, &m_queueWait);
+		stageTimer.start();
+
+		QString imageFile = sourceFile;
+		bSuccess = stageLock.isLocked() && ((!decoder) || decodeSourceImage(imageFile, sourceImage->decodedFile, decoder));
+		imageLock.unlock();
+		MUTILS_DELETE(decoder);
+
+		const QString tempFile = generateTempFileName();
+		WaveSlicer slicer(imageFile);
+		bSuccess = bSuccess && slicer.setRange(m_audioFile.sourceOffset(), m_audioFile.sourceLength(), &m_audioFile.techInfo()) && slicer.extract(tempFile, m_aborted, [this](const int progress) { handleUpdate(progress); });
+		m_statistics.addStage(JobStatistics::Stage_Decode, QString::fromLatin1("WaveSlicer"), stageTimer.elapsed());
+
+		if(bSuccess)
+		{
+			sourceFile = tempFile;
+			handleMessage(QString("%1\n%2\n\n-------------------------------\n").arg(tr("The track has been extracted from the source file:"), QDir::toNativeSeparators(m_audioFile.filePath())));
+		}
+	}
+
 	//-----------------------------------------------------
 	// Decode source file
 	//-----------------------------------------------------
 
 	const AudioFileModel_TechInfo &formatInfo = m_audioFile.techInfo();
-	if(!m_filters.isEmpty() || !m_encoder->isFormatSupported(formatInfo.containerType(), formatInfo.containerProfile(), formatInfo.audioType(), formatInfo.audioProfile(), formatInfo.audioVersion()))
+	if((!bStreamed) && bSuccess && (!m_aborted) && (!m_filters.isEmpty() || !m_encoder->isFormatSupported(formatInfo.containerType(), formatInfo.containerProfile(), formatInfo.audioType(), formatInfo.audioProfile(), formatInfo.audioVersion()))
 	{
 		m_currentStep = DecodingStep;
 		AbstractDecoder *decoder = DecoderRegistry::lookup(formatInfo.containerType(), formatInfo.containerProfile(), formatInfo.audioType(), formatInfo.audioProfile(), formatInfo.audioVersion());
 		
 		if(decoder)
 		{
+			notifyWaiting(ProcessStages::Stage_Decode);
+			const ProcessStageLocker stageLock(m_stages, ProcessStages::Stage_Decode, m_aborted, &m_queueWait);
+			const QString decoderName = QString::fromLatin1(decoder->metaObject()->className());
+			stageTimer.start();
+
 			QString tempFile = generateTempFileName();
 
 			connect(decoder, SIGNAL(statusUpdated(int)), this, SLOT(handleUpdate(int)), Qt::DirectConnection);
 			connect(decoder, SIGNAL(messageLogged(QString)), this, SLOT(handleMessage(QString)), Qt::DirectConnection);
 
-			bSuccess = decoder->decode(sourceFile, tempFile, m_aborted);
+			bSuccess = stageLock.isLocked() && decoder->decode(sourceFile, tempFile, m_aborted);
 			MUTILS_DELETE(decoder);
+			m_statistics.addStage(JobStatistics::Stage_Decode, decoderName, stageTimer.elapsed());
 
 			if(bSuccess)
 			{
@@ -228,9 +359,9 @@ void ProcessThread::processFile()
 				m_audioFile.techInfo().setContainerType(QString::fromLatin1("Wave"));
 				m_audioFile.techInfo().setAudioType(QString::fromLatin1("PCM"));
 
-				if(QFileInfo(sourceFile).size() >= 4294967296i64)
+				if(WaveProperties::exceedsRiffLimit(QFileInfo(sourceFile).size()))
 				{
-					handleMessage(tr("WARNING: Decoded file size exceeds 4 GB, problems might occur!\n"));
+					m_largeFile = true;
 				}
 
 				handleMessage("\n-------------------------------\n");
@@ -240,7 +371,7 @@ void ProcessThread::processFile()
 		{
 			if(QFileInfo(m_outFileName).exists() && (QFileInfo(m_outFileName).size() < 512)) QFile::remove(m_outFileName);
 			handleMessage(QString("%1\n%2\n\n%3\t%4\n%5\t%6").arg(tr("The format of this file is NOT supported:"), m_audioFile.filePath(), tr("Container Format:"), m_audioFile.containerInfo(), tr("Audio Format:"), m_audioFile.audioCompressInfo()));
-			emit processStateChanged(m_jobId, tr("Unsupported!"), ProgressModel::JobFailed);
+			m_mailbox->postState(tr("Unsupported!"), ProgressModel::JobFailed);
 			emit processStateFinished(m_jobId, m_outFileName, 0);
 			return;
 		}
@@ -250,31 +381,19 @@ void ProcessThread::processFile()
 	// Update audio properties after decode
 	//-----------------------------------------------------
 
-	if(bSuccess && (!m_aborted) && IS_WAVE(m_audioFile.techInfo()))
+	if((!bStreamed) && bSuccess && (!m_aborted) && IS_WAVE(m_audioFile.techInfo()))
 	{
 		if(m_encoder->supportedSamplerates() || m_encoder->supportedBitdepths() || m_encoder->supportedChannelCount() || m_encoder->needsTimingInfo() || !m_filters.isEmpty())
 		{
 			m_currentStep = AnalyzeStep;
+			stageTimer.start();
 			bSuccess = m_propDetect->detect(sourceFile, &m_audioFile.techInfo(), m_aborted);
+			m_statistics.addStage(JobStatistics::Stage_Analyze, QString(), stageTimer.elapsed());
 
 			if(bSuccess)
 			{
 				handleMessage("\n-------------------------------\n");
-
-				//Do we need to take care if Stereo downmix?
-				const unsigned int *const supportedChannelCount = m_encoder->supportedChannelCount();
-				if(supportedChannelCount && supportedChannelCount[0])
-				{
-					insertDownmixFilter(supportedChannelCount);
-				}
-
-				//Do we need to take care of downsampling the input?
-				const unsigned int *const supportedSamplerates = m_encoder->supportedSamplerates();
-				const unsigned int *const supportedBitdepths = m_encoder->supportedBitdepths();
-				if((supportedSamplerates && supportedSamplerates[0]) || (supportedBitdepths && supportedBitdepths[0]))
-				{
-					insertDownsampleFilter(supportedSamplerates, supportedBitdepths);
-				}
+				insertEncoderFilters();
 			}
 		}
 	}
@@ -283,38 +402,78 @@ void ProcessThread::processFile()
 	// Apply all audio filters
 	//-----------------------------------------------------
 
-	while(bSuccess && (!m_filters.isEmpty()) && (!m_aborted))
+	if((!bStreamed) && bSuccess && (!m_aborted))
 	{
-		QString tempFile = generateTempFileName();
-		AbstractFilter *poFilter = m_filters.takeFirst();
-		m_currentStep = FilteringStep;
+		compileFilterChain();
+	}
 
-		connect(poFilter, SIGNAL(statusUpdated(int)), this, SLOT(handleUpdate(int)), Qt::DirectConnection);
-		connect(poFilter, SIGNAL(messageLogged(QString)), this, SLOT(handleMessage(QString)), Qt::DirectConnection);
+	if((!bStreamed) && bSuccess && (!m_filters.isEmpty()) && (!m_aborted))
+	{
+		notifyWaiting(ProcessStages::Stage_Filter);
+		const ProcessStageLocker stageLock(m_stages, ProcessStages::Stage_Filter, m_aborted, &m_queueWait);
 
-		const AbstractFilter::FilterResult filterResult = poFilter->apply(sourceFile, tempFile, &m_audioFile.techInfo(), m_aborted);
-		switch (filterResult)
+		while(bSuccess && (!m_filters.isEmpty()) && (!m_aborted))
 		{
-		case AbstractFilter::FILTER_SUCCESS:
-			sourceFile = tempFile;
-			break;
-		case AbstractFilter::FILTER_FAILURE:
-			bSuccess = false;
-			break;
-		}
+			AbstractFilter *poFilter = m_filters.takeFirst();
+			m_currentStep = FilteringStep;
 
-		handleMessage("\n-------------------------------\n");
-		delete poFilter;
+			//Only SoX reads Wave64, i.e. the next filter or the pipe to the encoder (encoders without pipe support get a RIFF file)
+			const bool bWave64 = m_largeFile && ((!m_filters.isEmpty()) || m_encoder->supportsPipeInput());
+			const QString tempFile = generateTempFileName(bWave64 ? "w64" : "wav");
+			if(bWave64)
+			{
+				handleMessage(tr("PCM size exceeds 4 GB, the filter output will be created in Wave64 format.\n"));
+			}
+
+			//A RIFF file above 4 GB has an overflowed length, so SoX must read up to the end of the file
+			poFilter->setIgnoreInputLength(sourceFile.endsWith(".wav", Qt::CaseInsensitive) && WaveProperties::exceedsRiffLimit(QFileInfo(sourceFile).size()));
+
+			connect(poFilter, SIGNAL(statusUpdated(int)), this, SLOT(handleUpdate(int)), Qt::DirectConnection);
+			connect(poFilter, SIGNAL(messageLogged(QString)), this, SLOT(handleMessage(QString)), Qt::DirectConnection);
+
+			stageTimer.start();
+			const AbstractFilter::FilterResult filterResult = poFilter->apply(sourceFile, tempFile, &m_audioFile.techInfo(), m_aborted);
+			m_statistics.addStage(JobStatistics::Stage_Filter, QString::fromLatin1(poFilter->metaObject()->className()), stageTimer.elapsed());
+			switch (filterResult)
+			{
+			case AbstractFilter::FILTER_SUCCESS:
+				sourceFile = tempFile;
+				break;
+			case AbstractFilter::FILTER_FAILURE:
+				bSuccess = false;
+				break;
+			}
+
+			handleMessage("\n-------------------------------\n");
+			delete poFilter;
+		}
 	}
 
 	//-----------------------------------------------------
 	// Encode audio file
 	//-----------------------------------------------------
 
-	if(bSuccess && (!m_aborted))
+	if((!bStreamed) && bSuccess && (!m_aborted))
 	{
+		notifyWaiting(ProcessStages::Stage_Encode);
+		const ProcessStageLocker stageLock(m_stages, ProcessStages::Stage_Encode, m_aborted, &m_queueWait);
+
 		m_currentStep = EncodingStep;
-		bSuccess = m_encoder->encode(sourceFile, m_audioFile.metaInfo(), m_audioFile.techInfo().duration(), m_audioFile.techInfo().audioChannels(), m_outFileName, m_aborted);
+		stageTimer.start();
+		const bool bLargeInput = WaveProperties::exceedsRiffLimit(QFileInfo(sourceFile).size());
+		if(stageLock.isLocked() && bLargeInput && m_encoder->supportsPipeInput())
+		{
+			bSuccess = encodeLargeFile(sourceFile);
+		}
+		else
+		{
+			if(bLargeInput)
+			{
+				handleMessage(tr("WARNING: Source file size exceeds 4 GB, problems might occur!\n\n"));
+			}
+			bSuccess = stageLock.isLocked() && m_encoder->encode(sourceFile, m_audioFile.metaInfo(), m_audioFile.techInfo().duration(), m_audioFile.techInfo().audioChannels(), m_outFileName, m_aborted);
+		}
+		m_statistics.addStage(JobStatistics::Stage_Encode, QString::fromLatin1(m_encoder->metaObject()->className()), stageTimer.elapsed());
 	}
 
 	//Clean-up
@@ -345,13 +504,228 @@ void ProcessThread::processFile()
 
 	MUtils::OS::sleep_ms(12);
 
+	//Report statistics
+	const QFileInfo outFileInfo(m_outFileName);
+	m_statistics.setOutputFile(m_outFileName, outFileInfo.exists() ? static_cast<quint64>(outFileInfo.size()) : 0);
+	m_statistics.setResult((bSuccess && (!m_aborted)) ? 1 : 0);
+	m_statistics.setTotalTime(totalTimer.elapsed());
+	m_statistics.addQueueWait(m_queueWait);
+	handleMessage(QString("\n-------------------------------\n\n%1\n").arg(m_statistics.toText()));
+	emit processStatistics(m_jobId, m_statistics);
+
 	//Report result
-	emit processStateChanged(m_jobId, (MUTILS_BOOLIFY(m_aborted) ? tr("Aborted!") : (bSuccess ? tr("Done.") : tr("Failed!"))), ((bSuccess && (!m_aborted)) ? ProgressModel::JobComplete : ProgressModel::JobFailed));
+	m_mailbox->postState((MUTILS_BOOLIFY(m_aborted) ? tr("Aborted!") : (bSuccess ? tr("Done.") : tr("Failed!"))), ((bSuccess && (!m_aborted)) ? ProgressModel::JobComplete : ProgressModel::JobFailed));
 	emit processStateFinished(m_jobId, m_outFileName, (bSuccess ? 1 : 0));
 
 	qDebug("Process thread is done.");
 }
 
+bool ProcessThread::processStreaming(bool &bSuccess)
+{
+	const AudioFileModel_TechInfo &formatInfo = m_audioFile.techInfo();
+	const bool bSlice = m_audioFile.hasSourceRange();
+	const bool bDecode = !IS_WAVE(formatInfo);
+
+	//Tracks of a Cue Sheet are sliced from an uncompressed source file, there is no decoder involved
+	if(bSlice && bDecode)
+	{
+		return false; /*unsupported format will be reported later*/
+	}
+
+	//Streaming only makes sense, if the encoder can not read the source file directly
+	if((!m_encoder->supportsPipeInput()) || (m_filters.isEmpty() && (!bSlice) && ((!bDecode) || m_encoder->isFormatSupported(formatInfo.containerType(), formatInfo.containerProfile(), formatInfo.audioType(), formatInfo.audioProfile(), formatInfo.audioVersion()))))
+	{
+		return false;
+	}
+
+	//We skip the analysis step, so the format must be known in advance
+	if((!formatInfo.audioSamplerate()) || (!formatInfo.audioChannels()) || (m_encoder->needsTimingInfo() && (!formatInfo.duration())))
+	{
+		qDebug("Format info incomplete, streaming mode not possible!");
+		return false;
+	}
+
+	//Can the decoder write to stdout?
+	QString decoderProgram;
+	QStringList decoderArgs;
+	if(bDecode)
+	{
+		AbstractDecoder *decoder = DecoderRegistry::lookup(formatInfo.containerType(), formatInfo.containerProfile(), formatInfo.audioType(), formatInfo.audioProfile(), formatInfo.audioVersion());
+		if(!decoder)
+		{
+			return false; /*unsupported format will be reported later*/
+		}
+		const bool bPipeSupported = decoder->pipeCommand(m_audioFile.filePath(), decoderProgram, decoderArgs);
+		MUTILS_DELETE(decoder);
+		if(!bPipeSupported)
+		{
+			return false;
+		}
+	}
+
+	//Can all filters read from stdin and write to stdout? (e.g. normalization needs to see the whole input first)
+	for(QList<AbstractFilter*>::ConstIterator iter = m_filters.constBegin(); iter != m_filters.constEnd(); iter++)
+	{
+		if(!(*iter)->supportsPipe())
+		{
+			qDebug("Filter needs an intermediate file, streaming mode not possible!");
+			return false;
+		}
+	}
+
+	//From here on, we are committed to streaming mode
+	notifyWaiting(ProcessStages::Stage_Encode);
+	const ProcessStageLocker stageLock(m_stages, ProcessStages::Stage_Encode, m_aborted, &m_queueWait);
+	if(!stageLock.isLocked())
+	{
+		bSuccess = false;
+		return true;
+	}
+
+	m_currentStep = EncodingStep;
+	QElapsedTimer streamTimer;
+	streamTimer.start();
+	handleMessage(tr("Streaming mode, no intermediate files will be created.") + "\n\n-------------------------------\n");
+
+	m_audioFile.techInfo().setContainerType(QString::fromLatin1("Wave"));
+	m_audioFile.techInfo().setAudioType(QString::fromLatin1("PCM"));
+	insertEncoderFilters();
+	compileFilterChain();
+
+	WaveSlicer slicer(m_audioFile.filePath());
+	PipeSource pipeSource(m_tempDirectory);
+	connect(&pipeSource, SIGNAL(statusUpdated(int)), this, SLOT(handleUpdate(int)), Qt::DirectConnection);
+	connect(&pipeSource, SIGNAL(messageLogged(QString)), this, SLOT(handleMessage(QString)), Qt::DirectConnection);
+
+	int stageCount = 0;
+	if(bSlice)
+	{
+		if(!slicer.setRange(m_audioFile.sourceOffset(), m_audioFile.sourceLength()))
+		{
+			bSuccess = false;
+			return true;
+		}
+		pipeSource.setInputSlice(&slicer);
+	}
+	else if(bDecode)
+	{
+		pipeSource.addStage(decoderProgram, decoderArgs);
+		stageCount++;
+	}
+	else
+	{
+		pipeSource.setInputFile(m_audioFile.filePath());
+	}
+
+	while(!m_filters.isEmpty())
+	{
+		AbstractFilter *poFilter = m_filters.takeFirst();
+		QString program;
+		QStringList args;
+		switch(poFilter->pipeCommand(program, args, &m_audioFile.techInfo()))
+		{
+		case AbstractFilter::FILTER_SUCCESS:
+			pipeSource.addStage(program, args);
+			stageCount++;
+			break;
+		case AbstractFilter::FILTER_FAILURE:
+			bSuccess = false;
+			break;
+		}
+		delete poFilter;
+	}
+
+	if((!bSuccess) || MUTILS_BOOLIFY(m_aborted))
+	{
+		return true;
+	}
+
+	//All filters have been skipped, so pass the Wave file to the encoder
+	const AudioFileModel_TechInfo &outputInfo = m_audioFile.techInfo();
+	if((stageCount < 1) && (!bSlice))
+	{
+		bSuccess = m_encoder->encode(m_audioFile.filePath(), m_audioFile.metaInfo(), outputInfo.duration(), outputInfo.audioChannels(), m_outFileName, m_aborted);
+		m_statistics.addStage(JobStatistics::Stage_Encode, QString::fromLatin1(m_encoder->metaObject()->className()), streamTimer.elapsed());
+		return true;
+	}
+
+	//Progress is computed from the number of bytes that have been fed to the encoder
+	const unsigned int bitdepth = outputInfo.audioBitdepth();
+	const quint64 bytesPerSample = (bitdepth == AudioFileModel::BITDEPTH_IEEE_FLOAT32) ? 4ui64 : static_cast<quint64>((qBound(8U, (bitdepth ? bitdepth : 16U), 32U) + 7U) / 8U);
+	pipeSource.setExpectedSize(static_cast<quint64>(outputInfo.duration()) * outputInfo.audioSamplerate() * outputInfo.audioChannels() * bytesPerSample);
+
+	disconnect(m_encoder, SIGNAL(statusUpdated(int)), this, SLOT(handleUpdate(int)));
+
+	if(pipeSource.start())
+	{
+		m_encoder->setInputPipe(&pipeSource);
+		bSuccess = m_encoder->encode(QString::fromLatin1("-"), m_audioFile.metaInfo(), outputInfo.duration(), outputInfo.audioChannels(), m_outFileName, m_aborted);
+		m_encoder->setInputPipe(NULL);
+		if(!pipeSource.close((!bSuccess) || MUTILS_BOOLIFY(m_aborted)))
+		{
+			bSuccess = false;
+		}
+	}
+	else
+	{
+		bSuccess = false;
+	}
+
+	m_statistics.addStage(JobStatistics::Stage_Stream, QString::fromLatin1(m_encoder->metaObject()->className()), streamTimer.elapsed());
+	connect(m_encoder, SIGNAL(statusUpdated(int)), this, SLOT(handleUpdate(int)), Qt::DirectConnection);
+	return true;
+}
+
+/*
+ * Most encoders can not read RIFF files above 4 GB (or Wave64 files), so SoX passes the audio data to the encoder
+ * via pipe, with an "unknown" length in the Wave header. Encoders with pipe support ignore that length.
+ */
+bool ProcessThread::encodeLargeFile(const QString &sourceFile)
+{
+	const QString soxBinary = lamexp_tools_lookup("sox.exe");
+	if(soxBinary.isEmpty())
+	{
+		qWarning("SoX binary not found, unable to encode large file via pipe!");
+		return false;
+	}
+
+	QStringList args;
+	args << "-V2";
+	if(sourceFile.endsWith(".wav", Qt::CaseInsensitive))
+	{
+		args << "--ignore-length";
+	}
+	args << QDir::toNativeSeparators(sourceFile);
+	args << "-t" << "wav" << "-";
+
+	handleMessage(tr("Source file exceeds 4 GB, the audio data will be passed to the encoder via pipe.") + "\n\n-------------------------------\n");
+
+	PipeSource pipeSource(m_tempDirectory);
+	connect(&pipeSource, SIGNAL(statusUpdated(int)), this, SLOT(handleUpdate(int)), Qt::DirectConnection);
+	connect(&pipeSource, SIGNAL(messageLogged(QString)), this, SLOT(handleMessage(QString)), Qt::DirectConnection);
+
+	pipeSource.addStage(soxBinary, args);
+	pipeSource.setExpectedSize(static_cast<quint64>(QFileInfo(sourceFile).size()));
+
+	disconnect(m_encoder, SIGNAL(statusUpdated(int)), this, SLOT(handleUpdate(int)));
+
+	bool bSuccess = false;
+	if(pipeSource.start())
+	{
+		const AudioFileModel_TechInfo &formatInfo = m_audioFile.techInfo();
+		m_encoder->setInputPipe(&pipeSource);
+		bSuccess = m_encoder->encode(QString::fromLatin1("-"), m_audioFile.metaInfo(), formatInfo.duration(), formatInfo.audioChannels(), m_outFileName, m_aborted);
+		m_encoder->setInputPipe(NULL);
+		if(!pipeSource.close((!bSuccess) || MUTILS_BOOLIFY(m_aborted)))
+		{
+			bSuccess = false;
+		}
+	}
+
+	connect(m_encoder, SIGNAL(statusUpdated(int)), this, SLOT(handleUpdate(int)), Qt::DirectConnection);
+	return bSuccess;
+}
+
 ////////////////////////////////////////////////////////////
 // SLOTS
 ////////////////////////////////////////////////////////////
@@ -360,26 +734,16 @@ void ProcessThread::handleUpdate(int progress)
 {
 	//qDebug("Progress: %d\n", progress);
 	
-	switch(m_currentStep)
+	//Only publish the step and the percentage, the status text is generated by the GUI thread
+	if(m_currentStep != UnknownStep)
 	{
-	case EncodingStep:
-		emit processStateChanged(m_jobId, QString("%1 (%2%)").arg(tr("Encoding"), QString::number(progress)), ProgressModel::JobRunning);
-		break;
-	case AnalyzeStep:
-		emit processStateChanged(m_jobId, QString("%1 (%2%)").arg(tr("Analyzing"), QString::number(progress)), ProgressModel::JobRunning);
-		break;
-	case FilteringStep:
-		emit processStateChanged(m_jobId, QString("%1 (%2%)").arg(tr("Filtering"), QString::number(progress)), ProgressModel::JobRunning);
-		break;
-	case DecodingStep:
-		emit processStateChanged(m_jobId, QString("%1 (%2%)").arg(tr("Decoding"), QString::number(progress)), ProgressModel::JobRunning);
-		break;
+		m_mailbox->postProgress(m_currentStep, progress);
 	}
 }
 
 void ProcessThread::handleMessage(const QString &line)
 {
-	emit processMessageLogged(m_jobId, line);
+	m_mailbox->postMessage(line);
 }
 
 ////////////////////////////////////////////////////////////
@@ -461,7 +825,7 @@ int ProcessThread::generateOutFileName(QString &outFileName)
 	const QString fileExt = m_renameFileExt.isEmpty() ? QString::fromUtf8(m_encoder->toEncoderInfo()->extension()) : m_renameFileExt;
 
 	//Generate file name
-	const QString fileName = MUtils::clean_file_name(QString("%1.%2").arg(applyRegularExpression(applyRenamePattern(sourceFile.completeBaseName(), m_audioFile.metaInfo())), fileExt), true);
+	const QString fileName = MUtils::clean_file_name(QString("%1.%2").arg(applyRegularExpression(applyRenamePattern(sourceBaseName(), m_audioFile.metaInfo())), fileExt), true);
 
 	//Generate full output path
 	outFileName = targetDir.absoluteFilePath(fileName);
@@ -504,6 +868,69 @@ int ProcessThread::generateOutFileName(QString &outFileName)
 	return 0;
 }
 
+QString ProcessThread::sourceBaseName(void)
+{
+	const QString baseName = QFileInfo(m_audioFile.filePath()).completeBaseName();
+
+	//Tracks of a Cue Sheet share the same source file, so the track must be part of the name
+	if(m_audioFile.hasSourceRange())
+	{
+		const AudioFileModel_MetaInfo &metaInfo = m_audioFile.metaInfo();
+		return QString("[%1] %2 - %3").arg(QString().sprintf("%02d", metaInfo.position()), baseName, STRDEF(metaInfo.title(), tr("Unknown Title")));
+	}
+
+	return baseName;
+}
+
+/*
+ * Decodes the image, unless it has been decoded before. The caller must hold the mutex of the image entry that owns
+ * "decodedImage", so tracks of the same image may run in parallel, but only the first one will actually decode it.
+ */
+bool ProcessThread::decodeSourceImage(QString &imageFile, QString &decodedImage, AbstractDecoder *const decoder)
+{
+	if((!decodedImage.isEmpty()) && QFileInfo(decodedImage).isFile())
+	{
+		handleMessage(QString("%1\n%2\n\n").arg(tr("The source image has been decoded before:"), QDir::toNativeSeparators(imageFile)));
+		imageFile = decodedImage;
+		return true;
+	}
+
+	//Not a temporary file of this job, because other tracks are going to need the decoded image as well
+	const QString decodedFile = MUtils::make_temp_file(m_tempDirectory, QString::fromLatin1("wav"), true);
+	connect(decoder, SIGNAL(statusUpdated(int)), this, SLOT(handleUpdate(int)), Qt::DirectConnection);
+	connect(decoder, SIGNAL(messageLogged(QString)), this, SLOT(handleMessage(QString)), Qt::DirectConnection);
+
+	const bool bSuccess = (!decodedFile.isEmpty()) && decoder->decode(imageFile, decodedFile, m_aborted);
+
+	if(!bSuccess)
+	{
+		if(!decodedFile.isEmpty())
+		{
+			MUtils::remove_file(decodedFile);
+		}
+		return false;
+	}
+
+	handleMessage("\n-------------------------------\n");
+	decodedImage = decodedFile;
+	imageFile = decodedFile;
+	return true;
+}
+
+void ProcessThread::releaseSourceImages(void)
+{
+	QMutexLocker lock(&g_sourceImagesMutex);
+	for(QHash<QString, QSharedPointer<source_image_t>>::ConstIterator iter = g_sourceImages.constBegin(); iter != g_sourceImages.constEnd(); iter++)
+	{
+		QMutexLocker imageLock(&iter.value()->mutex);
+		if(!iter.value()->decodedFile.isEmpty())
+		{
+			MUtils::remove_file(iter.value()->decodedFile);
+		}
+	}
+	g_sourceImages.clear();
+}
+
 QString ProcessThread::applyRenamePattern(const QString &baseName, const AudioFileModel_MetaInfo &metaInfo)
 {
 	QString fileName = m_renamePattern;
@@ -537,12 +964,12 @@ QString ProcessThread::applyRegularExpression(const QString &baseName)
 	return fileName.trimmed().isEmpty() ? baseName : fileName;
 }
 
-QString ProcessThread::generateTempFileName(void)
+QString ProcessThread::generateTempFileName(const char *const extension)
 {
-	const QString tempFileName = MUtils::make_temp_file(m_tempDirectory, "wav", true);
+	const QString tempFileName = MUtils::make_temp_file(m_tempDirectory, QString::fromLatin1(extension), true);
 	if(tempFileName.isEmpty())
 	{
-		return QString("%1/~whoops%2.wav").arg(m_tempDirectory, QString::number(MUtils::next_rand_u32()));
+		return QString("%1/~whoops%2.%3").arg(m_tempDirectory, QString::number(MUtils::next_rand_u32()), QString::fromLatin1(extension));
 	}
 
 	m_tempFiles << tempFileName;
@@ -639,6 +1066,52 @@ bool ProcessThread::insertDownsampleFilter(const unsigned int *const supportedSa
 	return false; /*did not insert the resample filter */
 }
 
+void ProcessThread::insertEncoderFilters(void)
+{
+	//Do we need to take care if Stereo downmix?
+	const unsigned int *const supportedChannelCount = m_encoder->supportedChannelCount();
+	if(supportedChannelCount && supportedChannelCount[0])
+	{
+		insertDownmixFilter(supportedChannelCount);
+	}
+
+	//Do we need to take care of downsampling the input?
+	const unsigned int *const supportedSamplerates = m_encoder->supportedSamplerates();
+	const unsigned int *const supportedBitdepths = m_encoder->supportedBitdepths();
+	if((supportedSamplerates && supportedSamplerates[0]) || (supportedBitdepths && supportedBitdepths[0]))
+	{
+		insertDownsampleFilter(supportedSamplerates, supportedBitdepths);
+	}
+}
+
+void ProcessThread::compileFilterChain(void)
+{
+	QList<AbstractFilter*> filters;
+
+	//Merge all runs of adjacent SoX-based filters into a single SoX invocation
+	while(!m_filters.isEmpty())
+	{
+		AbstractFilter *const filter = m_filters.takeFirst();
+		if((filter->soxEffectClass() != AbstractFilter::SOX_EFFECT_NONE) && (!m_filters.isEmpty()) && (m_filters.first()->soxEffectClass() != AbstractFilter::SOX_EFFECT_NONE))
+		{
+			SoxChainFilter *const chain = new SoxChainFilter();
+			chain->addFilter(filter);
+			while((!m_filters.isEmpty()) && (m_filters.first()->soxEffectClass() != AbstractFilter::SOX_EFFECT_NONE))
+			{
+				chain->addFilter(m_filters.takeFirst());
+			}
+			qDebug("Combined %d SoX filters into a single filter chain.", chain->filterCount());
+			filters.append(chain);
+		}
+		else
+		{
+			filters.append(filter);
+		}
+	}
+
+	m_filters = filters;
+}
+
 bool ProcessThread::insertDownmixFilter(const unsigned int *const supportedChannels)
 {
 	//Determine number of channels in source
@@ -704,6 +1177,14 @@ bool ProcessThread::updateFileTime(const QString &originalFile, const QString &m
 	return success;
 }
 
+void ProcessThread::notifyWaiting(const int &stage)
+{
+	if(m_stages && (!m_stages->available(static_cast<ProcessStages::Stage>(stage))))
+	{
+		m_mailbox->postState(tr("Waiting..."), ProgressModel::JobRunning);
+	}
+}
+
 ////////////////////////////////////////////////////////////
 // PUBLIC FUNCTIONS
 ////////////////////////////////////////////////////////////
@@ -758,6 +1239,21 @@ void ProcessThread::setKeepDateTime(const bool &keepDateTime)
 	m_keepDateTime = keepDateTime;
 }
 
+void ProcessThread::setStreamingMode(const bool &streamingMode)
+{
+	m_streamingMode = streamingMode;
+}
+
+void ProcessThread::setStages(ProcessStages *const stages)
+{
+	m_stages = stages;
+}
+
+void ProcessThread::setMailbox(ProcessMailbox::Slot *const mailbox)
+{
+	m_mailbox = mailbox;
+}
+
 ////////////////////////////////////////////////////////////
 // EVENTS
 ////////////////////////////////////////////////////////////
@@ -25,11 +25,16 @@
 #include <QRunnable>
 #include <QUuid>
 #include <QStringList>
+#include <QElapsedTimer>
 
 #include "Model_AudioFile.h"
 #include "Encoder_Abstract.h"
+#include "Model_JobStatistics.h"
+#include "Thread_Process_Mailbox.h"
 
 class AbstractFilter;
+class AbstractDecoder;
+class ProcessStages;
 class WaveProperties;
 class QThreadPool;
 class QCoreApplication;
@@ -51,7 +56,12 @@ public:
 	void setRenameFileExt(const QString &fileExtension);
 	void setOverwriteMode(const bool &bSkipExistingFile, const bool &bReplacesExisting = false);
 	void setKeepDateTime(const bool &keepDateTime);
+	void setStreamingMode(const bool &streamingMode);
 	void addFilter(AbstractFilter *filter);
+	void setStages(ProcessStages *const stages);
+	void setMailbox(ProcessMailbox::Slot *const mailbox);
+
+	static void releaseSourceImages(void);
 
 public slots:
 	void abort(void) { m_aborted.ref(); }
@@ -61,10 +71,8 @@ private slots:
 	void handleMessage(const QString &line);
 
 signals:
-	void processStateInitialized(const QUuid &jobId, const QString &jobName, const QString &jobInitialStatus, int jobInitialState);
-	void processStateChanged(const QUuid &jobId, const QString &newStatus, int newState);
 	void processStateFinished(const QUuid &jobId, const QString &outFileName, int success);
-	void processMessageLogged(const QUuid &jobId, const QString &line);
+	void processStatistics(const QUuid &jobId, const JobStatistics &statistics);
 	void processFinished(void);
 
 protected:
@@ -88,13 +96,20 @@ private:
 	};
 	
 	void processFile();
+	bool processStreaming(bool &bSuccess);
+	bool encodeLargeFile(const QString &sourceFile);
 	int generateOutFileName(QString &outFileName);
+	QString sourceBaseName(void);
+	bool decodeSourceImage(QString &imageFile, QString &decodedImage, AbstractDecoder *const decoder);
 	QString applyRenamePattern(const QString &baseName, const AudioFileModel_MetaInfo &metaInfo);
 	QString applyRegularExpression(const QString &baseName);
-	QString generateTempFileName(void);
+	QString generateTempFileName(const char *const extension = "wav");
 	bool insertDownmixFilter(const unsigned int *const supportedChannels);
 	bool insertDownsampleFilter(const unsigned int *const supportedSamplerates, const unsigned int *const supportedBitdepths);
+	void insertEncoderFilters(void);
+	void compileFilterChain(void);
 	bool updateFileTime(const QString &originalFile, const QString &modifiedFile);
+	void notifyWaiting(const int &stage);
 
 	QAtomicInt m_aborted;
 	QAtomicInt m_initialized;
@@ -114,6 +129,13 @@ private:
 	QString m_renameFileExt;
 	int m_overwriteMode;
 	bool m_keepDateTime;
+	bool m_streamingMode;
+	bool m_largeFile;
 	WaveProperties *m_propDetect;
+	ProcessStages *m_stages;
+	ProcessMailbox::Slot *m_mailbox;
+	JobStatistics m_statistics;
+	QElapsedTimer m_queueTimer;
+	qint64 m_queueWait;
 	QString m_outFileName;
 };
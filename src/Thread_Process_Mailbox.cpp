@@ -0,0 +1,201 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Thread_Process_Mailbox.h"
+
+//Internal
+#include "Model_Progress.h"
+
+//Qt
+#include <QApplication>
+#include <QMutexLocker>
+
+////////////////////////////////////////////////////////////
+// Constants
+////////////////////////////////////////////////////////////
+
+static const int NO_PROGRESS = -1;
+
+////////////////////////////////////////////////////////////
+// Slot
+////////////////////////////////////////////////////////////
+
+ProcessMailbox::Slot::Slot(const QUuid &jobId)
+:
+	m_jobId(jobId),
+	m_progress(NO_PROGRESS),
+	m_initPending(false),
+	m_statePending(false),
+	m_state(-1)
+{
+}
+
+void ProcessMailbox::Slot::postInitialized(const QString &jobName, const QString &status, const int &state)
+{
+	QMutexLocker lock(&m_mutex);
+	m_jobName = jobName;
+	m_status = status;
+	m_state = state;
+	m_initPending = true;
+}
+
+void ProcessMailbox::Slot::postState(const QString &status, const int &state)
+{
+	QMutexLocker lock(&m_mutex);
+	m_progress.fetchAndStoreOrdered(NO_PROGRESS); /*superseded by the new status*/
+	m_status = status;
+	m_state = state;
+	m_statePending = true;
+}
+
+void ProcessMailbox::Slot::postProgress(const int &step, const int &progress)
+{
+	m_progress.fetchAndStoreOrdered(((step & 0xFF) << 8) | (qBound(0, progress, 100)));
+}
+
+void ProcessMailbox::Slot::postMessage(const QString &line)
+{
+	QMutexLocker lock(&m_mutex);
+	m_messages << line;
+}
+
+////////////////////////////////////////////////////////////
+// Constructor & Destructor
+////////////////////////////////////////////////////////////
+
+ProcessMailbox::ProcessMailbox(void)
+{
+}
+
+ProcessMailbox::~ProcessMailbox(void)
+{
+	clear();
+}
+
+////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////
+
+/*
+ * Create the slot for a new job (GUI thread only)
+ */
+ProcessMailbox::Slot *ProcessMailbox::attach(const QUuid &jobId)
+{
+	Slot *slot = m_slots.value(jobId, NULL);
+	if(!slot)
+	{
+		slot = new Slot(jobId);
+		m_slots.insert(jobId, slot);
+		m_activeSlots.append(slot);
+	}
+	return slot;
+}
+
+/*
+ * Flush a finished job; the slot stays allocated until clear() is called, so late posts are harmless
+ */
+void ProcessMailbox::retire(const QUuid &jobId, ProgressModel *const model)
+{
+	if(Slot *const slot = m_slots.value(jobId, NULL))
+	{
+		drainSlot(slot, model);
+		m_activeSlots.removeAll(slot);
+	}
+}
+
+/*
+ * Deliver all pending updates to the progress model (GUI thread only)
+ */
+void ProcessMailbox::drain(ProgressModel *const model)
+{
+	for(QList<Slot*>::ConstIterator iter = m_activeSlots.constBegin(); iter != m_activeSlots.constEnd(); iter++)
+	{
+		drainSlot(*iter, model);
+	}
+}
+
+/*
+ * Release all slots, must *not* be called while jobs are still running
+ */
+void ProcessMailbox::clear(void)
+{
+	m_activeSlots.clear();
+	qDeleteAll(m_slots);
+	m_slots.clear();
+}
+
+////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////
+
+void ProcessMailbox::drainSlot(Slot *const slot, ProgressModel *const model)
+{
+	QString jobName, status;
+	QStringList messages;
+
+	//Take the pending data, while holding the lock as briefly as possible
+	QMutexLocker lock(&slot->m_mutex);
+	const bool initPending = slot->m_initPending;
+	const bool statePending = slot->m_statePending;
+	const int state = slot->m_state;
+	if(initPending || statePending)
+	{
+		jobName = slot->m_jobName;
+		status = slot->m_status;
+	}
+	messages.swap(slot->m_messages);
+	slot->m_initPending = slot->m_statePending = false;
+	lock.unlock();
+
+	if(initPending)
+	{
+		model->addJob(slot->m_jobId, jobName, status, state);
+	}
+	else if(statePending)
+	{
+		model->updateJob(slot->m_jobId, status, state);
+	}
+
+	if(!messages.isEmpty())
+	{
+		model->appendToLog(slot->m_jobId, messages);
+	}
+
+	const int progress = slot->m_progress.fetchAndStoreOrdered(NO_PROGRESS);
+	if(progress != NO_PROGRESS)
+	{
+		model->updateJob(slot->m_jobId, stepText(progress >> 8, progress & 0xFF), ProgressModel::JobRunning);
+	}
+}
+
+QString ProcessMailbox::stepText(const int &step, const int &progress)
+{
+	static const char *const STEP_NAMES[] =
+	{
+		QT_TRANSLATE_NOOP("ProcessThread", "Decoding"),
+		QT_TRANSLATE_NOOP("ProcessThread", "Analyzing"),
+		QT_TRANSLATE_NOOP("ProcessThread", "Filtering"),
+		QT_TRANSLATE_NOOP("ProcessThread", "Encoding")
+	};
+	const char *const stepName = ((step >= 0) && (step < int(sizeof(STEP_NAMES) / sizeof(STEP_NAMES[0])))) ? STEP_NAMES[step] : STEP_NAMES[0];
+	return QString("%1 (%2%)").arg(QApplication::translate("ProcessThread", stepName), QString::number(progress));
+}
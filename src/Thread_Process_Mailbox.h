@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <QMutex>
+#include <QAtomicInt>
+#include <QString>
+#include <QStringList>
+#include <QUuid>
+#include <QHash>
+#include <QList>
+
+class ProgressModel;
+
+////////////////////////////////////////////////////////////
+// Process Mailbox
+////////////////////////////////////////////////////////////
+
+/*
+ * Transports job status, progress and log lines from the worker threads to the GUI. Workers publish into their own
+ * slot and never wait for the GUI; the GUI drains all active slots on a fixed tick, so that a burst of progress
+ * updates is coalesced into a single update per job and tick. Progress is published lock-free, status and log lines
+ * are appended under a per-slot mutex that the GUI only holds for swapping out the pending data.
+ */
+class ProcessMailbox
+{
+public:
+	class Slot
+	{
+		friend class ProcessMailbox;
+
+	public:
+		void postInitialized(const QString &jobName, const QString &status, const int &state);
+		void postState(const QString &status, const int &state);
+		void postProgress(const int &step, const int &progress);
+		void postMessage(const QString &line);
+
+	private:
+		Slot(const QUuid &jobId);
+
+		const QUuid m_jobId;
+		QAtomicInt m_progress;
+
+		QMutex m_mutex;
+		bool m_initPending;
+		bool m_statePending;
+		QString m_jobName;
+		QString m_status;
+		int m_state;
+		QStringList m_messages;
+	};
+
+	ProcessMailbox(void);
+	~ProcessMailbox(void);
+
+	Slot *attach(const QUuid &jobId);
+	void retire(const QUuid &jobId, ProgressModel *const model);
+	void drain(ProgressModel *const model);
+	void clear(void);
+
+private:
+	void drainSlot(Slot *const slot, ProgressModel *const model);
+	static QString stepText(const int &step, const int &progress);
+
+	QHash<QUuid, Slot*> m_slots;
+	QList<Slot*> m_activeSlots;
+};
@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+#include "Thread_Process_Stages.h"
+
+//MUtils
+#include <MUtils/Global.h>
+
+////////////////////////////////////////////////////////////
+// Constructor & Destructor
+////////////////////////////////////////////////////////////
+
+ProcessStages::ProcessStages(const unsigned int &instances)
+{
+	for(int i = 0; i < Stage_Count; i++)
+	{
+		m_limit[i] = 1U;
+		m_active[i] = 0U;
+	}
+	setInstances(instances);
+}
+
+ProcessStages::~ProcessStages(void)
+{
+}
+
+////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////
+
+/*
+ * The encoder is usually the most CPU-intensive stage, so it gets the full number of instances, while decoding
+ * and filtering (mostly I/O bound) get half of it. The limits can be changed while jobs are running.
+ */
+void ProcessStages::setInstances(const unsigned int &instances)
+{
+	QMutexLocker lock(&m_mutex);
+
+	const unsigned int encodeLimit = qMax(1U, instances);
+	m_limit[Stage_Encode] = encodeLimit;
+	m_limit[Stage_Decode] = qMax(1U, (encodeLimit + 1U) / 2U);
+	m_limit[Stage_Filter] = qMax(1U, (encodeLimit + 1U) / 2U);
+
+	m_condition.wakeAll();
+}
+
+unsigned int ProcessStages::instances(void) const
+{
+	QMutexLocker lock(&m_mutex);
+	return m_limit[Stage_Encode];
+}
+
+unsigned int ProcessStages::lookAhead(void) const
+{
+	QMutexLocker lock(&m_mutex);
+	return m_limit[Stage_Decode];
+}
+
+unsigned int ProcessStages::limit(const Stage &stage) const
+{
+	QMutexLocker lock(&m_mutex);
+	return m_limit[stage];
+}
+
+bool ProcessStages::available(const Stage &stage) const
+{
+	QMutexLocker lock(&m_mutex);
+	return m_active[stage] < m_limit[stage];
+}
+
+bool ProcessStages::acquire(const Stage &stage, const QAtomicInt &abortFlag)
+{
+	QMutexLocker lock(&m_mutex);
+
+	while(m_active[stage] >= m_limit[stage])
+	{
+		if(MUTILS_BOOLIFY(abortFlag))
+		{
+			return false;
+		}
+		m_condition.wait(&m_mutex, 250);
+	}
+
+	m_active[stage]++;
+	return true;
+}
+
+void ProcessStages::release(const Stage &stage)
+{
+	QMutexLocker lock(&m_mutex);
+
+	if(m_active[stage] > 0U)
+	{
+		m_active[stage]--;
+	}
+
+	m_condition.wakeAll();
+}
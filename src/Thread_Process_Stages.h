@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+
+////////////////////////////////////////////////////////////
+// Process Stages
+////////////////////////////////////////////////////////////
+
+/*
+ * Limits the number of jobs that can be in the decoding, filtering and encoding stage at the same time. Jobs
+ * are admitted to the thread pool with some "look-ahead", so job N+1 can decode while job N is still encoding.
+ * A job that has completed a stage waits (with its intermediate file) until a slot in the next stage is free.
+ */
+class ProcessStages
+{
+public:
+	enum Stage
+	{
+		Stage_Decode = 0,
+		Stage_Filter = 1,
+		Stage_Encode = 2,
+		Stage_Count  = 3
+	};
+
+	ProcessStages(const unsigned int &instances);
+	~ProcessStages(void);
+
+	void setInstances(const unsigned int &instances);
+	unsigned int instances(void) const;
+	unsigned int lookAhead(void) const;
+	unsigned int limit(const Stage &stage) const;
+
+	bool available(const Stage &stage) const;
+	bool acquire(const Stage &stage, const QAtomicInt &abortFlag);
+	void release(const Stage &stage);
+
+private:
+	mutable QMutex m_mutex;
+	QWaitCondition m_condition;
+	unsigned int m_limit[Stage_Count];
+	unsigned int m_active[Stage_Count];
+};
+
+////////////////////////////////////////////////////////////
+// Process Stage Locker
+////////////////////////////////////////////////////////////
+
+class ProcessStageLocker
+{
+public:
+	ProcessStageLocker(ProcessStages *const stages, const ProcessStages::Stage &stage, const QAtomicInt &abortFlag, qint64 *const waitTime = NULL)
+	:
+		m_stages(stages),
+		m_stage(stage),
+		m_locked(acquire(stages, stage, abortFlag, waitTime))
+	{
+	}
+
+	~ProcessStageLocker(void)
+	{
+		if(m_stages && m_locked)
+		{
+			m_stages->release(m_stage);
+		}
+	}
+
+	bool isLocked(void) const { return m_locked; }
+
+private:
+	static bool acquire(ProcessStages *const stages, const ProcessStages::Stage &stage, const QAtomicInt &abortFlag, qint64 *const waitTime)
+	{
+		if(!stages)
+		{
+			return true;
+		}
+		QElapsedTimer timer;
+		timer.start();
+		const bool locked = stages->acquire(stage, abortFlag);
+		if(waitTime)
+		{
+			*waitTime += timer.elapsed();
+		}
+		return locked;
+	}
+
+	ProcessStages *const m_stages;
+	const ProcessStages::Stage m_stage;
+	const bool m_locked;
+};
@@ -34,6 +34,7 @@
 #define NOMINMAX
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
+#include <Psapi.h>
 
 ////////////////////////////////////////////////////////////
 // Constructor & Destructor
@@ -73,6 +74,25 @@ void RAMObserverThread::run(void)
 	while(m_semaphore.available()) m_semaphore.tryAcquire();
 }
 
+/*
+ * Current and peak (since process start-up) working set of this process
+ */
+bool RAMObserverThread::processMemory(quint64 &workingSet, quint64 &peakWorkingSet)
+{
+	PROCESS_MEMORY_COUNTERS counters;
+	memset(&counters, 0, sizeof(PROCESS_MEMORY_COUNTERS));
+	counters.cb = sizeof(PROCESS_MEMORY_COUNTERS);
+
+	if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(PROCESS_MEMORY_COUNTERS)))
+	{
+		workingSet = static_cast<quint64>(counters.WorkingSetSize);
+		peakWorkingSet = static_cast<quint64>(counters.PeakWorkingSetSize);
+		return true;
+	}
+
+	return false;
+}
+
 void RAMObserverThread::observe(void)
 {
 	MEMORYSTATUSEX memoryStatus;
@@ -34,6 +34,7 @@ public:
 	~RAMObserverThread(void);
 
 	void stop(void) { m_semaphore.release(); }
+	static bool processMemory(quint64 &workingSet, quint64 &peakWorkingSet);
 	
 protected:
 	void run(void);
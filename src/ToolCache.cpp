@@ -0,0 +1,381 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ToolCache.h"
+
+//Internal
+#include "Global.h"
+
+//MUtils
+#include <MUtils/Global.h>
+#include <MUtils/OSSupport.h>
+#include <MUtils/Hash.h>
+
+//Qt
+#include <QApplication>
+#include <QDesktopServices>
+#include <QDataStream>
+#include <QFileInfo>
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+#include <QStringList>
+
+////////////////////////////////////////////////////////////
+// Constants
+////////////////////////////////////////////////////////////
+
+static const char *const MANIFEST_MAGIC   = "LameXP_ToolCache";
+static const quint32     MANIFEST_VERSION = 1U;
+
+//Seed of the manifest checksum, this is public and therefore does *not* make the checksum a signature
+static const char *g_seed = "6a2f0d3e9bc14e7a58f1c2d07b93e4a6c5d8e1f20a3b4c5d6e7f8091a2b3c4d5e6f708192a3b4c5d6e7f8091a2b3c4d";
+
+////////////////////////////////////////////////////////////
+// Static Objects
+////////////////////////////////////////////////////////////
+
+QMutex ToolCache::s_instanceMutex;
+QScopedPointer<ToolCache> ToolCache::s_instance;
+
+////////////////////////////////////////////////////////////
+// Constructor & Destructor
+////////////////////////////////////////////////////////////
+
+ToolCache::ToolCache(const QString &manifestFile, const QString &toolsFolder, const QString &trustedFolder)
+:
+	m_manifestFile(manifestFile),
+	m_toolsFolder(toolsFolder),
+	m_trustedFolder(trustedFolder),
+	m_dirty(false),
+	m_statsTrusted(0U),
+	m_statsVerified(0U)
+{
+	load();
+}
+
+ToolCache::~ToolCache(void)
+{
+	flush();
+}
+
+ToolCache *ToolCache::instance(void)
+{
+	QMutexLocker lock(&s_instanceMutex);
+
+	if(s_instance.isNull())
+	{
+		QString manifestPath, toolsPath;
+		if(!lamexp_version_portable())
+		{
+			const QString dataPath = QDesktopServices::storageLocation(QDesktopServices::DataLocation);
+			if((!dataPath.isEmpty()) && QDir().mkpath(dataPath))
+			{
+				manifestPath = QString("%1/tools.manifest").arg(QDir(dataPath).canonicalPath());
+				const QString buildPath = QString("%1/tools/%2").arg(QDir(dataPath).canonicalPath(), QString::number(lamexp_version_build()));
+				if(QDir().mkpath(buildPath))
+				{
+					toolsPath = QDir(buildPath).canonicalPath();
+					removeStaleFolders(toolsPath);
+				}
+			}
+		}
+		else
+		{
+			const QFileInfo appPath(QApplication::applicationFilePath());
+			manifestPath = QString("%1/%2.manifest").arg(appPath.absolutePath(), appPath.completeBaseName());
+		}
+
+		if(manifestPath.isEmpty())
+		{
+			qWarning("ToolCache: Failed to determine manifest location!");
+			return NULL;
+		}
+
+		QString trustedPath;
+		const QDir cacheDir(QString("%1/cache").arg(QApplication::applicationDirPath()));
+		if(cacheDir.exists())
+		{
+			if(!isUserWritable(cacheDir.canonicalPath()))
+			{
+				trustedPath = cacheDir.canonicalPath();
+			}
+			else
+			{
+				qDebug("ToolCache: Cache folder is writable, manifest will not be trusted.");
+			}
+		}
+
+		s_instance.reset(new ToolCache(manifestPath, toolsPath, trustedPath));
+	}
+
+	return s_instance.data();
+}
+
+////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////
+
+bool ToolCache::isTrusted(const QString &filePath) const
+{
+	return (!m_trustedFolder.isEmpty()) && QFileInfo(filePath).absolutePath().startsWith(QString("%1/").arg(m_trustedFolder), Qt::CaseInsensitive);
+}
+
+quint32 ToolCache::trustedCount(void)
+{
+	QMutexLocker lock(&m_mutex);
+	return m_statsTrusted;
+}
+
+bool ToolCache::verify(const QString &filePath, const file_id_t &fileId, const QByteArray &expectedHash)
+{
+	if(!isTrusted(filePath))
+	{
+		return false;
+	}
+
+	QMutexLocker lock(&m_mutex);
+
+	QHash<QString, cache_entry_t>::ConstIterator iter = m_entries.constFind(filePath.toLower());
+	if(iter == m_entries.constEnd())
+	{
+		return false;
+	}
+
+	const file_id_t &cachedId = iter->fileId;
+	if((cachedId.fileSize != fileId.fileSize) || (cachedId.fileTime != fileId.fileTime) || (cachedId.volumeId != fileId.volumeId) || (cachedId.fileIndex != fileId.fileIndex) || (_stricmp(iter->hash.constData(), expectedHash.constData()) != 0))
+	{
+		return false;
+	}
+
+	m_statsTrusted++;
+	return true;
+}
+
+void ToolCache::insert(const QString &filePath, const file_id_t &fileId, const QByteArray &hash)
+{
+	QMutexLocker lock(&m_mutex);
+	m_statsVerified++;
+
+	if(!isTrusted(filePath))
+	{
+		return; /*never trusted, so don't keep an entry*/
+	}
+
+	cache_entry_t entry;
+	entry.fileId = fileId;
+	entry.hash = hash;
+
+	m_entries.insert(filePath.toLower(), entry);
+	m_dirty = true;
+}
+
+void ToolCache::flush(void)
+{
+	QMutexLocker lock(&m_mutex);
+
+	if(m_statsTrusted || m_statsVerified)
+	{
+		qDebug("ToolCache: %u file(s) trusted from manifest, %u file(s) verified by hash.", m_statsTrusted, m_statsVerified);
+	}
+	m_statsTrusted = m_statsVerified = 0U;
+
+	if(m_dirty)
+	{
+		//Drop entries of files that do not exist anymore
+		for(QHash<QString, cache_entry_t>::Iterator iter = m_entries.begin(); iter != m_entries.end();)
+		{
+			if(!QFileInfo(iter.key()).isFile())
+			{
+				iter = m_entries.erase(iter);
+				continue;
+			}
+			iter++;
+		}
+		if(save())
+		{
+			m_dirty = false;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////
+
+/*
+ * Removes the tools folders of other builds, files still in use by another instance can not be removed (yet)
+ */
+void ToolCache::removeStaleFolders(const QString &toolsFolder)
+{
+	const QFileInfo toolsInfo(toolsFolder);
+	const QDir parentDir(toolsInfo.absolutePath());
+
+	const QStringList folders = parentDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+	for(QStringList::ConstIterator iter = folders.constBegin(); iter != folders.constEnd(); iter++)
+	{
+		if(iter->compare(toolsInfo.fileName(), Qt::CaseInsensitive) != 0)
+		{
+			qDebug("ToolCache: Removing tools folder of build %s", MUTILS_UTF8(*iter));
+			if(!MUtils::remove_directory(parentDir.absoluteFilePath(*iter), true))
+			{
+				qWarning("ToolCache: Failed to remove tools folder of build %s!", MUTILS_UTF8(*iter));
+			}
+		}
+	}
+}
+
+/*
+ * Elevated processes can write anywhere, so in that case we can not tell whether normal users can write to the folder
+ */
+bool ToolCache::isUserWritable(const QString &folderPath)
+{
+	if(MUtils::OS::user_is_admin())
+	{
+		return true;
+	}
+
+	QFile writeTest(QString("%1/~%2.tmp").arg(folderPath, MUtils::next_rand_str()));
+	if(writeTest.open(QIODevice::WriteOnly))
+	{
+		writeTest.close();
+		writeTest.remove();
+		return true;
+	}
+
+	return false;
+}
+
+void ToolCache::load(void)
+{
+	QFile file(m_manifestFile);
+	if(!file.open(QIODevice::ReadOnly))
+	{
+		qDebug("ToolCache: No existing manifest file found.");
+		return;
+	}
+
+	QByteArray payload, storedChecksum;
+	{
+		QDataStream stream(&file);
+		stream.setVersion(QDataStream::Qt_4_8);
+		stream >> payload >> storedChecksum;
+		if((stream.status() != QDataStream::Ok) || payload.isEmpty() || storedChecksum.isEmpty() || (storedChecksum != checksum(payload)))
+		{
+			qWarning("ToolCache: Manifest checksum is invalid, discarding!");
+			return;
+		}
+	}
+
+	QDataStream stream(payload);
+	stream.setVersion(QDataStream::Qt_4_8);
+
+	QByteArray magic;
+	quint32 version, count;
+	stream >> magic >> version >> count;
+
+	if((stream.status() != QDataStream::Ok) || (magic != MANIFEST_MAGIC) || (version != MANIFEST_VERSION))
+	{
+		qWarning("ToolCache: Manifest file is invalid or outdated, discarding!");
+		return;
+	}
+
+	for(quint32 i = 0; i < count; i++)
+	{
+		QString key;
+		cache_entry_t entry;
+		stream >> key >> entry.fileId.fileSize >> entry.fileId.fileTime >> entry.fileId.volumeId >> entry.fileId.fileIndex >> entry.hash;
+		if(stream.status() != QDataStream::Ok)
+		{
+			qWarning("ToolCache: Manifest file is truncated, discarding!");
+			m_entries.clear();
+			return;
+		}
+		m_entries.insert(key, entry);
+	}
+
+	qDebug("ToolCache: Loaded %d entries.", m_entries.count());
+}
+
+bool ToolCache::save(void)
+{
+	QByteArray payload;
+	{
+		QDataStream stream(&payload, QIODevice::WriteOnly);
+		stream.setVersion(QDataStream::Qt_4_8);
+		stream << QByteArray(MANIFEST_MAGIC) << MANIFEST_VERSION << quint32(m_entries.count());
+		for(QHash<QString, cache_entry_t>::ConstIterator iter = m_entries.constBegin(); iter != m_entries.constEnd(); iter++)
+		{
+			stream << iter.key() << iter->fileId.fileSize << iter->fileId.fileTime << iter->fileId.volumeId << iter->fileId.fileIndex << iter->hash;
+		}
+	}
+
+	const QString tempFile = QString("%1.tmp").arg(m_manifestFile);
+
+	QFile file(tempFile);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		qWarning("ToolCache: Failed to open manifest file for writing!");
+		return false;
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_4_8);
+	stream << payload << checksum(payload);
+
+	file.close();
+	if((stream.status() != QDataStream::Ok) || (file.error() != QFile::NoError))
+	{
+		qWarning("ToolCache: Failed to write manifest file!");
+		QFile::remove(tempFile);
+		return false;
+	}
+
+	//Replace the previous manifest file
+	if(QFileInfo(m_manifestFile).exists() && (!QFile::remove(m_manifestFile)))
+	{
+		qWarning("ToolCache: Failed to remove previous manifest file!");
+		QFile::remove(tempFile);
+		return false;
+	}
+	if(!QFile::rename(tempFile, m_manifestFile))
+	{
+		qWarning("ToolCache: Failed to rename manifest file!");
+		return false;
+	}
+
+	qDebug("ToolCache: Saved %d entries.", m_entries.count());
+	return true;
+}
+
+QByteArray ToolCache::checksum(const QByteArray &payload)
+{
+	QScopedPointer<MUtils::Hash::Hash> hash(MUtils::Hash::create(MUtils::Hash::HASH_KECCAK_384));
+	const QByteArray seed = QByteArray::fromHex(g_seed);
+
+	bool okay[3];
+	okay[0] = hash->update(seed);
+	okay[1] = hash->update(payload);
+	okay[2] = hash->update(seed);
+
+	return (okay[0] && okay[1] && okay[2]) ? hash->digest(true) : QByteArray();
+}
@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QScopedPointer>
+
+////////////////////////////////////////////////////////////
+// Tool Cache
+////////////////////////////////////////////////////////////
+
+/*
+ * Keeps a manifest of all tool binaries that have been verified, identified by size, modification time and file-id.
+ * As long as a (locked) binary still matches its manifest entry, its contents are trusted without rehashing, but only
+ * if it is located in the trusted folder, i.e. the "cache" folder next to the executable, provided that folder is not
+ * writable by normal users. The manifest is protected by a checksum against corruption only, it is *not* a signature.
+ */
+class ToolCache
+{
+public:
+	~ToolCache(void);
+
+	typedef struct
+	{
+		quint64 fileSize;
+		qint64  fileTime;
+		quint32 volumeId;
+		quint64 fileIndex;
+	}
+	file_id_t;
+
+	static ToolCache *instance(void);
+
+	//Persistent folder for extracted tools, empty if not available
+	inline const QString &toolsFolder(void) const { return m_toolsFolder; }
+
+	//Folder where manifest entries are trusted, empty if not available
+	inline const QString &trustedFolder(void) const { return m_trustedFolder; }
+
+	bool isTrusted(const QString &filePath) const;
+	quint32 trustedCount(void);
+
+	bool verify(const QString &filePath, const file_id_t &fileId, const QByteArray &expectedHash);
+	void insert(const QString &filePath, const file_id_t &fileId, const QByteArray &hash);
+	void flush(void);
+
+private:
+	ToolCache(const QString &manifestFile, const QString &toolsFolder, const QString &trustedFolder);
+
+	typedef struct
+	{
+		file_id_t fileId;
+		QByteArray hash;
+	}
+	cache_entry_t;
+
+	void load(void);
+	bool save(void);
+
+	static void removeStaleFolders(const QString &toolsFolder);
+	static bool isUserWritable(const QString &folderPath);
+	static QByteArray checksum(const QByteArray &payload);
+
+	const QString m_manifestFile;
+	const QString m_toolsFolder;
+	const QString m_trustedFolder;
+	QHash<QString, cache_entry_t> m_entries;
+	QMutex m_mutex;
+	bool m_dirty;
+
+	quint32 m_statsTrusted;
+	quint32 m_statsVerified;
+
+	static QMutex s_instanceMutex;
+	static QScopedPointer<ToolCache> s_instance;
+};
@@ -24,6 +24,8 @@
 
 //Internal
 #include "Global.h"
+#include "Tool_PipeSource.h"
+#include "Tool_ProgressMatcher.h"
 
 //MUtils
 #include <MUtils/Global.h>
@@ -38,6 +40,10 @@
 #include <QDir>
 #include <QElapsedTimer>
 
+//CRT
+#include <math.h>
+#include <algorithm>
+
 /*
  * Static Objects
  */
@@ -58,14 +64,28 @@ quint64 AbstractTool::s_referenceCounter = 0ui64;
 /*
  * Const
  */
-static const qint64 START_DELAY = 64i64;	//in milliseconds
+static const size_t READ_BUFFER_SIZE = 4096U;
+static const size_t LINE_BUFFER_SIZE = 1024U;
+
+/*
+ * Spawn scheduler (token bucket)
+ */
+quint32 AbstractTool::s_spawnRate      = 32U;	//in processes per second, zero means unlimited
+quint32 AbstractTool::s_spawnBurst     = 8U;
+double  AbstractTool::s_spawnTokens    = 8.0;
+quint64 AbstractTool::s_spawnCount     = 0ui64;
+qint64  AbstractTool::s_spawnWaitTotal = 0i64;
+qint64  AbstractTool::s_spawnWaitMax   = 0i64;
+qint64  AbstractTool::s_spawnRefillTime = 0i64; //in nanoseconds
+QVector<qint64> AbstractTool::s_spawnWaits;     //in microseconds
 
 /*
  * Constructor
  */
 AbstractTool::AbstractTool(void)
 :
-	m_firstLaunch(true)
+	m_firstLaunch(true),
+	m_inputPipe(NULL)
 
 {
 	QMutexLocker lock(&s_createObjectMutex);
@@ -74,6 +94,7 @@ AbstractTool::AbstractTool(void)
 	{
 		s_jobObjectInstance.reset(new MUtils::JobObject());
 		s_startProcessTimer.reset(new QElapsedTimer());
+		s_spawnTokens = static_cast<double>(s_spawnBurst);
 		if(!MUtils::OS::setup_timer_resolution())
 		{
 			qWarning("Failed to setup system timer resolution!");
@@ -102,25 +123,35 @@ AbstractTool::~AbstractTool(void)
 /*
  * Initialize and launch process object
  */
-bool AbstractTool::startProcess(QProcess &process, const QString &program, const QStringList &args, const QString &workingDir)
+bool AbstractTool::startProcess(QProcess &process, const QString &program, const QStringList &args, const QString &workingDir, const bool mergeChannels)
 {
 	QMutexLocker lock(&s_startProcessMutex);
 	
-	if((!s_startProcessTimer.isNull()) && s_startProcessTimer->isValid())
+	//Wait for a spawn token, the lock is released while sleeping
+	QElapsedTimer waitTimer;
+	waitTimer.start();
+	qint64 delay = 0;
+	while(!takeSpawnToken(delay))
 	{
-		qint64 elapsed = s_startProcessTimer->elapsed();
-		while(elapsed < START_DELAY)
-		{
-			lock.unlock();
-			MUtils::OS::sleep_ms((size_t)(START_DELAY - elapsed));
-			lock.relock();
-			elapsed = s_startProcessTimer->elapsed();
-		}
+		lock.unlock();
+		MUtils::OS::sleep_ms((size_t)delay);
+		lock.relock();
 	}
 
+	const qint64 waitTime = waitTimer.nsecsElapsed();
+	s_spawnCount++;
+	s_spawnWaitTotal += waitTime / 1000000i64;
+	s_spawnWaitMax = qMax(s_spawnWaitMax, waitTime / 1000000i64);
+	s_spawnWaits.append(waitTime / 1000i64);
+
 	emit messageLogged(commandline2string(program, args) + "\n");
 	MUtils::init_process(process, workingDir.isEmpty() ? QFileInfo(program).absolutePath() : workingDir);
 
+	if(!mergeChannels)
+	{
+		process.setProcessChannelMode(QProcess::SeparateChannels);
+	}
+
 	process.start(program, args);
 	
 	if(process.waitForStarted())
@@ -141,7 +172,6 @@ bool AbstractTool::startProcess(QProcess &process, const QString &program, const
 			m_firstLaunch = false;
 		}
 		
-		s_startProcessTimer->start();
 		return true;
 	}
 
@@ -152,7 +182,93 @@ bool AbstractTool::startProcess(QProcess &process, const QString &program, const
 	process.kill();
 	process.waitForFinished(-1);
 
-	s_startProcessTimer->start();
+	return false;
+}
+
+/*
+ * Configure the spawn scheduler
+ */
+void AbstractTool::setSpawnRate(const quint32 &rate, const quint32 &burst)
+{
+	QMutexLocker lock(&s_startProcessMutex);
+	s_spawnRate = rate;
+	s_spawnBurst = qMax(1U, burst);
+	s_spawnTokens = qMin(s_spawnTokens, static_cast<double>(s_spawnBurst));
+}
+
+/*
+ * Query the time spent waiting for a spawn token
+ */
+void AbstractTool::spawnStatistics(quint64 &count, qint64 &totalWait, qint64 &maxWait)
+{
+	QMutexLocker lock(&s_startProcessMutex);
+	count = s_spawnCount;
+	totalWait = s_spawnWaitTotal;
+	maxWait = s_spawnWaitMax;
+}
+
+/*
+ * Query the distribution of the time spent waiting for a spawn token (in milliseconds)
+ */
+void AbstractTool::spawnPercentiles(double &p50, double &p95, double &p99)
+{
+	QVector<qint64> waits;
+	{
+		QMutexLocker lock(&s_startProcessMutex);
+		waits = s_spawnWaits;
+	}
+
+	p50 = p95 = p99 = 0.0;
+	if(!waits.isEmpty())
+	{
+		std::sort(waits.begin(), waits.end());
+		const int last = waits.count() - 1;
+		p50 = static_cast<double>(waits[(last * 50) / 100]) / 1000.0;
+		p95 = static_cast<double>(waits[(last * 95) / 100]) / 1000.0;
+		p99 = static_cast<double>(waits[(last * 99) / 100]) / 1000.0;
+	}
+}
+
+void AbstractTool::resetSpawnStatistics(void)
+{
+	QMutexLocker lock(&s_startProcessMutex);
+	s_spawnCount = 0ui64;
+	s_spawnWaitTotal = s_spawnWaitMax = 0i64;
+	s_spawnWaits.clear();
+}
+
+/*
+ * Take a token from the bucket or compute the delay until the next token is available (caller must hold the mutex!)
+ */
+bool AbstractTool::takeSpawnToken(qint64 &delay)
+{
+	if(s_spawnRate < 1U)
+	{
+		return true; /*unlimited*/
+	}
+
+	//The timer keeps running, so no fraction of the elapsed time is lost between two refills
+	const double burst = static_cast<double>(s_spawnBurst);
+	if((!s_startProcessTimer.isNull()) && s_startProcessTimer->isValid())
+	{
+		const qint64 now = s_startProcessTimer->nsecsElapsed();
+		s_spawnTokens = qMin(burst, s_spawnTokens + ((static_cast<double>(now - s_spawnRefillTime) * static_cast<double>(s_spawnRate)) / 1000000000.0));
+		s_spawnRefillTime = now;
+	}
+	else
+	{
+		s_spawnTokens = burst;
+		s_spawnRefillTime = 0i64;
+		if(!s_startProcessTimer.isNull()) s_startProcessTimer->start();
+	}
+
+	if(s_spawnTokens >= 1.0)
+	{
+		s_spawnTokens -= 1.0;
+		return true;
+	}
+
+	delay = qMax(1i64, static_cast<qint64>(ceil(((1.0 - s_spawnTokens) * 1000.0) / static_cast<double>(s_spawnRate))));
 	return false;
 }
 
@@ -161,18 +277,43 @@ bool AbstractTool::startProcess(QProcess &process, const QString &program, const
 */
 AbstractTool::result_t AbstractTool::awaitProcess(QProcess &process, QAtomicInt &abortFlag, int *const exitCode)
 {
-	return awaitProcess(process, abortFlag, [](const QString& /*text*/) { return false; }, exitCode);
+	return awaitProcess(process, abortFlag, NULL, [](const QString& /*text*/) { return false; }, exitCode);
 }
 
 /*
 * Wait for process to terminate while processing its output
 */
 AbstractTool::result_t AbstractTool::awaitProcess(QProcess &process, QAtomicInt &abortFlag, std::function<bool(const QString &text)> &&handler, int *const exitCode)
+{
+	return awaitProcess(process, abortFlag, NULL, handler, exitCode);
+}
+
+/*
+* Wait for process to terminate while tracking its progress (lines that match are handled on the raw bytes and are *not* logged)
+*/
+AbstractTool::result_t AbstractTool::awaitProcess(QProcess &process, QAtomicInt &abortFlag, const ProgressMatcher &matcher, int *const exitCode)
+{
+	return awaitProcess(process, abortFlag, &matcher, [](const QString& /*text*/) { return false; }, exitCode);
+}
+
+/*
+* Wait for process to terminate while processing its output
+*/
+AbstractTool::result_t AbstractTool::awaitProcess(QProcess &process, QAtomicInt &abortFlag, const ProgressMatcher *const matcher, const std::function<bool(const QString &text)> &handler, int *const exitCode)
 {
 	bool bTimeout = false;
 	bool bAborted = false;
 
 	QString lastText;
+	int prevProgress = -1;
+
+	char buffer[READ_BUFFER_SIZE];
+	char line[LINE_BUFFER_SIZE];
+	size_t lineLength = 0;
+
+	bool bPipeActive = (m_inputPipe != NULL);
+	QElapsedTimer idleTimer;
+	idleTimer.start();
 
 	while (process.state() != QProcess::NotRunning)
 	{
@@ -184,8 +325,32 @@ AbstractTool::result_t AbstractTool::awaitProcess(QProcess &process, QAtomicInt
 			break;
 		}
 
-		process.waitForReadyRead(m_processTimeoutInterval);
-		if (!process.bytesAvailable() && process.state() == QProcess::Running)
+		if (bPipeActive)
+		{
+			//Feed the next chunk of audio data into the process' stdin
+			const qint64 bytesFed = m_inputPipe->feed(process);
+			if (bytesFed < 0)
+			{
+				process.closeWriteChannel();
+				bPipeActive = false;
+			}
+			if (bytesFed != 0)
+			{
+				idleTimer.restart();
+			}
+			process.waitForReadyRead(0);
+		}
+		else
+		{
+			process.waitForReadyRead(m_inputPipe ? 250 : m_processTimeoutInterval);
+		}
+
+		if (process.bytesAvailable() > 0)
+		{
+			idleTimer.restart();
+		}
+
+		if (!process.bytesAvailable() && process.state() == QProcess::Running && ((!m_inputPipe) || (idleTimer.elapsed() >= m_processTimeoutInterval)))
 		{
 			process.kill();
 			qWarning("Tool process timed out <-- killing!");
@@ -194,27 +359,33 @@ AbstractTool::result_t AbstractTool::awaitProcess(QProcess &process, QAtomicInt
 			break;
 		}
 
+		//Split the output into lines on the raw bytes, using a fixed-size buffer
 		while (process.bytesAvailable() > 0)
 		{
-			QByteArray line = process.readLine();
-			if (line.size() > 0)
+			const qint64 bytesRead = process.read(buffer, READ_BUFFER_SIZE);
+			if (bytesRead <= 0)
 			{
-				line.replace('\r', char(0x20)).replace('\b', char(0x20)).replace('\t', char(0x20));
-				const QString text = QString::fromUtf8(line.constData()).simplified();
-				if (!text.isEmpty())
+				break;
+			}
+			for (qint64 i = 0; i < bytesRead; ++i)
+			{
+				const char c = buffer[i];
+				if ((c == '\n') || (c == '\r') || (c == '\b') || (lineLength >= LINE_BUFFER_SIZE))
 				{
-					if (!handler(text))
+					processLine(line, lineLength, matcher, handler, prevProgress, lastText);
+					lineLength = 0;
+					if ((c == '\n') || (c == '\r') || (c == '\b'))
 					{
-						if (text.compare(lastText, Qt::CaseInsensitive) != 0)
-						{
-							emit messageLogged(lastText = text);
-						}
+						continue;
 					}
 				}
+				line[lineLength++] = c;
 			}
 		}
 	}
 
+	processLine(line, lineLength, matcher, handler, prevProgress, lastText);
+
 	process.waitForFinished();
 	if (process.state() != QProcess::NotRunning)
 	{
@@ -238,6 +409,40 @@ AbstractTool::result_t AbstractTool::awaitProcess(QProcess &process, QAtomicInt
 	return RESULT_SUCCESS;
 }
 
+/*
+ * Handle a single line of output, only lines that go to the log are converted to a string
+ */
+void AbstractTool::processLine(const char *const data, const size_t &length, const ProgressMatcher *const matcher, const std::function<bool(const QString &text)> &handler, int &prevProgress, QString &lastText)
+{
+	if (length < 1)
+	{
+		return;
+	}
+
+	qint32 newProgress;
+	if (matcher && matcher->match(data, length, newProgress))
+	{
+		if (newProgress > prevProgress)
+		{
+			emit statusUpdated(newProgress);
+			prevProgress = NEXT_PROGRESS(newProgress);
+		}
+		return;
+	}
+
+	const QString text = QString::fromUtf8(data, static_cast<int>(length)).simplified();
+	if (!text.isEmpty())
+	{
+		if (!handler(text))
+		{
+			if (text.compare(lastText, Qt::CaseInsensitive) != 0)
+			{
+				emit messageLogged(lastText = text);
+			}
+		}
+	}
+}
+
 /*
  * Convert program arguments to single string
  */
@@ -24,11 +24,14 @@
 
 #include <MUtils\Global.h>
 #include <QObject>
+#include <QVector>
 #include <functional>
 
 class QMutex;
 class QProcess;
 class QElapsedTimer;
+class PipeSource;
+class ProgressMatcher;
 
 namespace MUtils
 {
@@ -42,6 +45,13 @@ class AbstractTool : public QObject
 public:
 	AbstractTool(void);
 	~AbstractTool(void);
+
+	void setInputPipe(PipeSource *const inputPipe) { m_inputPipe = inputPipe; }
+
+	static void setSpawnRate(const quint32 &rate, const quint32 &burst);
+	static void spawnStatistics(quint64 &count, qint64 &totalWait, qint64 &maxWait);
+	static void spawnPercentiles(double &p50, double &p95, double &p99);
+	static void resetSpawnStatistics(void);
 	
 signals:
 	void statusUpdated(int progress);
@@ -71,9 +81,10 @@ protected:
 
 	static QString commandline2string(const QString &program, const QStringList &arguments);
 
-	bool startProcess(QProcess &process, const QString &program, const QStringList &args, const QString &workingDir = QString());
+	bool startProcess(QProcess &process, const QString &program, const QStringList &args, const QString &workingDir = QString(), const bool mergeChannels = true);
 	result_t awaitProcess(QProcess &process, QAtomicInt &abortFlag, int *const exitCode = NULL);
 	result_t awaitProcess(QProcess &process, QAtomicInt &abortFlag, std::function<bool(const QString &text)> &&handler, int *const exitCode = NULL);
+	result_t awaitProcess(QProcess &process, QAtomicInt &abortFlag, const ProgressMatcher &matcher, int *const exitCode = NULL);
 
 private:
 	static QScopedPointer<MUtils::JobObject> s_jobObjectInstance;
@@ -84,5 +95,20 @@ private:
 
 	static quint64 s_referenceCounter;
 
+	static quint32 s_spawnRate;
+	static quint32 s_spawnBurst;
+	static double  s_spawnTokens;
+	static quint64 s_spawnCount;
+	static qint64  s_spawnWaitTotal;
+	static qint64  s_spawnWaitMax;
+	static qint64  s_spawnRefillTime;
+	static QVector<qint64> s_spawnWaits;
+
+	static bool takeSpawnToken(qint64 &delay);
+
+	result_t awaitProcess(QProcess &process, QAtomicInt &abortFlag, const ProgressMatcher *const matcher, const std::function<bool(const QString &text)> &handler, int *const exitCode);
+	void processLine(const char *const data, const size_t &length, const ProgressMatcher *const matcher, const std::function<bool(const QString &text)> &handler, int &prevProgress, QString &lastText);
+
 	bool m_firstLaunch;
+	PipeSource *m_inputPipe;
 };
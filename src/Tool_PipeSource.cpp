@@ -0,0 +1,331 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+#include "Tool_PipeSource.h"
+
+//Internal
+#include "Global.h"
+#include "Tool_WaveSlicer.h"
+
+//Qt
+#include <QDir>
+#include <QProcess>
+
+/*
+ * Const
+ */
+static const qint64 CHUNK_SIZE  = 65536i64;   //maximum number of bytes transferred per call
+static const qint64 MAX_PENDING = 1048576i64; //maximum number of bytes buffered for the sink
+
+/*
+ * Constructor
+ */
+PipeSource::PipeSource(const QString &workingDir)
+:
+	m_workingDir(workingDir),
+	m_slicer(NULL),
+	m_sliceActive(false),
+	m_sliceFailed(false),
+	m_expectedSize(0),
+	m_bytesTransferred(0),
+	m_progress(-1)
+{
+}
+
+/*
+ * Destructor
+ */
+PipeSource::~PipeSource(void)
+{
+	if((!m_processes.isEmpty()) || m_sliceActive)
+	{
+		close(true);
+	}
+}
+
+/*
+ * Set file to be fed into the first stage (optional)
+ */
+void PipeSource::setInputFile(const QString &sourceFile)
+{
+	m_sourceFile = sourceFile;
+}
+
+/*
+ * Set a range of a Wave file to be fed into the first stage or, if there are no stages, into the sink (optional)
+ */
+void PipeSource::setInputSlice(WaveSlicer *const slicer)
+{
+	m_slicer = slicer;
+}
+
+/*
+ * Append a stage to the pipeline, each stage reads from its predecessor
+ */
+void PipeSource::addStage(const QString &program, const QStringList &args)
+{
+	stage_t stage;
+	stage.program = program;
+	stage.args = args;
+	m_stages << stage;
+}
+
+/*
+ * Connect and launch all stages of the pipeline
+ */
+bool PipeSource::start(void)
+{
+	if((m_stages.isEmpty() && (!m_slicer)) || (!m_processes.isEmpty()) || m_sliceActive)
+	{
+		return false;
+	}
+
+	if(m_slicer)
+	{
+		if(!m_slicer->open())
+		{
+			return false;
+		}
+		m_sliceActive = true;
+		m_sliceFailed = false;
+	}
+
+	for(int i = 0; i < m_stages.count(); i++)
+	{
+		m_processes << new QProcess();
+	}
+
+	//Connections must be established *before* any of the processes is started
+	for(int i = 1; i < m_processes.count(); i++)
+	{
+		m_processes.at(i-1)->setStandardOutputProcess(m_processes.at(i));
+	}
+
+	if((!m_sourceFile.isEmpty()) && (!m_slicer) && (!m_processes.isEmpty()))
+	{
+		m_processes.first()->setStandardInputFile(QDir::toNativeSeparators(m_sourceFile));
+	}
+
+	for(int i = 0; i < m_processes.count(); i++)
+	{
+		if(!startProcess(*m_processes.at(i), m_stages.at(i).program, m_stages.at(i).args, m_workingDir, false))
+		{
+			close(true);
+			return false;
+		}
+		if(i < m_processes.count() - 1)
+		{
+			m_processes.at(i)->setReadChannel(QProcess::StandardError); //stdout is connected to the next stage
+		}
+	}
+
+	m_bytesTransferred = 0;
+	m_progress = -1;
+	return true;
+}
+
+/*
+ * Transfer the next chunk of data to the sink, returns -1 at end of stream
+ */
+qint64 PipeSource::feed(QProcess &sink)
+{
+	if(m_processes.isEmpty() && (!m_sliceActive))
+	{
+		return -1;
+	}
+
+	if(sink.bytesToWrite() >= MAX_PENDING)
+	{
+		sink.waitForBytesWritten(25);
+		return 0;
+	}
+
+	QByteArray data;
+
+	//Without any stages, the slice goes to the sink directly
+	if(m_processes.isEmpty())
+	{
+		const qint64 bytesRead = readSlice(data);
+		if(bytesRead < 1)
+		{
+			return -1;
+		}
+		sink.write(data);
+		updateProgress(bytesRead);
+		return bytesRead;
+	}
+
+	//Otherwise, pump the slice into the first stage
+	if(m_sliceActive)
+	{
+		QProcess *const first = m_processes.first();
+		if(first->bytesToWrite() < MAX_PENDING)
+		{
+			if(readSlice(data) > 0)
+			{
+				first->write(data);
+			}
+			else
+			{
+				first->closeWriteChannel();
+			}
+		}
+		first->waitForBytesWritten(0);
+	}
+
+	for(QList<QProcess*>::ConstIterator iter = m_processes.constBegin(); iter != m_processes.constEnd(); iter++)
+	{
+		if((*iter) != m_processes.last())
+		{
+			(*iter)->waitForReadyRead(0);
+		}
+		readErrors(*iter, false);
+	}
+
+	QProcess *const source = m_processes.last();
+	if(source->bytesAvailable() < 1)
+	{
+		if(source->state() == QProcess::NotRunning)
+		{
+			return -1;
+		}
+		source->waitForReadyRead(25);
+	}
+
+	data = source->read(CHUNK_SIZE);
+	if(data.isEmpty())
+	{
+		return 0;
+	}
+
+	sink.write(data);
+	updateProgress(data.size());
+
+	return data.size();
+}
+
+/*
+ * Wait for all stages to terminate (or kill them), returns true if all stages succeeded
+ */
+bool PipeSource::close(const bool &kill)
+{
+	bool success = (!m_processes.isEmpty()) || (m_slicer != NULL);
+
+	while(!m_processes.isEmpty())
+	{
+		QScopedPointer<QProcess> process(m_processes.takeFirst());
+		if(process->state() != QProcess::NotRunning)
+		{
+			if(kill || (!process->waitForFinished(m_processTimeoutInterval)))
+			{
+				if(!kill)
+				{
+					qWarning("Pipe process timed out <-- killing!");
+					emit messageLogged("\nPROCESS TIMEOUT !!!");
+				}
+				process->kill();
+				process->waitForFinished(-1);
+				success = false;
+			}
+		}
+
+		readErrors(process.data(), true);
+		emit messageLogged(QString().sprintf("\nExited with code: 0x%04X", process->exitCode()));
+		if((process->exitStatus() != QProcess::NormalExit) || (process->exitCode() != EXIT_SUCCESS))
+		{
+			success = false;
+		}
+	}
+
+	//The slice must have been transferred completely
+	if(m_sliceActive)
+	{
+		m_slicer->close();
+		m_sliceActive = false;
+		success = false;
+	}
+	if(m_sliceFailed)
+	{
+		success = false;
+	}
+
+	return success;
+}
+
+/*
+ * Read the next chunk of the slice, the slice is closed at the end or on error
+ */
+qint64 PipeSource::readSlice(QByteArray &buffer)
+{
+	buffer.resize(static_cast<int>(CHUNK_SIZE));
+	const qint64 bytesRead = m_slicer->read(buffer.data(), CHUNK_SIZE);
+
+	if(bytesRead < 1)
+	{
+		m_sliceFailed = (bytesRead < 0);
+		m_sliceActive = false;
+		m_slicer->close();
+		buffer.clear();
+		return bytesRead;
+	}
+
+	buffer.resize(static_cast<int>(bytesRead));
+	return bytesRead;
+}
+
+/*
+ * Account for the bytes that have been fed to the sink and report the progress
+ */
+void PipeSource::updateProgress(const qint64 &bytesFed)
+{
+	m_bytesTransferred += bytesFed;
+
+	if(m_expectedSize > 0)
+	{
+		const int progress = static_cast<int>(qMin(m_bytesTransferred * 100ui64 / m_expectedSize, 99ui64));
+		if(progress > m_progress)
+		{
+			emit statusUpdated(m_progress = progress);
+		}
+	}
+}
+
+/*
+ * Forward the diagnostic output (stderr) of a stage to the log
+ */
+void PipeSource::readErrors(QProcess *const process, const bool &flush)
+{
+	const QProcess::ProcessChannel channel = process->readChannel();
+	process->setReadChannel(QProcess::StandardError);
+
+	while(process->canReadLine() || (flush && (process->bytesAvailable() > 0)))
+	{
+		QByteArray line = process->readLine();
+		line.replace('\r', char(0x20)).replace('\b', char(0x20)).replace('\t', char(0x20));
+		const QString text = QString::fromUtf8(line.constData()).simplified();
+		if((!text.isEmpty()) && (text.compare(m_lastText, Qt::CaseInsensitive) != 0))
+		{
+			emit messageLogged(m_lastText = text);
+		}
+	}
+
+	process->setReadChannel(channel);
+}
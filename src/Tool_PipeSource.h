@@ -0,0 +1,74 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Tool_Abstract.h"
+
+#include <QStringList>
+
+class WaveSlicer;
+
+class PipeSource : public AbstractTool
+{
+	Q_OBJECT
+
+public:
+	PipeSource(const QString &workingDir);
+	~PipeSource(void);
+
+	void setInputFile(const QString &sourceFile);
+	void setInputSlice(WaveSlicer *const slicer);
+	void addStage(const QString &program, const QStringList &args);
+	void setExpectedSize(const quint64 &expectedSize) { m_expectedSize = expectedSize; }
+
+	bool start(void);
+	qint64 feed(QProcess &sink);
+	bool close(const bool &kill);
+
+	quint64 bytesTransferred(void) const { return m_bytesTransferred; }
+
+private:
+	void readErrors(QProcess *const process, const bool &flush);
+	qint64 readSlice(QByteArray &buffer);
+	void updateProgress(const qint64 &bytesFed);
+
+	typedef struct
+	{
+		QString program;
+		QStringList args;
+	}
+	stage_t;
+
+	const QString m_workingDir;
+
+	QString m_sourceFile;
+	WaveSlicer *m_slicer;
+	bool m_sliceActive;
+	bool m_sliceFailed;
+	QList<stage_t> m_stages;
+	QList<QProcess*> m_processes;
+
+	quint64 m_expectedSize;
+	quint64 m_bytesTransferred;
+	int m_progress;
+	QString m_lastText;
+};
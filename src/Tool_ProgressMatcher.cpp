@@ -0,0 +1,154 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Tool_ProgressMatcher.h"
+
+//CRT
+#include <string.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+///////////////////////////////////////////////////////////////////////////////
+
+ProgressMatcher::ProgressMatcher(const char *const prefix, const char *const suffix)
+:
+	m_prefix(prefix),
+	m_suffix(suffix),
+	m_prefixLen(strlen(prefix)),
+	m_suffixLen(strlen(suffix))
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public Functions
+///////////////////////////////////////////////////////////////////////////////
+
+bool ProgressMatcher::match(const char *const data, const size_t &length, qint32 &progress) const
+{
+	//Scan backwards, so that the *last* progress indicator wins
+	for(size_t pos = length; pos > 0; --pos)
+	{
+		const size_t percentPos = pos - 1;
+		if(data[percentPos] != '%')
+		{
+			continue;
+		}
+
+		//Parse the number preceding the percent sign
+		size_t numberPos = percentPos;
+		while((numberPos > 0) && IS_DIGIT(data[numberPos - 1]))
+		{
+			--numberPos;
+		}
+		if(numberPos == percentPos)
+		{
+			continue; /*no digits*/
+		}
+
+		size_t integerEnd = percentPos;
+		if((numberPos > 1) && ((data[numberPos - 1] == '.') || (data[numberPos - 1] == ',')) && IS_DIGIT(data[numberPos - 2]))
+		{
+			integerEnd = --numberPos;
+			while((numberPos > 0) && IS_DIGIT(data[numberPos - 1]))
+			{
+				--numberPos;
+			}
+		}
+		if((integerEnd - numberPos) > 3)
+		{
+			continue; /*not a percentage*/
+		}
+
+		if(matchPrefix(data, numberPos) && matchSuffix(data, length, percentPos + 1))
+		{
+			qint32 value = 0;
+			for(size_t i = numberPos; i < integerEnd; ++i)
+			{
+				value = (value * 10) + (data[i] - '0');
+			}
+			progress = qBound(0, value, 100);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Private Functions
+///////////////////////////////////////////////////////////////////////////////
+
+bool ProgressMatcher::matchPrefix(const char *const data, const size_t &numberPos) const
+{
+	if(m_prefixLen < 1)
+	{
+		return (numberPos < 1) || (!IS_ALNUM(data[numberPos - 1]));
+	}
+
+	size_t pos = numberPos;
+	while((pos > 0) && IS_SPACE(data[pos - 1]))
+	{
+		--pos;
+	}
+	if(pos < m_prefixLen)
+	{
+		return false;
+	}
+
+	const char *const prefix = data + (pos - m_prefixLen);
+	for(size_t i = 0; i < m_prefixLen; ++i)
+	{
+		if(TO_LOWER(prefix[i]) != TO_LOWER(m_prefix[i]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool ProgressMatcher::matchSuffix(const char *const data, const size_t &length, const size_t &suffixPos) const
+{
+	size_t pos = suffixPos;
+	for(size_t i = 0; i < m_suffixLen; ++i)
+	{
+		if(m_suffix[i] == ' ')
+		{
+			if((pos >= length) || (!IS_SPACE(data[pos])))
+			{
+				return false;
+			}
+			while((pos < length) && IS_SPACE(data[pos]))
+			{
+				++pos;
+			}
+			continue;
+		}
+		if((pos >= length) || (TO_LOWER(data[pos]) != TO_LOWER(m_suffix[i])))
+		{
+			return false;
+		}
+		++pos;
+	}
+
+	return true;
+}
@@ -0,0 +1,56 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <QtGlobal>
+
+///////////////////////////////////////////////////////////////////////////////
+// Progress Matcher
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Finds the last "<prefix> N[.M]%<suffix>" in a chunk of raw tool output, without allocating any memory.
+ * Whitespace between the prefix and the number is skipped, a blank in the suffix matches any amount of whitespace.
+ * If the prefix is empty, the number must start at a word boundary. Prefix and suffix are compared case-insensitive.
+ */
+class ProgressMatcher
+{
+public:
+	explicit ProgressMatcher(const char *const prefix, const char *const suffix = "");
+
+	bool match(const char *const data, const size_t &length, qint32 &progress) const;
+
+private:
+	bool matchPrefix(const char *const data, const size_t &numberPos) const;
+	bool matchSuffix(const char *const data, const size_t &length, const size_t &suffixPos) const;
+
+	static __forceinline bool IS_DIGIT(const char c) { return (c >= '0') && (c <= '9'); }
+	static __forceinline bool IS_SPACE(const char c) { return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n') || (c == '\b'); }
+	static __forceinline bool IS_ALNUM(const char c) { return IS_DIGIT(c) || ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')); }
+	static __forceinline char TO_LOWER(const char c) { return ((c >= 'A') && (c <= 'Z')) ? (c + ('a' - 'A')) : c; }
+
+	const char *const m_prefix;
+	const char *const m_suffix;
+	const size_t m_prefixLen;
+	const size_t m_suffixLen;
+};
@@ -31,8 +31,40 @@
 
 //Qt
 #include <QDir>
+#include <QFile>
 #include <QProcess>
 
+//CRT
+#include <string.h>
+
+////////////////////////////////////////////////////////////
+// Helper Macros
+////////////////////////////////////////////////////////////
+
+#define BYTE_AT(PTR, IDX) (static_cast<quint32>(reinterpret_cast<const uchar*>((PTR))[(IDX)]))
+
+static inline quint32 RD_LE16(const char *const p) { return BYTE_AT(p, 0) | (BYTE_AT(p, 1) << 8); }
+static inline quint32 RD_LE32(const char *const p) { return BYTE_AT(p, 0) | (BYTE_AT(p, 1) << 8) | (BYTE_AT(p, 2) << 16) | (BYTE_AT(p, 3) << 24); }
+static inline quint64 RD_LE64(const char *const p) { return quint64(RD_LE32(p)) | (quint64(RD_LE32(p + 4)) << 32); }
+
+////////////////////////////////////////////////////////////
+// Constants
+////////////////////////////////////////////////////////////
+
+static const int MAX_CHUNKS = 64;
+
+static const quint64 RIFF_SIZE_LIMIT = 4294967296ui64 - 65536ui64; //leave some room for the header and trailing chunks
+
+static const quint32 WAVE_FORMAT_PCM        = 0x0001;
+static const quint32 WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+static const quint32 WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+//Sony Wave64 chunk GUIDs
+static const char W64_GUID_RIFF[16] = { 'r', 'i', 'f', 'f', '\x2E', '\x91', '\xCF', '\x11', '\xA5', '\xD6', '\x28', '\xDB', '\x04', '\xC1', '\x00', '\x00' };
+static const char W64_GUID_WAVE[16] = { 'w', 'a', 'v', 'e', '\xF3', '\xAC', '\xD3', '\x11', '\x8C', '\xD1', '\x00', '\xC0', '\x4F', '\x8E', '\xDB', '\x8A' };
+static const char W64_GUID_FMT [16] = { 'f', 'm', 't', ' ', '\xF3', '\xAC', '\xD3', '\x11', '\x8C', '\xD1', '\x00', '\xC0', '\x4F', '\x8E', '\xDB', '\x8A' };
+static const char W64_GUID_DATA[16] = { 'd', 'a', 't', 'a', '\xF3', '\xAC', '\xD3', '\x11', '\x8C', '\xD1', '\x00', '\xC0', '\x4F', '\x8E', '\xDB', '\x8A' };
+
 WaveProperties::WaveProperties(void)
 :
 	m_binary(lamexp_tools_lookup("sox.exe"))
@@ -48,6 +80,177 @@ WaveProperties::~WaveProperties(void)
 }
 
 bool WaveProperties::detect(const QString &sourceFile, AudioFileModel_TechInfo *info, QAtomicInt &abortFlag)
+{
+	//Try to read the Wave header directly first, this is exact and avoids a process launch
+	QString details;
+	if(parseHeader(sourceFile, info, &details))
+	{
+		emit messageLogged(details);
+		emit statusUpdated(100);
+		return true;
+	}
+
+	emit messageLogged(tr("Wave header could not be parsed, falling back to SoX!") + "\n");
+	return detectSoX(sourceFile, info, abortFlag);
+}
+
+/*
+ * Parses the header of a RIFF/WAVE, RF64 (or BW64) and Sony Wave64 file. Only uncompressed PCM and IEEE Float
+ * formats are accepted, including WAVE_FORMAT_EXTENSIBLE. If the size of the "data" chunk is not known (e.g. the
+ * file was written to a pipe) or it has been truncated to 32-Bit, the size is derived from the actual file size.
+ */
+bool WaveProperties::parseHeader(const QString &sourceFile, AudioFileModel_TechInfo *info, QString *const details, layout_t *const layout)
+{
+	QFile file(sourceFile);
+	if(!file.open(QIODevice::ReadOnly))
+	{
+		return false;
+	}
+
+	const quint64 fileSize = static_cast<quint64>(file.size());
+	char header[40];
+	if(file.read(header, 40) != 40)
+	{
+		return false;
+	}
+
+	//Detect the container type
+	const bool isW64 = (memcmp(header, W64_GUID_RIFF, 16) == 0) && (memcmp(header + 24, W64_GUID_WAVE, 16) == 0);
+	const bool isRF64 = ((memcmp(header, "RF64", 4) == 0) || (memcmp(header, "BW64", 4) == 0)) && (memcmp(header + 8, "WAVE", 4) == 0);
+	const bool isRIFF = (memcmp(header, "RIFF", 4) == 0) && (memcmp(header + 8, "WAVE", 4) == 0);
+	if(!(isW64 || isRF64 || isRIFF))
+	{
+		return false;
+	}
+
+	quint32 formatTag = 0, channels = 0, sampleRate = 0, blockAlign = 0, bitsPerSample = 0, validBits = 0;
+	quint64 dataSize = 0, dataOffset = 0, ds64DataSize = 0;
+	bool haveFormat = false, haveData = false;
+	QByteArray format;
+
+	//Walk through the chunks
+	quint64 pos = isW64 ? 40 : 12;
+	for(int i = 0; (i < MAX_CHUNKS) && (!haveData); i++)
+	{
+		const quint64 headerSize = isW64 ? 24 : 8;
+		if((pos + headerSize > fileSize) || (!file.seek(pos)) || (file.read(header, headerSize) != static_cast<qint64>(headerSize)))
+		{
+			break;
+		}
+
+		const quint64 chunkSize = isW64 ? (RD_LE64(header + 16) - qMin(RD_LE64(header + 16), headerSize)) : RD_LE32(header + 4);
+		const bool isFormat = isW64 ? (memcmp(header, W64_GUID_FMT, 16) == 0) : (memcmp(header, "fmt ", 4) == 0);
+		const bool isData = isW64 ? (memcmp(header, W64_GUID_DATA, 16) == 0) : (memcmp(header, "data", 4) == 0);
+
+		if(isFormat)
+		{
+			format = file.read(qMin(chunkSize, 40ui64));
+			if(format.size() < 16)
+			{
+				return false;
+			}
+			formatTag = RD_LE16(format.constData());
+			channels = RD_LE16(format.constData() + 2);
+			sampleRate = RD_LE32(format.constData() + 4);
+			blockAlign = RD_LE16(format.constData() + 12);
+			bitsPerSample = validBits = RD_LE16(format.constData() + 14);
+			if(formatTag == WAVE_FORMAT_EXTENSIBLE)
+			{
+				if(format.size() < 40)
+				{
+					return false;
+				}
+				if(const quint32 tmp = RD_LE16(format.constData() + 18))
+				{
+					validBits = qMin(tmp, bitsPerSample);
+				}
+				formatTag = RD_LE16(format.constData() + 24); /*first two bytes of the sub-format GUID*/
+			}
+			haveFormat = true;
+		}
+		else if(isRF64 && (!isW64) && (memcmp(header, "ds64", 4) == 0))
+		{
+			char ds64[16];
+			if((chunkSize < 16) || (file.read(ds64, 16) != 16))
+			{
+				return false;
+			}
+			ds64DataSize = RD_LE64(ds64 + 8);
+		}
+		else if(isData)
+		{
+			dataOffset = pos + headerSize;
+			dataSize = ((isRF64 && (chunkSize == 0xFFFFFFFFui64)) ? ds64DataSize : chunkSize);
+			haveData = true;
+		}
+
+		pos += headerSize + chunkSize;
+		pos += isW64 ? ((8 - (pos & 7)) & 7) : (pos & 1);
+	}
+
+	if((!haveFormat) || (!haveData) || (channels == 0) || (sampleRate == 0) || (blockAlign == 0) || (bitsPerSample == 0))
+	{
+		return false;
+	}
+	if(!((formatTag == WAVE_FORMAT_PCM) || ((formatTag == WAVE_FORMAT_IEEE_FLOAT) && ((bitsPerSample == 32) || (bitsPerSample == 64)))))
+	{
+		return false; /*compressed or unusual format*/
+	}
+
+	//Fix the data size, if it is unknown or has overflowed
+	const quint64 available = (fileSize > dataOffset) ? (fileSize - dataOffset) : 0;
+	if((dataSize == 0) || (dataSize == 0xFFFFFFFFui64) || (dataSize > available) || (isRIFF && (available > 0xFFFFFFFFui64)))
+	{
+		dataSize = available;
+	}
+
+	const quint64 sampleFrames = dataSize / blockAlign;
+	const bool isFloat = (formatTag == WAVE_FORMAT_IEEE_FLOAT);
+
+	info->setAudioChannels(channels);
+	info->setAudioSamplerate(sampleRate);
+	info->setAudioBitdepth((isFloat && (bitsPerSample == 32)) ? AudioFileModel::BITDEPTH_IEEE_FLOAT32 : validBits);
+	info->setDuration(static_cast<unsigned int>((sampleFrames + (sampleRate / 2U)) / sampleRate));
+
+	if(details)
+	{
+		*details = QString("%1: %2 channel(s), %3 Hz, %4-Bit %5, %6 sample frames\n").arg(QString::fromLatin1(isW64 ? "Wave64" : (isRF64 ? "RF64" : "RIFF")), QString::number(channels), QString::number(sampleRate), QString::number(validBits), QString::fromLatin1(isFloat ? "Float" : "PCM"), QString::number(sampleFrames));
+	}
+
+	if(layout)
+	{
+		layout->format = format;
+		layout->dataOffset = dataOffset;
+		layout->dataSize = sampleFrames * blockAlign;
+		layout->blockAlign = blockAlign;
+		layout->sampleRate = sampleRate;
+	}
+
+	return true;
+}
+
+/*
+ * Computes the expected size of the PCM data from the format info, returns zero if the bit depth (e.g. of a lossy format)
+ * or any other property is unknown, in which case only the actual size of the decoded file can tell
+ */
+quint64 WaveProperties::expectedSize(const AudioFileModel_TechInfo &info)
+{
+	const unsigned int bitdepth = info.audioBitdepth();
+	if((bitdepth == 0) || (info.duration() == 0) || (info.audioSamplerate() == 0) || (info.audioChannels() == 0))
+	{
+		return 0;
+	}
+
+	const quint64 bytesPerSample = (bitdepth == AudioFileModel::BITDEPTH_IEEE_FLOAT32) ? 4ui64 : static_cast<quint64>((qBound(8U, bitdepth, 64U) + 7U) / 8U);
+	return static_cast<quint64>(info.duration()) * info.audioSamplerate() * info.audioChannels() * bytesPerSample;
+}
+
+bool WaveProperties::exceedsRiffLimit(const quint64 &dataSize)
+{
+	return (dataSize >= RIFF_SIZE_LIMIT);
+}
+
+bool WaveProperties::detectSoX(const QString &sourceFile, AudioFileModel_TechInfo *info, QAtomicInt &abortFlag)
 {
 	QProcess process;
 	QStringList args;
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "Tool_Abstract.h"
+#include <QByteArray>
 
 class AudioFileModel_TechInfo;
 
@@ -33,8 +34,24 @@ public:
 	WaveProperties(void);
 	~WaveProperties(void);
 
+	//Location of the sample data within the file
+	typedef struct
+	{
+		QByteArray format; /*payload of the "fmt " chunk*/
+		quint64 dataOffset;
+		quint64 dataSize;
+		quint32 blockAlign;
+		quint32 sampleRate;
+	}
+	layout_t;
+
 	bool detect(const QString &sourceFile, AudioFileModel_TechInfo *info, QAtomicInt &abortFlag);
+	static bool parseHeader(const QString &sourceFile, AudioFileModel_TechInfo *info, QString *const details = NULL, layout_t *const layout = NULL);
+	static quint64 expectedSize(const AudioFileModel_TechInfo &info);
+	static bool exceedsRiffLimit(const quint64 &dataSize);
 
 private:
+	bool detectSoX(const QString &sourceFile, AudioFileModel_TechInfo *info, QAtomicInt &abortFlag);
+
 	const QString m_binary;
 };
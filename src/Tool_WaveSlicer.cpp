@@ -0,0 +1,314 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Tool_WaveSlicer.h"
+
+//Internal
+#include "Global.h"
+#include "Model_AudioFile.h"
+#include "Tool_WaveProperties.h"
+
+//MUtils
+#include <MUtils/Global.h>
+
+//Qt
+#include <QAtomicInt>
+
+//CRT
+#include <string.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Constants
+///////////////////////////////////////////////////////////////////////////////
+
+const qint64 WaveSlicer::FRAMES_PER_SECOND = 75i64;
+
+static const quint64 COPY_WINDOW_SIZE = 4194304ui64; //size of the input window that is mapped at a time
+
+///////////////////////////////////////////////////////////////////////////////
+// Helper Functions
+///////////////////////////////////////////////////////////////////////////////
+
+static inline void APPEND_LE16(QByteArray &buffer, const quint32 value)
+{
+	buffer.append(static_cast<char>(value & 0xFF));
+	buffer.append(static_cast<char>((value >> 8) & 0xFF));
+}
+
+static inline void APPEND_LE32(QByteArray &buffer, const quint32 value)
+{
+	APPEND_LE16(buffer, value & 0xFFFF);
+	APPEND_LE16(buffer, (value >> 16) & 0xFFFF);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor & Destructor
+///////////////////////////////////////////////////////////////////////////////
+
+WaveSlicer::WaveSlicer(const QString &sourceFile)
+:
+	m_sourceFile(sourceFile),
+	m_dataOffset(0),
+	m_dataSize(0),
+	m_position(0)
+{
+}
+
+WaveSlicer::~WaveSlicer(void)
+{
+	close();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public Functions
+///////////////////////////////////////////////////////////////////////////////
+
+bool WaveSlicer::setRange(const qint64 offset, const qint64 length, AudioFileModel_TechInfo *const info)
+{
+	m_header.clear();
+	m_dataOffset = m_dataSize = 0;
+
+	//Read the format and data location of the source directly from its header
+	AudioFileModel_TechInfo sourceInfo;
+	WaveProperties::layout_t layout;
+	if(!WaveProperties::parseHeader(m_sourceFile, &sourceInfo, NULL, &layout))
+	{
+		qWarning("Failed to parse the Wave header of the source file!");
+		return false;
+	}
+
+	//Compute the exact sample range
+	const quint64 totalSamples = layout.dataSize / layout.blockAlign;
+	const quint64 firstSample = (static_cast<quint64>(qMax(0i64, offset)) * layout.sampleRate) / FRAMES_PER_SECOND;
+	quint64 lastSample = (length >= 0) ? ((static_cast<quint64>(qMax(0i64, offset) + length) * layout.sampleRate) / FRAMES_PER_SECOND) : totalSamples;
+
+	if(firstSample >= totalSamples)
+	{
+		qWarning("Track is out of bounds: Track offset exceeds input file duration!");
+		return false;
+	}
+	if(lastSample > totalSamples)
+	{
+		qWarning("Track is out of bounds: End of track exceeds input file duration!");
+		lastSample = totalSamples;
+	}
+	if(lastSample <= firstSample)
+	{
+		qWarning("Track is empty!");
+		return false;
+	}
+
+	const quint64 dataSize = (lastSample - firstSample) * layout.blockAlign;
+	if(WaveProperties::exceedsRiffLimit(dataSize))
+	{
+		qWarning("Track exceeds the maximum size of a RIFF file!");
+		return false;
+	}
+
+	m_header = makeHeader(layout.format, dataSize);
+	m_dataOffset = layout.dataOffset + (firstSample * layout.blockAlign);
+	m_dataSize = dataSize;
+
+	if(info)
+	{
+		(*info) = sourceInfo;
+		info->setContainerType(QString::fromLatin1("Wave"));
+		info->setAudioType(QString::fromLatin1("PCM"));
+		info->setDuration(static_cast<unsigned int>(((lastSample - firstSample) + (layout.sampleRate / 2U)) / layout.sampleRate));
+	}
+
+	return true;
+}
+
+bool WaveSlicer::open(void)
+{
+	close();
+
+	if(m_header.isEmpty())
+	{
+		return false;
+	}
+
+	m_file.setFileName(m_sourceFile);
+	if(!m_file.open(QIODevice::ReadOnly))
+	{
+		qWarning("Failed to open source file for reading!");
+		return false;
+	}
+
+	m_position = 0;
+	return true;
+}
+
+qint64 WaveSlicer::read(char *const buffer, const qint64 maxSize)
+{
+	if(!m_file.isOpen())
+	{
+		return -1;
+	}
+
+	const quint64 headerSize = static_cast<quint64>(m_header.size());
+	const quint64 total = totalSize();
+	qint64 count = 0;
+
+	while((count < maxSize) && (m_position < total))
+	{
+		if(m_position < headerSize)
+		{
+			//Header
+			const qint64 chunk = qMin(maxSize - count, static_cast<qint64>(headerSize - m_position));
+			memcpy(buffer + count, m_header.constData() + m_position, static_cast<size_t>(chunk));
+			count += chunk;
+			m_position += chunk;
+		}
+		else if(m_position < headerSize + m_dataSize)
+		{
+			//Sample data
+			const quint64 dataPos = m_position - headerSize;
+			const qint64 chunk = qMin(maxSize - count, static_cast<qint64>(m_dataSize - dataPos));
+			if((!m_file.seek(m_dataOffset + dataPos)) || (m_file.read(buffer + count, chunk) != chunk))
+			{
+				qWarning("Failed to read source file!");
+				return -1;
+			}
+			count += chunk;
+			m_position += chunk;
+		}
+		else
+		{
+			//Pad byte
+			buffer[count++] = '\0';
+			m_position++;
+		}
+	}
+
+	return count;
+}
+
+void WaveSlicer::close(void)
+{
+	if(m_file.isOpen())
+	{
+		m_file.close();
+	}
+}
+
+bool WaveSlicer::extract(const QString &outputFile, QAtomicInt &abortFlag, const std::function<void(int)> &progress)
+{
+	if(!open())
+	{
+		return false;
+	}
+
+	QFile output(outputFile);
+	if(!output.open(QIODevice::WriteOnly | QIODevice::Unbuffered))
+	{
+		qWarning("Failed to open output file for writing!");
+		close();
+		return false;
+	}
+
+	bool success = (output.write(m_header) == m_header.size());
+	QByteArray buffer;
+	int prevProgress = -1;
+
+	for(quint64 done = 0; success && (done < m_dataSize);)
+	{
+		if(MUTILS_BOOLIFY(abortFlag))
+		{
+			qWarning("Process was aborted on user request!");
+			success = false;
+			break;
+		}
+
+		const qint64 chunkSize = static_cast<qint64>(qMin(m_dataSize - done, COPY_WINDOW_SIZE));
+
+		//Write straight from the mapped source file, fall back to an ordinary read if mapping is not possible
+		if(uchar *const view = m_file.map(m_dataOffset + done, chunkSize))
+		{
+			success = (output.write(reinterpret_cast<const char*>(view), chunkSize) == chunkSize);
+			m_file.unmap(view);
+		}
+		else
+		{
+			if(buffer.isEmpty())
+			{
+				buffer.resize(static_cast<int>(COPY_WINDOW_SIZE));
+			}
+			success = m_file.seek(m_dataOffset + done) && (m_file.read(buffer.data(), chunkSize) == chunkSize) && (output.write(buffer.constData(), chunkSize) == chunkSize);
+		}
+
+		done += chunkSize;
+
+		const int newProgress = static_cast<int>((done * 100ui64) / m_dataSize);
+		if(success && (newProgress > prevProgress))
+		{
+			progress(prevProgress = newProgress);
+		}
+	}
+
+	if(success && (m_dataSize & 1ui64))
+	{
+		success = output.putChar('\0');
+	}
+
+	output.close();
+	close();
+
+	if(!success)
+	{
+		qWarning("Failed to extract the range from the source file!");
+		output.remove();
+	}
+
+	return success;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Private Functions
+///////////////////////////////////////////////////////////////////////////////
+
+QByteArray WaveSlicer::makeHeader(const QByteArray &format, const quint64 dataSize)
+{
+	const quint32 formatSize = static_cast<quint32>(format.size());
+	const quint32 riffSize = 4U + (8U + formatSize + (formatSize & 1U)) + (8U + static_cast<quint32>(dataSize) + static_cast<quint32>(dataSize & 1ui64));
+
+	QByteArray header;
+	header.reserve(static_cast<int>(28U + formatSize));
+
+	header.append("RIFF", 4);
+	APPEND_LE32(header, riffSize);
+	header.append("WAVE", 4);
+
+	header.append("fmt ", 4);
+	APPEND_LE32(header, formatSize);
+	header.append(format);
+	if(formatSize & 1U)
+	{
+		header.append('\0');
+	}
+
+	header.append("data", 4);
+	APPEND_LE32(header, static_cast<quint32>(dataSize));
+
+	return header;
+}
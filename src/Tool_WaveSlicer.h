@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////
+// LameXP - Audio Encoder Front-End
+// Copyright (C) 2004-2023 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU GENERAL PUBLIC LICENSE as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version; always including the non-optional
+// LAMEXP GNU GENERAL PUBLIC LICENSE ADDENDUM. See "License.txt" file!
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// http://www.gnu.org/licenses/gpl-2.0.txt
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+
+//CRT
+#include <functional>
+
+class AudioFileModel_TechInfo;
+class QAtomicInt;
+
+///////////////////////////////////////////////////////////////////////////////
+// Wave Slicer
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Provides a range of sample frames from an uncompressed Wave file as a complete RIFF/WAVE file, either by
+ * sequential reading (e.g. to feed a pipe) or by writing it to a new file. The range is given in CD frames
+ * (75 per second), as used by the INDEX entries of a Cue Sheet, and is converted to exact sample positions.
+ */
+class WaveSlicer
+{
+public:
+	WaveSlicer(const QString &sourceFile);
+	~WaveSlicer(void);
+
+	//Constants
+	static const qint64 FRAMES_PER_SECOND;
+
+	//Select the range, a negative length selects everything up to the end of the file
+	bool setRange(const qint64 offset, const qint64 length, AudioFileModel_TechInfo *const info = NULL);
+
+	//Getter
+	inline const QByteArray &header(void) const { return m_header; }
+	inline quint64 dataSize(void) const { return m_dataSize; }
+	inline quint64 totalSize(void) const { return static_cast<quint64>(m_header.size()) + m_dataSize + (m_dataSize & 1ui64); }
+
+	//Sequential access
+	bool open(void);
+	qint64 read(char *const buffer, const qint64 maxSize);
+	void close(void);
+
+	//Write the whole range to a new Wave file
+	bool extract(const QString &outputFile, QAtomicInt &abortFlag, const std::function<void(int)> &progress);
+
+private:
+	Q_DISABLE_COPY(WaveSlicer)
+
+	static QByteArray makeHeader(const QByteArray &format, const quint64 dataSize);
+
+	const QString m_sourceFile;
+	QFile m_file;
+
+	QByteArray m_header;
+	quint64 m_dataOffset;
+	quint64 m_dataSize;
+	quint64 m_position;
+};